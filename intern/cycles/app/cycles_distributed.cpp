@@ -0,0 +1,842 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#ifdef _WIN32
+/* Must be included before windows.h. */
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#endif
+
+#include "app/cycles_distributed.h"
+
+#include "scene/camera.h"
+#include "scene/integrator.h"
+#include "scene/scene.h"
+#include "session/buffers.h"
+#include "session/output_driver.h"
+#include "session/session.h"
+
+#include "util/deque.h"
+#include "util/path.h"
+#include "util/thread.h"
+#include "util/unique_ptr.h"
+#include "util/unique_ptr_vector.h"
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#ifndef _WIN32
+#  include <arpa/inet.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <spawn.h>
+#  include <sys/select.h>
+#  include <sys/socket.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+
+extern char **environ;
+#endif
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Sockets */
+
+#ifdef _WIN32
+using socket_handle = SOCKET;
+const socket_handle socket_handle_invalid = INVALID_SOCKET;
+#else
+using socket_handle = int;
+const socket_handle socket_handle_invalid = -1;
+#endif
+
+#ifdef MSG_NOSIGNAL
+const int socket_send_flags = MSG_NOSIGNAL;
+#else
+const int socket_send_flags = 0;
+#endif
+
+bool socket_init()
+{
+#ifdef _WIN32
+  static const bool initialized = [] {
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+  }();
+  return initialized;
+#else
+  return true;
+#endif
+}
+
+/* Description of the error of the last failed socket call. */
+string socket_error_string()
+{
+#ifdef _WIN32
+  return string_printf("socket error %d", WSAGetLastError());
+#else
+  return strerror(errno);
+#endif
+}
+
+class DistributedSocket {
+ public:
+  explicit DistributedSocket(const socket_handle handle = socket_handle_invalid) : handle_(handle)
+  {
+  }
+
+  DistributedSocket(DistributedSocket &&other) noexcept : handle_(other.handle_)
+  {
+    other.handle_ = socket_handle_invalid;
+  }
+
+  DistributedSocket &operator=(DistributedSocket &&other) noexcept
+  {
+    if (this != &other) {
+      close();
+      handle_ = other.handle_;
+      other.handle_ = socket_handle_invalid;
+    }
+    return *this;
+  }
+
+  DistributedSocket(const DistributedSocket &) = delete;
+  DistributedSocket &operator=(const DistributedSocket &) = delete;
+
+  ~DistributedSocket()
+  {
+    close();
+  }
+
+  bool valid() const
+  {
+    return handle_ != socket_handle_invalid;
+  }
+
+  socket_handle handle() const
+  {
+    return handle_;
+  }
+
+  void close()
+  {
+    if (handle_ != socket_handle_invalid) {
+#ifdef _WIN32
+      closesocket(handle_);
+#else
+      ::close(handle_);
+#endif
+      handle_ = socket_handle_invalid;
+    }
+  }
+
+  bool send(const void *data, size_t size)
+  {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+      const int chunk = int(min(size, size_t(1 << 30)));
+      const auto num_sent = ::send(handle_, bytes, chunk, socket_send_flags);
+      if (num_sent <= 0) {
+        return false;
+      }
+      bytes += num_sent;
+      size -= num_sent;
+    }
+    return true;
+  }
+
+  bool receive(void *data, size_t size)
+  {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+      const int chunk = int(min(size, size_t(1 << 30)));
+      const auto num_received = ::recv(handle_, bytes, chunk, 0);
+      if (num_received <= 0) {
+        return false;
+      }
+      bytes += num_received;
+      size -= num_received;
+    }
+    return true;
+  }
+
+  /* Wait until the socket has data or a connection to accept, a negative timeout waits
+   * indefinitely. Returns a positive value when readable, zero on timeout and a negative value
+   * on error. */
+  int wait_readable(const int timeout_seconds)
+  {
+    fd_set read_set;
+    FD_ZERO(&read_set);
+    FD_SET(handle_, &read_set);
+
+    timeval timeout;
+    timeout.tv_sec = timeout_seconds;
+    timeout.tv_usec = 0;
+
+    return select(int(handle_ + 1),
+                  &read_set,
+                  nullptr,
+                  nullptr,
+                  (timeout_seconds < 0) ? nullptr : &timeout);
+  }
+
+  static DistributedSocket listen(const int port, const int backlog, int &r_port)
+  {
+    DistributedSocket socket(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (!socket.valid()) {
+      return socket;
+    }
+
+    const int reuse = 1;
+    setsockopt(
+        socket.handle_, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
+    /* Only accept connections from this machine. */
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(uint16_t(port));
+
+    socklen_t address_size = sizeof(address);
+    if (bind(socket.handle_, (const sockaddr *)&address, address_size) != 0 ||
+        ::listen(socket.handle_, backlog) != 0 ||
+        getsockname(socket.handle_, (sockaddr *)&address, &address_size) != 0)
+    {
+      socket.close();
+      return socket;
+    }
+
+    r_port = ntohs(address.sin_port);
+    return socket;
+  }
+
+  DistributedSocket accept(const int timeout_seconds, string &r_error)
+  {
+    const int ready = wait_readable(timeout_seconds);
+    if (ready == 0) {
+      r_error = "timed out";
+      return DistributedSocket();
+    }
+    if (ready < 0) {
+      r_error = socket_error_string();
+      return DistributedSocket();
+    }
+    DistributedSocket socket(::accept(handle_, nullptr, nullptr));
+    if (!socket.valid()) {
+      r_error = socket_error_string();
+      return socket;
+    }
+    socket.set_options();
+    return socket;
+  }
+
+  static DistributedSocket connect(const string &host, const int port)
+  {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+      return DistributedSocket();
+    }
+
+    DistributedSocket socket;
+    for (addrinfo *address = addresses; address; address = address->ai_next) {
+      socket = DistributedSocket(
+          ::socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+      if (socket.valid() &&
+          ::connect(socket.handle_, address->ai_addr, socklen_t(address->ai_addrlen)) == 0)
+      {
+        break;
+      }
+      socket.close();
+    }
+    freeaddrinfo(addresses);
+
+    socket.set_options();
+    return socket;
+  }
+
+ protected:
+  void set_options()
+  {
+    if (!valid()) {
+      return;
+    }
+    /* Messages are written in one piece, don't delay the small ones. */
+    const int no_delay = 1;
+    setsockopt(handle_, IPPROTO_TCP, TCP_NODELAY, (const char *)&no_delay, sizeof(no_delay));
+#ifdef SO_NOSIGPIPE
+    const int no_sigpipe = 1;
+    setsockopt(handle_, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+  }
+
+  socket_handle handle_;
+};
+
+/* Messages
+ *
+ * A message is its type and payload size, followed by the payload. Values are stored in native
+ * byte order, all processes are expected to run on the same kind of machine. */
+
+const int distributed_protocol_version = 1;
+
+/* Upper limit for the payload of a single message, so that a corrupt or hostile size can't make
+ * the receiver allocate arbitrary amounts of memory. Large enough for the result of a 16K image. */
+const uint64_t distributed_message_max_size = uint64_t(8) << 30;
+
+enum DistributedMessageType : uint32_t {
+  /* Worker to main process: protocol version. */
+  DISTRIBUTED_MESSAGE_HELLO = 0,
+  /* Main process to worker: DistributedScene. */
+  DISTRIBUTED_MESSAGE_SCENE,
+  /* Main process to worker: sample offset and number of samples to render. */
+  DISTRIBUTED_MESSAGE_RENDER,
+  /* Worker to main process: resolution and combined pass pixels of the rendered range. */
+  DISTRIBUTED_MESSAGE_RESULT,
+  /* Worker to main process: error message. */
+  DISTRIBUTED_MESSAGE_ERROR,
+  /* Main process to worker: no more ranges to render. */
+  DISTRIBUTED_MESSAGE_EXIT,
+};
+
+class DistributedMessage {
+ public:
+  explicit DistributedMessage(const DistributedMessageType type = DISTRIBUTED_MESSAGE_HELLO)
+      : type(type)
+  {
+  }
+
+  void write(const void *value, const size_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *>(value);
+    data.insert(data.end(), bytes, bytes + size);
+  }
+
+  void write_int(const int value)
+  {
+    write(&value, sizeof(value));
+  }
+
+  void write_string(const string &value)
+  {
+    write_int(int(value.size()));
+    write(value.data(), value.size());
+  }
+
+  bool read(void *value, const size_t size)
+  {
+    if (read_offset + size > data.size()) {
+      return false;
+    }
+    memcpy(value, data.data() + read_offset, size);
+    read_offset += size;
+    return true;
+  }
+
+  bool read_int(int &value)
+  {
+    return read(&value, sizeof(value));
+  }
+
+  bool read_string(string &value)
+  {
+    int size;
+    if (!read_int(size) || size < 0 || read_offset + size > data.size()) {
+      return false;
+    }
+    value.assign((const char *)data.data() + read_offset, size);
+    read_offset += size;
+    return true;
+  }
+
+  bool send(DistributedSocket &socket) const
+  {
+    const uint32_t message_type = type;
+    const uint64_t size = data.size();
+    return socket.send(&message_type, sizeof(message_type)) && socket.send(&size, sizeof(size)) &&
+           socket.send(data.data(), data.size());
+  }
+
+  bool receive(DistributedSocket &socket)
+  {
+    uint32_t message_type;
+    uint64_t size;
+    if (!socket.receive(&message_type, sizeof(message_type)) ||
+        !socket.receive(&size, sizeof(size)))
+    {
+      return false;
+    }
+    if (size > distributed_message_max_size) {
+      return false;
+    }
+    type = DistributedMessageType(message_type);
+    data.resize(size);
+    read_offset = 0;
+    return socket.receive(data.data(), size);
+  }
+
+  DistributedMessageType type;
+  vector<uint8_t> data;
+  size_t read_offset = 0;
+};
+
+bool parse_address(const string &address, string &r_host, int &r_port)
+{
+  const size_t separator = address.rfind(':');
+  if (separator == string::npos) {
+    return false;
+  }
+  r_host = address.substr(0, separator);
+  r_port = atoi(address.c_str() + separator + 1);
+  return !r_host.empty() && r_port > 0;
+}
+
+/* Processes */
+
+#ifdef _WIN32
+using process_handle = HANDLE;
+#else
+using process_handle = pid_t;
+#endif
+
+bool process_spawn(const vector<string> &args, process_handle &r_process)
+{
+#ifdef _WIN32
+  string command_line;
+  for (const string &arg : args) {
+    if (!command_line.empty()) {
+      command_line += " ";
+    }
+    command_line += "\"" + arg + "\"";
+  }
+
+  STARTUPINFOA startup_info = {};
+  startup_info.cb = sizeof(startup_info);
+  PROCESS_INFORMATION process_info = {};
+  if (!CreateProcessA(nullptr,
+                      command_line.data(),
+                      nullptr,
+                      nullptr,
+                      FALSE,
+                      0,
+                      nullptr,
+                      nullptr,
+                      &startup_info,
+                      &process_info))
+  {
+    return false;
+  }
+  CloseHandle(process_info.hThread);
+  r_process = process_info.hProcess;
+  return true;
+#else
+  vector<char *> argv;
+  for (const string &arg : args) {
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  /* Search the path, the executable may have been started without a directory. */
+  return posix_spawnp(&r_process, argv[0], nullptr, nullptr, argv.data(), environ) == 0;
+#endif
+}
+
+void process_wait(const process_handle process)
+{
+#ifdef _WIN32
+  WaitForSingleObject(process, INFINITE);
+  CloseHandle(process);
+#else
+  int status;
+  waitpid(process, &status, 0);
+#endif
+}
+
+/* Main Process */
+
+struct DistributedRange {
+  int offset;
+  int length;
+};
+
+class DistributedMain {
+ public:
+  DistributedMain(const DistributedRenderParams &params,
+                  DistributedRenderResult &result,
+                  const DistributedLogFunction &log)
+      : params_(params), result_(result), log_(log)
+  {
+    /* Smaller ranges balance better between workers of different speed, but every range has a
+     * fixed cost for resetting the render buffers and sending the result. */
+    const int num_ranges = max(params.num_workers * 4, 1);
+    const int range_length = max(int(divide_up(params.samples, num_ranges)), 1);
+    for (int offset = 0; offset < params.samples; offset += range_length) {
+      ranges_.push_back({offset, min(range_length, params.samples - offset)});
+    }
+
+    scene_.filepath = params.filepath;
+    scene_.width = params.width;
+    scene_.height = params.height;
+    scene_.samples = params.samples;
+    /* XML scenes are sent along, other files are read by the workers directly. */
+    if (string_endswith(string_to_lower(params.filepath), ".xml")) {
+      path_read_text(params.filepath, scene_.contents);
+    }
+  }
+
+  /* Render with a worker until there are no more ranges left, runs in its own thread. */
+  void run_worker(DistributedSocket socket, const int worker_index)
+  {
+    DistributedMessage message;
+    int version;
+    if (!message.receive(socket) || message.type != DISTRIBUTED_MESSAGE_HELLO ||
+        !message.read_int(version) || version != distributed_protocol_version)
+    {
+      log_(string_printf("Worker %d: incompatible or failed to connect", worker_index));
+      return;
+    }
+
+    message = DistributedMessage(DISTRIBUTED_MESSAGE_SCENE);
+    message.write_string(scene_.filepath);
+    message.write_string(scene_.contents);
+    message.write_int(scene_.width);
+    message.write_int(scene_.height);
+    message.write_int(scene_.samples);
+    if (!message.send(socket)) {
+      log_(string_printf("Worker %d: failed to send scene", worker_index));
+      return;
+    }
+
+    while (true) {
+      DistributedRange range;
+      {
+        /* While other workers are rendering, wait instead of exiting: their range is queued again
+         * when they fail, and must not be left without a worker. */
+        thread_scoped_lock lock(mutex_);
+        condition_.wait(lock, [this] { return !ranges_.empty() || num_ranges_rendering_ == 0; });
+        if (ranges_.empty()) {
+          break;
+        }
+        range = ranges_.front();
+        ranges_.pop_front();
+        num_ranges_rendering_++;
+      }
+
+      string error;
+      const bool success = render_range(socket, range, error);
+      {
+        const thread_scoped_lock lock(mutex_);
+        num_ranges_rendering_--;
+        if (!success) {
+          /* Leave the range to the other workers. */
+          ranges_.push_front(range);
+        }
+      }
+      condition_.notify_all();
+
+      if (!success) {
+        log_(string_printf("Worker %d: %s", worker_index, error.c_str()));
+        return;
+      }
+    }
+
+    DistributedMessage(DISTRIBUTED_MESSAGE_EXIT).send(socket);
+  }
+
+  bool finish()
+  {
+    if (!ranges_.empty() || num_samples_rendered_ != params_.samples) {
+      return false;
+    }
+
+    const float scale = 1.0f / float(params_.samples);
+    for (float &value : result_.pixels) {
+      value *= scale;
+    }
+    return true;
+  }
+
+ protected:
+  bool render_range(DistributedSocket &socket, const DistributedRange &range, string &r_error)
+  {
+    DistributedMessage message(DISTRIBUTED_MESSAGE_RENDER);
+    message.write_int(range.offset);
+    message.write_int(range.length);
+
+    if (!message.send(socket) || !message.receive(socket)) {
+      r_error = "lost connection";
+      return false;
+    }
+    if (message.type == DISTRIBUTED_MESSAGE_ERROR) {
+      message.read_string(r_error);
+      return false;
+    }
+
+    int width;
+    int height;
+    if (message.type != DISTRIBUTED_MESSAGE_RESULT || !message.read_int(width) ||
+        !message.read_int(height) || width <= 0 || height <= 0 ||
+        message.data.size() - message.read_offset != sizeof(float) * 4 * size_t(width) * height)
+    {
+      r_error = "invalid result";
+      return false;
+    }
+    const float *pixels = (const float *)(message.data.data() + message.read_offset);
+
+    const thread_scoped_lock lock(mutex_);
+    if (result_.pixels.empty()) {
+      result_.width = width;
+      result_.height = height;
+      result_.pixels.resize(size_t(width) * height * 4, 0.0f);
+    }
+    else if (result_.width != width || result_.height != height) {
+      r_error = "resolution does not match other workers";
+      return false;
+    }
+
+    /* The combined pass is the average of the range, accumulate the sum over all samples. */
+    const float weight = float(range.length);
+    for (size_t i = 0; i < result_.pixels.size(); i++) {
+      result_.pixels[i] += pixels[i] * weight;
+    }
+
+    num_samples_rendered_ += range.length;
+    log_(string_printf("Rendered %d/%d samples", num_samples_rendered_, params_.samples));
+    return true;
+  }
+
+  const DistributedRenderParams &params_;
+  DistributedRenderResult &result_;
+  const DistributedLogFunction &log_;
+  DistributedScene scene_;
+
+  thread_mutex mutex_;
+  thread_condition_variable condition_;
+  deque<DistributedRange> ranges_;
+  /* Ranges taken from #ranges_ by a worker that did not finish them yet. */
+  int num_ranges_rendering_ = 0;
+  int num_samples_rendered_ = 0;
+};
+
+/* Worker Process */
+
+/* Collects the combined pass of a render, which may arrive in multiple tiles. */
+class DistributedOutputDriver : public OutputDriver {
+ public:
+  void write_render_tile(const Tile &tile) override
+  {
+    const int2 full_size = tile.full_size;
+    if (width != full_size.x || height != full_size.y) {
+      width = full_size.x;
+      height = full_size.y;
+      pixels.resize(size_t(width) * height * 4);
+    }
+
+    vector<float> tile_pixels(size_t(tile.size.x) * tile.size.y * 4);
+    if (!tile.get_pass_pixels("combined", 4, tile_pixels.data())) {
+      return;
+    }
+
+    for (int y = 0; y < tile.size.y; y++) {
+      memcpy(pixels.data() + ((size_t(tile.offset.y) + y) * width + tile.offset.x) * 4,
+             tile_pixels.data() + size_t(y) * tile.size.x * 4,
+             sizeof(float) * 4 * tile.size.x);
+    }
+    num_pixels_written += size_t(tile.size.x) * tile.size.y;
+  }
+
+  int width = 0;
+  int height = 0;
+  vector<float> pixels;
+  size_t num_pixels_written = 0;
+};
+
+bool worker_send_error(DistributedSocket &socket, const string &error)
+{
+  DistributedMessage message(DISTRIBUTED_MESSAGE_ERROR);
+  message.write_string(error);
+  message.send(socket);
+  return false;
+}
+
+}  // namespace
+
+bool distributed_render(const DistributedRenderParams &params,
+                        DistributedRenderResult &result,
+                        const DistributedLogFunction &log)
+{
+  if (!socket_init()) {
+    log("Failed to initialize sockets");
+    return false;
+  }
+
+  const bool spawn_workers = (params.port == 0);
+  int port;
+  DistributedSocket listener = DistributedSocket::listen(params.port, params.num_workers, port);
+  if (!listener.valid()) {
+    log(string_printf("Failed to listen on port %d", params.port));
+    return false;
+  }
+
+  vector<process_handle> processes;
+  if (spawn_workers) {
+    vector<string> args = {params.executable, "--worker", string_printf("127.0.0.1:%d", port)};
+    args.insert(args.end(), params.worker_args.begin(), params.worker_args.end());
+
+    for (int i = 0; i < params.num_workers; i++) {
+      process_handle process;
+      if (!process_spawn(args, process)) {
+        log(string_printf("Failed to start worker %s", params.executable.c_str()));
+        break;
+      }
+      processes.push_back(process);
+    }
+  }
+  else {
+    log(string_printf("Waiting for %d workers on port %d", params.num_workers, port));
+  }
+
+  DistributedMain distributed(params, result, log);
+  unique_ptr_vector<thread> threads;
+
+  /* Spawned workers should connect right away, separately started workers may take longer. */
+  const int num_workers = spawn_workers ? int(processes.size()) : params.num_workers;
+  const int timeout_seconds = spawn_workers ? 60 : -1;
+  for (int i = 0; i < num_workers; i++) {
+    string error;
+    DistributedSocket socket = listener.accept(timeout_seconds, error);
+    if (!socket.valid()) {
+      log(string_printf("Failed to accept worker connection: %s", error.c_str()));
+      break;
+    }
+
+    /* Share the socket with the thread through a pointer, std::function needs to be copyable. */
+    auto socket_ptr = std::make_shared<DistributedSocket>(std::move(socket));
+    threads.push_back(make_unique<thread>(
+        [&distributed, socket_ptr, i]() { distributed.run_worker(std::move(*socket_ptr), i); }));
+  }
+  listener.close();
+
+  for (thread *worker_thread : threads) {
+    worker_thread->join();
+  }
+  for (const process_handle process : processes) {
+    process_wait(process);
+  }
+
+  if (!distributed.finish()) {
+    log("Not all samples were rendered");
+    return false;
+  }
+  return true;
+}
+
+bool distributed_render_worker(const string &address,
+                               const DistributedCreateSessionFunction &create_session,
+                               const DistributedLogFunction &log)
+{
+  string host;
+  int port;
+  if (!parse_address(address, host, port)) {
+    log(string_printf("Invalid address %s, expected host:port", address.c_str()));
+    return false;
+  }
+
+  if (!socket_init()) {
+    log("Failed to initialize sockets");
+    return false;
+  }
+
+  DistributedSocket socket = DistributedSocket::connect(host, port);
+  if (!socket.valid()) {
+    log(string_printf("Failed to connect to %s", address.c_str()));
+    return false;
+  }
+
+  DistributedMessage message(DISTRIBUTED_MESSAGE_HELLO);
+  message.write_int(distributed_protocol_version);
+  if (!message.send(socket)) {
+    return false;
+  }
+
+  DistributedScene scene;
+  if (!message.receive(socket) || message.type != DISTRIBUTED_MESSAGE_SCENE ||
+      !message.read_string(scene.filepath) || !message.read_string(scene.contents) ||
+      !message.read_int(scene.width) || !message.read_int(scene.height) ||
+      !message.read_int(scene.samples))
+  {
+    log("Failed to receive scene");
+    return false;
+  }
+
+  Session *session = create_session(scene);
+
+  /* Ranges are averaged with equal weight per sample, which requires all pixels to have the same
+   * number of samples. Denoising a single range would denoise a noisier image than the final one,
+   * and the merged image is written without denoising, so neither is supported. */
+  Integrator *integrator = session->scene->integrator;
+  if (integrator->get_use_adaptive_sampling()) {
+    log("Adaptive sampling is not supported with distributed rendering, disabling it");
+    integrator->set_use_adaptive_sampling(false);
+  }
+  if (integrator->get_use_denoise()) {
+    log("Denoising is not supported with distributed rendering, disabling it");
+    integrator->set_use_denoise(false);
+  }
+
+  auto output_driver = make_unique<DistributedOutputDriver>();
+  DistributedOutputDriver *output = output_driver.get();
+  session->set_output_driver(std::move(output_driver));
+
+  BufferParams buffer_params;
+  buffer_params.width = session->scene->camera->get_full_width();
+  buffer_params.height = session->scene->camera->get_full_height();
+  buffer_params.full_width = buffer_params.width;
+  buffer_params.full_height = buffer_params.height;
+
+  while (message.receive(socket) && message.type == DISTRIBUTED_MESSAGE_RENDER) {
+    DistributedRange range;
+    if (!message.read_int(range.offset) || !message.read_int(range.length)) {
+      return worker_send_error(socket, "Invalid render message");
+    }
+
+    SessionParams session_params = session->params;
+    session_params.samples = scene.samples;
+    session_params.use_sample_subset = true;
+    session_params.sample_subset_offset = range.offset;
+    session_params.sample_subset_length = range.length;
+
+    output->num_pixels_written = 0;
+    session->reset(session_params, buffer_params);
+    session->start();
+    session->wait();
+
+    if (session->progress.get_error()) {
+      return worker_send_error(socket, session->progress.get_error_message());
+    }
+    if (output->num_pixels_written != size_t(output->width) * output->height) {
+      return worker_send_error(socket, "Incomplete render result");
+    }
+
+    message = DistributedMessage(DISTRIBUTED_MESSAGE_RESULT);
+    message.write_int(output->width);
+    message.write_int(output->height);
+    message.write(output->pixels.data(), sizeof(float) * output->pixels.size());
+    if (!message.send(socket)) {
+      log("Lost connection to main process");
+      return false;
+    }
+  }
+
+  return message.type == DISTRIBUTED_MESSAGE_EXIT;
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include <functional>
+
+#include "util/string.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+class Session;
+
+/* Distributed Rendering
+ *
+ * Renders a single image with multiple Cycles processes, for example one per NUMA node. The main
+ * process listens on a local TCP port, sends the scene to every worker once and then hands out
+ * sample ranges until all samples are rendered. Workers keep their session and scene alive
+ * between ranges and send back the combined pass of every range, which the main process
+ * accumulates weighted by the number of samples.
+ *
+ * Ranges are handed out on demand, so faster workers render more samples. When a worker fails,
+ * its range is rendered by the remaining workers.
+ *
+ * Adaptive sampling and denoising are not supported, workers disable them with a warning and the
+ * merged image is written without denoising.
+ *
+ * Workers are either spawned by the main process, or started separately with --worker so they can
+ * be pinned to NUMA nodes, for example with numactl. */
+
+struct DistributedRenderParams {
+  /* Number of worker processes. */
+  int num_workers = 0;
+  /* Port to wait for separately started workers on. Zero spawns local workers on a free port. */
+  int port = 0;
+  /* Executable and additional arguments for spawned workers. */
+  string executable;
+  vector<string> worker_args;
+
+  /* Scene file, sent to workers along with its contents for XML files. */
+  string filepath;
+  /* Resolution override, zero to use the camera resolution from the scene. */
+  int width = 0;
+  int height = 0;
+  int samples = 0;
+};
+
+struct DistributedRenderResult {
+  int width = 0;
+  int height = 0;
+  /* RGBA combined pass, bottom to top. */
+  vector<float> pixels;
+};
+
+using DistributedLogFunction = std::function<void(const string &)>;
+
+bool distributed_render(const DistributedRenderParams &params,
+                        DistributedRenderResult &result,
+                        const DistributedLogFunction &log);
+
+/* Scene as sent to workers. Contents are empty when the scene can only be read from disk. */
+struct DistributedScene {
+  string filepath;
+  string contents;
+  int width = 0;
+  int height = 0;
+  int samples = 0;
+};
+
+/* Connect to the main process at host:port and render sample ranges until it is done. The
+ * session returned by create_session must have the scene loaded and a combined pass. */
+using DistributedCreateSessionFunction = std::function<Session *(const DistributedScene &scene)>;
+
+bool distributed_render_worker(const string &address,
+                               const DistributedCreateSessionFunction &create_session,
+                               const DistributedLogFunction &log);
+
+CCL_NAMESPACE_END
@@ -3,12 +3,15 @@
  * SPDX-License-Identifier: Apache-2.0 */
 
 #include <cstdio>
+#include <cstring>
 
 #include "device/device.h"
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
+#include "session/output_driver.h"
 #include "session/session.h"
 
 #include "util/args.h"
@@ -27,6 +30,7 @@
 #  include "hydra/file_reader.h"
 #endif
 
+#include "app/cycles_distributed.h"
 #include "app/cycles_xml.h"
 #include "app/oiio_output_driver.h"
 
@@ -41,6 +45,8 @@ struct Options {
   unique_ptr<Session> session;
   Scene *scene;
   string filepath;
+  /* Scene file contents received by a worker process. */
+  string scene_contents;
   int width, height;
   SceneParams scene_params;
   SessionParams session_params;
@@ -48,6 +54,13 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  /* JSON file for render statistics, when profiling. */
+  string profile_output;
+  /* Distributed rendering, see cycles_distributed.h. */
+  int workers;
+  int worker_port;
+  string worker_address;
+  vector<string> worker_args;
 } options;
 
 static void session_print(const string &str)
@@ -109,7 +122,12 @@ static void scene_init()
   else
 #endif
   {
-    xml_read_file(options.scene, options.filepath.c_str());
+    if (!options.scene_contents.empty()) {
+      xml_read_string(options.scene, options.scene_contents, options.filepath.c_str());
+    }
+    else {
+      xml_read_file(options.scene, options.filepath.c_str());
+    }
   }
 
   /* Camera width/height override? */
@@ -126,6 +144,13 @@ static void scene_init()
   options.scene->camera->compute_auto_viewplane();
 }
 
+static void output_pass_init()
+{
+  Pass *pass = options.scene->create_node<Pass>();
+  pass->set_name(ustring(options.output_pass.c_str()));
+  pass->set_type(PASS_COMBINED);
+}
+
 static void session_init()
 {
   options.output_pass = "combined";
@@ -154,11 +179,7 @@ static void session_init()
 
   /* load scene */
   scene_init();
-
-  /* add pass for output. */
-  Pass *pass = options.scene->create_node<Pass>();
-  pass->set_name(ustring(options.output_pass.c_str()));
-  pass->set_type(PASS_COMBINED);
+  output_pass_init();
 
   options.session->reset(options.session_params, session_buffer_params());
   options.session->start();
@@ -166,6 +187,21 @@ static void session_init()
 
 static void session_exit()
 {
+  if (options.session && options.session_params.use_profiling) {
+    RenderStats stats;
+    options.session->collect_statistics(&stats);
+    if (!options.quiet) {
+      printf("\nRender statistics:\n%s\n", stats.full_report().c_str());
+    }
+    if (!options.profile_output.empty()) {
+      string json = stats.json_report();
+      if (!path_write_text(options.profile_output, json)) {
+        fprintf(stderr, "Failed to write render statistics to %s\n",
+                options.profile_output.c_str());
+      }
+    }
+  }
+
   if (options.session) {
     options.session.reset();
   }
@@ -176,6 +212,105 @@ static void session_exit()
   }
 }
 
+/* Distributed Rendering */
+
+class DistributedTile : public OutputDriver::Tile {
+ public:
+  DistributedTile(const DistributedRenderResult &result)
+      : Tile(make_int2(0, 0),
+             make_int2(result.width, result.height),
+             make_int2(result.width, result.height),
+             "",
+             ""),
+        result_(result)
+  {
+  }
+
+  bool get_pass_pixels(const string_view /*pass_name*/,
+                       const int num_channels,
+                       float *pixels) const override
+  {
+    if (num_channels != 4) {
+      return false;
+    }
+    memcpy(pixels, result_.pixels.data(), sizeof(float) * result_.pixels.size());
+    return true;
+  }
+
+  bool set_pass_pixels(const string_view /*pass_name*/,
+                       const int /*num_channels*/,
+                       const float * /*pixels*/) const override
+  {
+    return false;
+  }
+
+ protected:
+  const DistributedRenderResult &result_;
+};
+
+static void distributed_log(const string &str)
+{
+  if (!options.quiet) {
+    session_print(str);
+  }
+}
+
+static bool distributed_main(const char *executable)
+{
+  DistributedRenderParams params;
+  params.num_workers = options.workers;
+  params.port = options.worker_port;
+  params.executable = executable;
+  params.worker_args = options.worker_args;
+  params.filepath = options.filepath;
+  params.width = options.width;
+  params.height = options.height;
+  params.samples = options.session_params.samples;
+
+  DistributedRenderResult result;
+  if (!distributed_render(params, result, distributed_log)) {
+    fprintf(stderr, "\nDistributed render failed\n");
+    return false;
+  }
+
+  if (!options.output_filepath.empty()) {
+    OIIOOutputDriver output_driver(options.output_filepath, "combined", distributed_log);
+    output_driver.write_render_tile(DistributedTile(result));
+  }
+
+  if (!options.quiet) {
+    session_print("Finished Rendering.");
+    printf("\n");
+  }
+  return true;
+}
+
+static Session *worker_session_init(const DistributedScene &scene)
+{
+  options.filepath = scene.filepath;
+  options.scene_contents = scene.contents;
+  options.width = scene.width;
+  options.height = scene.height;
+  options.session_params.samples = scene.samples;
+  options.output_pass = "combined";
+  options.session = make_unique<Session>(options.session_params, options.scene_params);
+
+  scene_init();
+  output_pass_init();
+
+  return options.session.get();
+}
+
+static bool worker_main()
+{
+  const bool success = distributed_render_worker(
+      options.worker_address, worker_session_init, [](const string &str) {
+        fprintf(stderr, "%s\n", str.c_str());
+      });
+  options.session.reset();
+  return success;
+}
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
 static void display_info(Progress &progress)
 {
@@ -382,6 +517,8 @@ static void options_parse(const int argc, const char **argv)
   options.quiet = false;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
+  options.workers = 0;
+  options.worker_port = 0;
 
   /* device names */
   string device_names;
@@ -440,8 +577,21 @@ static void options_parse(const int argc, const char **argv)
   ap.arg("--tile-size %d:TILE_SIZE").help("Tile size in pixels").action([&](auto argv) {
     parse_int(argv, &options.session_params.tile_size);
   });
+  ap.arg("--workers %d:WORKERS")
+      .help("Render in background with multiple worker processes, splitting samples between them")
+      .action([&](auto argv) { parse_int(argv, &options.workers); });
+  ap.arg("--worker-port %d:PORT")
+      .help("Wait for workers started separately with --worker on this local port, instead of "
+            "starting them")
+      .action([&](auto argv) { parse_int(argv, &options.worker_port); });
+  ap.arg("--worker %s:ADDRESS")
+      .help("Run as worker process for the render at HOST:PORT")
+      .action([&](auto argv) { parse_string(argv, &options.worker_address); });
   ap.arg("--list-devices", &list).help("List information about all available devices");
   ap.arg("--profile", &profile).help("Enable profile logging");
+  ap.arg("--profile-output %s:FILE")
+      .help("Write render time per kernel, shader, object and light as JSON, implies --profile")
+      .action([&](auto argv) { parse_string(argv, &options.profile_output); });
 #ifdef WITH_CYCLES_LOGGING
   ap.arg("--debug", &debug).help("Enable debug logging");
   ap.arg("--verbose %d:VERBOSE").help("Set verbosity of the logger").action([&](auto argv) {
@@ -479,12 +629,12 @@ static void options_parse(const int argc, const char **argv)
     printf("%s\n", CYCLES_VERSION_STRING);
     exit(EXIT_SUCCESS);
   }
-  else if (help || options.filepath.empty()) {
+  else if (help || (options.filepath.empty() && options.worker_address.empty())) {
     ap.print_help();
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.profile_output.empty();
 
   if (ssname == "osl") {
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -497,6 +647,10 @@ static void options_parse(const int argc, const char **argv)
   options.session_params.background = true;
 #endif
 
+  if (options.workers > 0 || !options.worker_address.empty()) {
+    options.session_params.background = true;
+  }
+
   if (options.session_params.tile_size > 0) {
     options.session_params.use_auto_tile = true;
   }
@@ -532,10 +686,31 @@ static void options_parse(const int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
-  else if (options.filepath.empty()) {
+  else if (options.workers < 0 || options.worker_port < 0) {
+    fprintf(stderr, "Invalid number of workers or port\n");
+    exit(EXIT_FAILURE);
+  }
+  else if (options.filepath.empty() && options.worker_address.empty()) {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
   }
+
+  /* Workers render with the same device settings. */
+  if (options.workers > 0) {
+    options.worker_args = {"--device", devicename};
+#ifdef WITH_OSL
+    options.worker_args.insert(options.worker_args.end(), {"--shadingsys", ssname});
+#endif
+    if (options.session_params.threads > 0) {
+      options.worker_args.insert(options.worker_args.end(),
+                                 {"--threads", std::to_string(options.session_params.threads)});
+    }
+    if (options.session_params.tile_size > 0) {
+      options.worker_args.insert(
+          options.worker_args.end(),
+          {"--tile-size", std::to_string(options.session_params.tile_size)});
+    }
+  }
 }
 
 CCL_NAMESPACE_END
@@ -548,6 +723,13 @@ int main(const int argc, const char **argv)
   path_init();
   options_parse(argc, argv);
 
+  if (!options.worker_address.empty()) {
+    return worker_main() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if (options.workers > 0) {
+    return distributed_main(argv[0]) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
   if (options.session_params.background) {
 #endif
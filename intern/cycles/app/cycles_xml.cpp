@@ -837,7 +837,7 @@ static void xml_read_include(XMLReadState &state, const string &src)
 
 /* File */
 
-void xml_read_file(Scene *scene, const char *filepath)
+static XMLReadState xml_read_state_init(Scene *scene, const char *filepath)
 {
   XMLReadState state;
 
@@ -848,9 +848,32 @@ void xml_read_file(Scene *scene, const char *filepath)
   state.dicing_rate = 1.0f;
   state.base = path_dirname(filepath);
 
+  return state;
+}
+
+void xml_read_file(Scene *scene, const char *filepath)
+{
+  XMLReadState state = xml_read_state_init(scene, filepath);
+
   xml_read_include(state, path_filename(filepath));
 
   scene->params.bvh_type = BVH_TYPE_STATIC;
 }
 
+void xml_read_string(Scene *scene, const string &contents, const char *filepath)
+{
+  xml_document doc;
+  const xml_parse_result parse_result = doc.load_buffer(contents.data(), contents.size());
+
+  if (!parse_result) {
+    fprintf(stderr, "%s read error: %s\n", filepath, parse_result.description());
+    exit(EXIT_FAILURE);
+  }
+
+  XMLReadState state = xml_read_state_init(scene, filepath);
+  xml_read_scene(state, doc.child("cycles"));
+
+  scene->params.bvh_type = BVH_TYPE_STATIC;
+}
+
 CCL_NAMESPACE_END
@@ -4,11 +4,16 @@
 
 #pragma once
 
+#include "util/string.h"
+
 CCL_NAMESPACE_BEGIN
 
 class Scene;
 
 void xml_read_file(Scene *scene, const char *filepath);
+/* Read a scene from file contents that were already loaded, with includes and images resolved
+ * relative to filepath. */
+void xml_read_string(Scene *scene, const string &contents, const char *filepath);
 
 /* macros for importing */
 #define RAD2DEGF(_rad) ((_rad) * (float)(180.0 / M_PI))
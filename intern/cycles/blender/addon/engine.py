@@ -173,6 +173,15 @@ def system_info():
     return _cycles.system_info()
 
 
+def render_statistics():
+    # Time per kernel, shader, object and light of the last rendered view layer.
+    # Only available for background renders with --cycles-print-stats.
+    import _cycles
+    import json
+    statistics = _cycles.get_render_statistics()
+    return json.loads(statistics) if statistics else None
+
+
 def list_render_passes(scene, srl):
     import _cycles
 
@@ -215,6 +224,8 @@ def list_render_passes(scene, srl):
     # Debug passes.
     if crl.pass_debug_sample_count:
         yield ("Debug Sample Count", "X", 'VALUE')
+    if crl.pass_debug_render_time:
+        yield ("Debug Render Time", "X", 'VALUE')
 
     # Cryptomatte passes.
     # NOTE: Name channels are lowercase RGBA so that compression rules check in OpenEXR DWA code
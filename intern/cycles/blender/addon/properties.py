@@ -1054,6 +1054,26 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=8, max=8192,
     )
 
+    use_texture_cache: BoolProperty(
+        name="Texture Cache",
+        description="Read image textures on demand, loading only the tiles and mipmap levels needed for rendering. "
+                    "Reduces memory usage and startup time for scenes with many large textures, "
+                    "best used with tiled and mipmapped files such as .tx. Only supported on the CPU with SVM shading",
+        default=False,
+    )
+    texture_cache_size: IntProperty(
+        name="Cache Size",
+        description="Maximum memory in megabytes used for image tiles held by the texture cache",
+        default=4096,
+        min=64, soft_max=65536,
+    )
+    use_texture_compression: BoolProperty(
+        name="Texture Compression",
+        description="Store 8-bit image textures block compressed, using 4 to 8 times less memory "
+                    "at the cost of some color precision. Only supported on the CPU",
+        default=False,
+    )
+
     # Various fine-tuning debug flags
 
     def _devices_update_callback(self, context):
@@ -1068,6 +1088,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_ray_packets: BoolProperty(
+        name="Ray Packets",
+        description="Trace camera and shadow rays of neighboring pixels together as ray packets",
+        default=False,
+    )
 
     adaptive_compile_description = "Compile the Cycles GPU kernel with only the feature set required for the current scene"
 
@@ -1472,6 +1497,13 @@ class CyclesRenderLayerSettings(bpy.types.PropertyGroup):
         default=False,
         update=update_render_passes,
     )
+    pass_debug_render_time: BoolProperty(
+        name="Debug Render Time",
+        description="Time spent rendering each pixel, averaged per sample in microseconds. To find "
+                    "expensive parts of the image. Only supported on the CPU",
+        default=False,
+        update=update_render_passes,
+    )
     use_pass_volume_direct: BoolProperty(
         name="Volume Direct",
         description="Deliver direct volumetric scattering pass",
@@ -69,6 +69,7 @@ void debug_flags_sync_from_scene(BL::Scene b_scene)
   flags.cpu.avx2 = get_boolean(cscene, "debug_use_cpu_avx2");
   flags.cpu.sse42 = get_boolean(cscene, "debug_use_cpu_sse42");
   flags.cpu.bvh_layout = (BVHLayout)get_enum(cscene, "debug_bvh_layout");
+  flags.cpu.ray_packets = get_boolean(cscene, "debug_use_cpu_ray_packets");
   /* Synchronize CUDA flags. */
   flags.cuda.adaptive_compile = get_boolean(cscene, "debug_use_cuda_adaptive_compile");
   flags.hip.adaptive_compile = get_boolean(cscene, "debug_use_hip_adaptive_compile");
@@ -922,6 +923,11 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *get_render_statistics_func(PyObject * /*self*/, PyObject * /*args*/)
+{
+  return PyUnicode_FromString(BlenderSession::render_statistics.c_str());
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   const vector<DeviceType> device_types = Device::available_types();
@@ -1022,6 +1028,7 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"get_render_statistics", get_render_statistics_func, METH_NOARGS, ""},
 
     /* Compute Device selection */
     {"get_device_types", get_device_types_func, METH_VARARGS, ""},
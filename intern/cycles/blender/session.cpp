@@ -39,6 +39,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+string BlenderSession::render_statistics;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -452,6 +453,7 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       RenderStats stats;
       session->collect_statistics(&stats);
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      render_statistics = stats.json_report();
     }
 
     if (session->progress.get_cancel()) {
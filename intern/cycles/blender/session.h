@@ -116,6 +116,8 @@ class BlenderSession {
   static bool headless;
 
   static bool print_render_stats;
+  /* JSON statistics of the last rendered view layer, when print_render_stats is enabled. */
+  static string render_statistics;
 
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
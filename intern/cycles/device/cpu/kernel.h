@@ -23,6 +23,10 @@ class CPUKernels {
   using IntegratorShadeFunction = CPUKernelFunction<void (*)(const ThreadKernelGlobalsCPU *kg,
                                                              IntegratorStateCPU *state,
                                                              ccl_global float *render_buffer)>;
+  using IntegratorPacketFunction = CPUKernelFunction<void (*)(const ThreadKernelGlobalsCPU *kg,
+                                                              IntegratorStateCPU **states,
+                                                              const int num_states,
+                                                              ccl_global float *render_buffer)>;
   using IntegratorInitFunction = CPUKernelFunction<bool (*)(const ThreadKernelGlobalsCPU *kg,
                                                             IntegratorStateCPU *state,
                                                             KernelWorkTile *tile,
@@ -31,6 +35,7 @@ class CPUKernels {
   IntegratorInitFunction integrator_init_from_camera;
   IntegratorInitFunction integrator_init_from_bake;
   IntegratorShadeFunction integrator_megakernel;
+  IntegratorPacketFunction integrator_megakernel_packet;
 
   /* Shader evaluation. */
 
@@ -182,6 +182,7 @@ device_texture::device_texture(Device *device,
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
     case IMAGE_DATA_TYPE_NANOVDB_FPN:
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
+    case IMAGE_DATA_TYPE_CACHED:
       data_type = TYPE_UCHAR;
       data_elements = 1;
       break;
@@ -201,6 +202,16 @@ device_texture::device_texture(Device *device,
       data_type = TYPE_UINT16;
       data_elements = 1;
       break;
+    case IMAGE_DATA_TYPE_BC1:
+    case IMAGE_DATA_TYPE_BC4:
+      /* Elements are 8 byte blocks of 4x4 pixels. */
+      data_type = TYPE_UCHAR;
+      data_elements = 8;
+      break;
+    case IMAGE_DATA_TYPE_BC3:
+      data_type = TYPE_UCHAR;
+      data_elements = 16;
+      break;
     case IMAGE_DATA_NUM_TYPES:
       assert(0);
       return;
@@ -219,7 +230,11 @@ device_texture::~device_texture()
 /* Host memory allocation. */
 void *device_texture::alloc(const size_t width, const size_t height, const size_t depth)
 {
-  const size_t new_size = size(width, height, depth);
+  /* Block compressed images are allocated as blocks, the texture info keeps the pixel size. */
+  const bool is_block_compressed = image_data_type_is_block_compressed(info.data_type);
+  const size_t elements_width = (is_block_compressed) ? divide_up(width, 4) : width;
+  const size_t elements_height = (is_block_compressed) ? divide_up(height, 4) : height;
+  const size_t new_size = size(elements_width, elements_height, depth);
 
   if (new_size != data_size) {
     host_and_device_free();
@@ -228,8 +243,8 @@ void *device_texture::alloc(const size_t width, const size_t height, const size_
   }
 
   data_size = new_size;
-  data_width = width;
-  data_height = height;
+  data_width = elements_width;
+  data_height = elements_height;
   data_depth = depth;
 
   info.width = width;
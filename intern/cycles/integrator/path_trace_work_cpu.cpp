@@ -19,7 +19,9 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/debug.h"
 #include "util/tbb.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -57,6 +59,7 @@ void PathTraceWorkCPU::init_execution()
 {
   /* Cache per-thread kernel globals. */
   device_->get_cpu_kernel_thread_globals(kernel_thread_globals_);
+  kernel_thread_packet_states_.resize(kernel_thread_globals_.size());
 }
 
 void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
@@ -66,7 +69,16 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 {
   const int64_t image_width = effective_buffer_params_.width;
   const int64_t image_height = effective_buffer_params_.height;
-  const int64_t total_pixels_num = image_width * image_height;
+
+  /* Ray packets don't support baking, and path guiding records one path per thread at a time. */
+  const KernelData &data = device_scene_->data;
+  const bool use_ray_packets = DebugFlags().cpu.ray_packets && !data.bake.use &&
+                               !data.integrator.use_guiding;
+
+  /* Work is split into rows of packet_size pixels. */
+  const int packet_size = use_ray_packets ? INTEGRATOR_PACKET_SIZE : 1;
+  const int64_t row_work_num = divide_up(image_width, packet_size);
+  const int64_t total_work_num = row_work_num * image_height;
 
   if (device_->profiler.active()) {
     for (ThreadKernelGlobalsCPU &kernel_globals : kernel_thread_globals_) {
@@ -76,18 +88,18 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
-    parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+    parallel_for(int64_t(0), total_work_num, [&](int64_t work_index) {
       if (is_cancel_requested()) {
         return;
       }
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
+      const int y = work_index / row_work_num;
+      const int x = (work_index - y * row_work_num) * packet_size;
 
       KernelWorkTile work_tile;
       work_tile.x = effective_buffer_params_.full_x + x;
       work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
+      work_tile.w = min(packet_size, int(image_width - x));
       work_tile.h = 1;
       work_tile.start_sample = start_sample;
       work_tile.sample_offset = sample_offset;
@@ -97,7 +109,12 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 
       ThreadKernelGlobalsCPU *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      if (use_ray_packets) {
+        render_samples_packet(kernel_globals, work_tile, samples_num);
+      }
+      else {
+        render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      }
     });
   });
   if (device_->profiler.active()) {
@@ -128,6 +145,9 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
   KernelWorkTile sample_work_tile = work_tile;
   float *render_buffer = buffers_->buffer.data();
 
+  const int pass_render_time = device_scene_->data.film.pass_render_time;
+  const double start_time = (pass_render_time != PASS_UNUSED) ? time_dt() : 0.0;
+
   for (int sample = 0; sample < samples_num; ++sample) {
     if (is_cancel_requested()) {
       break;
@@ -163,6 +183,97 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
 
     ++sample_work_tile.start_sample;
   }
+
+  if (pass_render_time != PASS_UNUSED) {
+    /* Every pixel is rendered by a single thread, so the buffer can be written directly. The pass
+     * accessor divides by the number of samples. */
+    const int64_t render_pixel_index = work_tile.offset + work_tile.x +
+                                       int64_t(work_tile.y) * work_tile.stride;
+    float *buffer = render_buffer + render_pixel_index * device_scene_->data.film.pass_stride;
+    buffer[pass_render_time] += float((time_dt() - start_time) * 1e6);
+  }
+}
+
+void PathTraceWorkCPU::render_samples_packet(ThreadKernelGlobalsCPU *kernel_globals,
+                                             const KernelWorkTile &work_tile,
+                                             const int samples_num)
+{
+  vector<IntegratorStateCPU> &integrator_states =
+      kernel_thread_packet_states_[kernel_globals - kernel_thread_globals_.data()];
+  if (integrator_states.empty()) {
+    integrator_states.resize(INTEGRATOR_PACKET_SIZE * 2);
+  }
+
+  const bool has_shadow_catcher = device_scene_->data.integrator.has_shadow_catcher;
+  float *render_buffer = buffers_->buffer.data();
+
+  /* Pixels stop sampling once the init kernel rejects them, same as in the full pipeline. */
+  bool pixel_active[INTEGRATOR_PACKET_SIZE];
+  for (int i = 0; i < work_tile.w; i++) {
+    pixel_active[i] = true;
+    if (has_shadow_catcher) {
+      path_state_init_queues(&integrator_states[i * 2 + 1]);
+    }
+  }
+
+  const int pass_render_time = device_scene_->data.film.pass_render_time;
+  const double start_time = (pass_render_time != PASS_UNUSED) ? time_dt() : 0.0;
+
+  for (int sample = 0; sample < samples_num; ++sample) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    IntegratorStateCPU *states[INTEGRATOR_PACKET_SIZE];
+    IntegratorStateCPU *shadow_catcher_states[INTEGRATOR_PACKET_SIZE];
+    int num_states = 0;
+
+    for (int i = 0; i < work_tile.w; i++) {
+      if (!pixel_active[i]) {
+        continue;
+      }
+
+      KernelWorkTile pixel_work_tile = work_tile;
+      pixel_work_tile.x = work_tile.x + i;
+      pixel_work_tile.w = 1;
+      pixel_work_tile.start_sample = work_tile.start_sample + sample;
+
+      IntegratorStateCPU *state = &integrator_states[i * 2];
+      if (!kernels_.integrator_init_from_camera(
+              kernel_globals, state, &pixel_work_tile, render_buffer))
+      {
+        pixel_active[i] = false;
+        continue;
+      }
+
+      states[num_states] = state;
+      shadow_catcher_states[num_states] = state + 1;
+      num_states++;
+    }
+
+    if (num_states == 0) {
+      break;
+    }
+
+    kernels_.integrator_megakernel_packet(kernel_globals, states, num_states, render_buffer);
+
+    if (has_shadow_catcher) {
+      kernels_.integrator_megakernel_packet(
+          kernel_globals, shadow_catcher_states, num_states, render_buffer);
+    }
+  }
+
+  if (pass_render_time != PASS_UNUSED) {
+    /* Pixels of the packet are rendered together, so share the time evenly. */
+    const float pixel_time = float((time_dt() - start_time) * 1e6) / work_tile.w;
+    const int64_t render_pixel_index = work_tile.offset + work_tile.x +
+                                       int64_t(work_tile.y) * work_tile.stride;
+    const int pass_stride = device_scene_->data.film.pass_stride;
+    for (int i = 0; i < work_tile.w; i++) {
+      float *buffer = render_buffer + (render_pixel_index + i) * pass_stride;
+      buffer[pass_render_time] += pixel_time;
+    }
+  }
 }
 
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
@@ -74,6 +74,12 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Render a row of up to INTEGRATOR_PACKET_SIZE pixels, tracing rays of all pixels together as
+   * ray packets. */
+  void render_samples_packet(ThreadKernelGlobalsCPU *kernel_globals,
+                             const KernelWorkTile &work_tile,
+                             const int samples_num);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +89,10 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<ThreadKernelGlobalsCPU> kernel_thread_globals_;
+
+  /* Integrator states for packets, per thread and allocated on first use. Every main path state
+   * is followed by its shadow catcher state. */
+  vector<vector<IntegratorStateCPU>> kernel_thread_packet_states_;
 };
 
 CCL_NAMESPACE_END
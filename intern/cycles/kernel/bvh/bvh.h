@@ -145,6 +145,47 @@ ccl_device_intersect bool scene_intersect_shadow(KernelGlobals kg,
   return scene_intersect(kg, ray, visibility, &isect);
 }
 
+#  ifndef __KERNEL_GPU__
+/* Ray packets on the CPU, traced one ray at a time when the BVH has no packet support. */
+
+ccl_device_intersect void scene_intersect_packet(KernelGlobals kg,
+                                                 const ccl_private Ray *rays,
+                                                 const uint *visibility,
+                                                 const int num_rays,
+                                                 ccl_private Intersection *isect,
+                                                 bool *hit)
+{
+#    ifdef __EMBREE_RAY_PACKETS__
+  if (kernel_data.device_bvh) {
+    kernel_embree_intersect_packet(kg, rays, visibility, num_rays, isect, hit);
+    return;
+  }
+#    endif
+
+  for (int i = 0; i < num_rays; i++) {
+    hit[i] = scene_intersect(kg, &rays[i], visibility[i], &isect[i]);
+  }
+}
+
+ccl_device_intersect void scene_intersect_shadow_packet(KernelGlobals kg,
+                                                        const ccl_private Ray *rays,
+                                                        const uint *visibility,
+                                                        const int num_rays,
+                                                        bool *hit)
+{
+#    ifdef __EMBREE_RAY_PACKETS__
+  if (kernel_data.device_bvh) {
+    kernel_embree_intersect_shadow_packet(kg, rays, visibility, num_rays, hit);
+    return;
+  }
+#    endif
+
+  for (int i = 0; i < num_rays; i++) {
+    hit[i] = scene_intersect_shadow(kg, &rays[i], visibility[i]);
+  }
+}
+#  endif
+
 /* Single object BVH traversal, for SSS/AO/bevel. */
 
 #  ifdef __BVH_LOCAL__
@@ -122,6 +122,8 @@ KERNEL_STRUCT_MEMBER(film, int, pass_mist)
 KERNEL_STRUCT_MEMBER(film, float, mist_start)
 KERNEL_STRUCT_MEMBER(film, float, mist_inv_depth)
 KERNEL_STRUCT_MEMBER(film, float, mist_falloff)
+/* Render time. */
+KERNEL_STRUCT_MEMBER(film, int, pass_render_time)
 /* Denoising. */
 KERNEL_STRUCT_MEMBER(film, int, pass_denoising_normal)
 KERNEL_STRUCT_MEMBER(film, int, pass_denoising_albedo)
@@ -946,4 +946,146 @@ ccl_device_intersect uint kernel_embree_intersect_volume(KernelGlobals kg,
 }
 #endif
 
+/* Ray packets.
+ *
+ * Coherent rays, like camera rays of neighboring pixels, are traced together with Embree's
+ * packet API. Every ray stores its index into the packet in the Embree ray id, since filter
+ * functions may be invoked for any subset of the packet. */
+
+#if EMBREE_MAJOR_VERSION >= 4 && !defined(__KERNEL_ONEAPI__)
+#  define __EMBREE_RAY_PACKETS__
+
+struct CCLPacketContext : public RTCRayQueryContext {
+  KernelGlobals kg;
+  const Ray *rays;
+};
+
+ccl_device_forceinline void kernel_embree_filter_packet_func(
+    const RTCFilterFunctionNArguments *args)
+{
+  const CCLPacketContext *ctx = (const CCLPacketContext *)(args->context);
+  const intptr_t prim_offset = reinterpret_cast<intptr_t>(args->geometryUserPtr);
+
+  for (uint i = 0; i < args->N; i++) {
+    if (args->valid[i] == 0) {
+      continue;
+    }
+
+    const Ray *cray = &ctx->rays[RTCRayN_id(args->ray, args->N, i)];
+    const RTCHit hit = rtcGetHitFromHitN(args->hit, args->N, i);
+
+    if (kernel_embree_is_self_intersection(ctx->kg, &hit, cray, prim_offset)) {
+      args->valid[i] = 0;
+      continue;
+    }
+
+#  ifdef __SHADOW_LINKING__
+    if (intersection_skip_shadow_link(ctx->kg, cray->self, kernel_embree_get_hit_object(&hit))) {
+      args->valid[i] = 0;
+    }
+#  endif
+  }
+}
+
+ccl_device_inline void kernel_embree_setup_ray_packet(const Ray &ray,
+                                                      RTCRay8 &rtc_rays,
+                                                      const int i,
+                                                      const uint visibility)
+{
+  rtc_rays.org_x[i] = ray.P.x;
+  rtc_rays.org_y[i] = ray.P.y;
+  rtc_rays.org_z[i] = ray.P.z;
+  rtc_rays.dir_x[i] = ray.D.x;
+  rtc_rays.dir_y[i] = ray.D.y;
+  rtc_rays.dir_z[i] = ray.D.z;
+  rtc_rays.tnear[i] = ray.tmin;
+  rtc_rays.tfar[i] = ray.tmax;
+  rtc_rays.time[i] = ray.time;
+  rtc_rays.mask[i] = visibility;
+  rtc_rays.id[i] = i;
+  rtc_rays.flags[i] = 0;
+}
+
+/* Closest hit of up to INTEGRATOR_PACKET_SIZE rays. Invalid rays report no hit. */
+ccl_device_intersect void kernel_embree_intersect_packet(KernelGlobals kg,
+                                                         const Ray *rays,
+                                                         const uint *visibility,
+                                                         const int num_rays,
+                                                         Intersection *isect,
+                                                         bool *hit)
+{
+  kernel_assert(num_rays <= INTEGRATOR_PACKET_SIZE);
+
+  CCLPacketContext ctx;
+  rtcInitRayQueryContext(&ctx);
+  ctx.kg = kg;
+  ctx.rays = rays;
+
+  ccl_align(32) int valid[INTEGRATOR_PACKET_SIZE];
+  RTCRayHit8 ray_hit;
+  for (int i = 0; i < INTEGRATOR_PACKET_SIZE; i++) {
+    valid[i] = (i < num_rays && intersection_ray_valid(&rays[i])) ? -1 : 0;
+    if (valid[i]) {
+      kernel_embree_setup_ray_packet(rays[i], ray_hit.ray, i, visibility[i]);
+      ray_hit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+      ray_hit.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+    }
+  }
+
+  RTCIntersectArguments args;
+  rtcInitIntersectArguments(&args);
+  args.filter = reinterpret_cast<RTCFilterFunctionN>(kernel_embree_filter_packet_func);
+  args.feature_mask = CYCLES_EMBREE_USED_FEATURES;
+  args.context = &ctx;
+  rtcIntersect8(valid, kernel_data.device_bvh, &ray_hit, &args);
+
+  for (int i = 0; i < num_rays; i++) {
+    isect[i].t = rays[i].tmax;
+    hit[i] = valid[i] && ray_hit.hit.geomID[i] != RTC_INVALID_GEOMETRY_ID &&
+             ray_hit.hit.primID[i] != RTC_INVALID_GEOMETRY_ID;
+    if (hit[i]) {
+      const RTCRay rtc_ray = rtcGetRayFromRayN((RTCRayN *)&ray_hit.ray, 8, i);
+      const RTCHit rtc_hit = rtcGetHitFromHitN((RTCHitN *)&ray_hit.hit, 8, i);
+      kernel_embree_convert_hit(kg, &rtc_ray, &rtc_hit, &isect[i]);
+    }
+  }
+}
+
+/* Any hit of up to INTEGRATOR_PACKET_SIZE rays, for opaque shadows. */
+ccl_device_intersect void kernel_embree_intersect_shadow_packet(KernelGlobals kg,
+                                                                const Ray *rays,
+                                                                const uint *visibility,
+                                                                const int num_rays,
+                                                                bool *hit)
+{
+  kernel_assert(num_rays <= INTEGRATOR_PACKET_SIZE);
+
+  CCLPacketContext ctx;
+  rtcInitRayQueryContext(&ctx);
+  ctx.kg = kg;
+  ctx.rays = rays;
+
+  ccl_align(32) int valid[INTEGRATOR_PACKET_SIZE];
+  RTCRay8 rtc_rays;
+  for (int i = 0; i < INTEGRATOR_PACKET_SIZE; i++) {
+    valid[i] = (i < num_rays && intersection_ray_valid(&rays[i])) ? -1 : 0;
+    if (valid[i]) {
+      kernel_embree_setup_ray_packet(rays[i], rtc_rays, i, visibility[i]);
+    }
+  }
+
+  RTCOccludedArguments args;
+  rtcInitOccludedArguments(&args);
+  args.filter = reinterpret_cast<RTCFilterFunctionN>(kernel_embree_filter_packet_func);
+  args.feature_mask = CYCLES_EMBREE_USED_FEATURES;
+  args.context = &ctx;
+  rtcOccluded8(valid, kernel_data.device_bvh, &rtc_rays, &args);
+
+  /* rtcOccluded8 sets tfar to -inf for rays that hit something. */
+  for (int i = 0; i < num_rays; i++) {
+    hit[i] = valid[i] && rtc_rays.tfar[i] < 0.0f;
+  }
+}
+#endif
+
 CCL_NAMESPACE_END
@@ -12,6 +12,7 @@
 #endif
 
 #include "util/half.h"
+#include "util/texture_compress.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -89,12 +90,36 @@ template<typename TexT, typename OutT = float4> struct TextureInterpolator {
     return make_float4(r.x * f, r.y * f, r.z * f, r.w * f);
   }
 
+  static ccl_always_inline float4 read(const TextureBlockBC1 &block, const int pixel)
+  {
+    const float3 color = texture_block_bc1_decode(block, pixel);
+    return make_float4(color.x, color.y, color.z, 1.0f);
+  }
+
+  static ccl_always_inline float4 read(const TextureBlockBC3 &block, const int pixel)
+  {
+    return texture_block_bc3_decode(block, pixel);
+  }
+
+  static ccl_always_inline float read(const TextureBlockBC4 &block, const int pixel)
+  {
+    return texture_block_bc4_decode(block, pixel);
+  }
+
   /* Read 2D Texture Data
    * Does not check if data request is in bounds. */
   static ccl_always_inline OutT
   read(const TexT *data, const int x, int y, const int width, const int height)
   {
-    return read(data[y * width + x]);
+    if constexpr (std::is_same_v<TexT, TextureBlockBC1> || std::is_same_v<TexT, TextureBlockBC3> ||
+                  std::is_same_v<TexT, TextureBlockBC4>)
+    {
+      /* Decode the pixel from its 4x4 block. */
+      return read(data[texture_block_index(x, y, width)], texture_block_pixel(x, y));
+    }
+    else {
+      return read(data[y * width + x]);
+    }
   }
 
   /* Read 2D Texture Data Clip
@@ -105,7 +130,7 @@ template<typename TexT, typename OutT = float4> struct TextureInterpolator {
     if (x < 0 || x >= width || y < 0 || y >= height) {
       return zero();
     }
-    return read(data[y * width + x]);
+    return read(data, x, y, width, height);
   }
 
   /* Read 3D Texture Data
@@ -831,6 +856,17 @@ template<typename TexT, typename OutT> struct NanoVDBInterpolator {
 
 #undef SET_CUBIC_SPLINE_WEIGHTS
 
+/* Image read on demand by the texture cache, which handles filtering and mipmap selection. */
+ccl_device_inline float4 kernel_tex_image_cached(const TextureInfo &info,
+                                                 const float x,
+                                                 const float y,
+                                                 const float2 dx,
+                                                 const float2 dy)
+{
+  const TextureCacheImage *image = (const TextureCacheImage *)info.data;
+  return image->lookup(image, x, y, dx, dy);
+}
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, const int id, const float x, float y)
 {
   const TextureInfo &info = kernel_data_fetch(texture_info, id);
@@ -864,6 +900,16 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, const int id, const
       return TextureInterpolator<ushort4>::interp(info, x, y);
     case IMAGE_DATA_TYPE_FLOAT4:
       return TextureInterpolator<float4>::interp(info, x, y);
+    case IMAGE_DATA_TYPE_BC4: {
+      const float f = TextureInterpolator<TextureBlockBC4, float>::interp(info, x, y);
+      return make_float4(f, f, f, 1.0f);
+    }
+    case IMAGE_DATA_TYPE_BC1:
+      return TextureInterpolator<TextureBlockBC1>::interp(info, x, y);
+    case IMAGE_DATA_TYPE_BC3:
+      return TextureInterpolator<TextureBlockBC3>::interp(info, x, y);
+    case IMAGE_DATA_TYPE_CACHED:
+      return kernel_tex_image_cached(info, x, y, zero_float2(), zero_float2());
     default:
       assert(0);
       return make_float4(
@@ -871,6 +917,24 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, const int id, const
   }
 }
 
+/* Lookup with the footprint of the ray differentials, only images read through the texture cache
+ * use it for filtering. */
+ccl_device float4 kernel_tex_image_interp_filtered(KernelGlobals kg,
+                                                   const int id,
+                                                   const float x,
+                                                   const float y,
+                                                   const float2 dx,
+                                                   const float2 dy)
+{
+  const TextureInfo &info = kernel_data_fetch(texture_info, id);
+
+  if (info.data_type == IMAGE_DATA_TYPE_CACHED && info.data) {
+    return kernel_tex_image_cached(info, x, y, dx, dy);
+  }
+
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+
 ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals kg,
                                              const int id,
                                              float3 P,
@@ -18,6 +18,13 @@
       IntegratorStateCPU *state, \
       ccl_global float *render_buffer)
 
+#define KERNEL_INTEGRATOR_PACKET_FUNCTION(name) \
+  void KERNEL_FUNCTION_FULL_NAME(integrator_##name)( \
+      const ThreadKernelGlobalsCPU *ccl_restrict kg, \
+      IntegratorStateCPU **states, \
+      const int num_states, \
+      ccl_global float *render_buffer)
+
 #define KERNEL_INTEGRATOR_INIT_FUNCTION(name) \
   bool KERNEL_FUNCTION_FULL_NAME(integrator_##name)( \
       const ThreadKernelGlobalsCPU *ccl_restrict kg, \
@@ -28,8 +35,10 @@
 KERNEL_INTEGRATOR_INIT_FUNCTION(init_from_camera);
 KERNEL_INTEGRATOR_INIT_FUNCTION(init_from_bake);
 KERNEL_INTEGRATOR_SHADE_FUNCTION(megakernel);
+KERNEL_INTEGRATOR_PACKET_FUNCTION(megakernel_packet);
 
 #undef KERNEL_INTEGRATOR_FUNCTION
+#undef KERNEL_INTEGRATOR_PACKET_FUNCTION
 #undef KERNEL_INTEGRATOR_INIT_FUNCTION
 #undef KERNEL_INTEGRATOR_SHADE_FUNCTION
 
@@ -339,16 +339,13 @@ ccl_device_forceinline void integrator_intersect_next_kernel_after_volume(
   }
 }
 
-ccl_device void integrator_intersect_closest(KernelGlobals kg,
-                                             IntegratorState state,
-                                             ccl_global float *ccl_restrict render_buffer)
+/* Read the ray for the closest hit intersection from the path state, returns its visibility. */
+ccl_device_forceinline uint integrator_intersect_closest_ray(KernelGlobals kg,
+                                                             IntegratorState state,
+                                                             ccl_private Ray *ccl_restrict ray)
 {
-  PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
-
-  /* Read ray from integrator state into local memory. */
-  Ray ray ccl_optional_struct_init;
-  integrator_state_read_ray(state, &ray);
-  kernel_assert(ray.tmax != 0.0f);
+  integrator_state_read_ray(state, ray);
+  kernel_assert(ray->tmax != 0.0f);
 
   const uint visibility = path_state_ray_visibility(state);
   const int last_isect_prim = INTEGRATOR_STATE(state, isect, prim);
@@ -356,32 +353,43 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
 
   /* Trick to use short AO rays to approximate indirect light at the end of the path. */
   if (path_state_ao_bounce(kg, state)) {
-    ray.tmax = kernel_data.integrator.ao_bounces_distance;
+    ray->tmax = kernel_data.integrator.ao_bounces_distance;
 
     if (last_isect_object != OBJECT_NONE) {
       const float object_ao_distance = kernel_data_fetch(objects, last_isect_object).ao_distance;
       if (object_ao_distance != 0.0f) {
-        ray.tmax = object_ao_distance;
+        ray->tmax = object_ao_distance;
       }
     }
   }
 
-  /* Scene Intersection. */
-  Intersection isect ccl_optional_struct_init;
-  isect.object = OBJECT_NONE;
-  isect.prim = PRIM_NONE;
-  ray.self.object = last_isect_object;
-  ray.self.prim = last_isect_prim;
-  ray.self.light_object = OBJECT_NONE;
-  ray.self.light_prim = PRIM_NONE;
-  ray.self.light = LAMP_NONE;
-  bool hit = scene_intersect(kg, &ray, visibility, &isect);
+  ray->self.object = last_isect_object;
+  ray->self.prim = last_isect_prim;
+  ray->self.light_object = OBJECT_NONE;
+  ray->self.light_prim = PRIM_NONE;
+  ray->self.light = LAMP_NONE;
 
+  return visibility;
+}
+
+/* Handle the scene intersection result: intersect lights, write the intersection into the path
+ * state and set up the next kernel. */
+ccl_device_forceinline void integrator_intersect_closest_result(
+    KernelGlobals kg,
+    IntegratorState state,
+    ccl_global float *ccl_restrict render_buffer,
+    const ccl_private Ray *ccl_restrict ray,
+    ccl_private Intersection *ccl_restrict isect,
+    bool hit)
+{
   /* TODO: remove this and do it in the various intersection functions instead. */
   if (!hit) {
-    isect.prim = PRIM_NONE;
+    isect->prim = PRIM_NONE;
   }
 
+  const int last_isect_prim = INTEGRATOR_STATE(state, isect, prim);
+  const int last_isect_object = INTEGRATOR_STATE(state, isect, object);
+
   /* Setup mnee flag to signal last intersection with a caster */
   const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
 
@@ -417,16 +425,35 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
      * these in the path_state_init. */
     const int last_type = INTEGRATOR_STATE(state, isect, type);
     hit = lights_intersect(
-              kg, state, &ray, &isect, last_isect_prim, last_isect_object, last_type, path_flag) ||
+              kg, state, ray, isect, last_isect_prim, last_isect_object, last_type, path_flag) ||
           hit;
   }
 
   /* Write intersection result into global integrator state memory. */
-  integrator_state_write_isect(state, &isect);
+  integrator_state_write_isect(state, isect);
 
   /* Setup up next kernel to be executed. */
   integrator_intersect_next_kernel<DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST>(
-      kg, state, &isect, render_buffer, hit);
+      kg, state, isect, render_buffer, hit);
+}
+
+ccl_device void integrator_intersect_closest(KernelGlobals kg,
+                                             IntegratorState state,
+                                             ccl_global float *ccl_restrict render_buffer)
+{
+  PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
+
+  /* Read ray from integrator state into local memory. */
+  Ray ray ccl_optional_struct_init;
+  const uint visibility = integrator_intersect_closest_ray(kg, state, &ray);
+
+  /* Scene Intersection. */
+  Intersection isect ccl_optional_struct_init;
+  isect.object = OBJECT_NONE;
+  isect.prim = PRIM_NONE;
+  const bool hit = scene_intersect(kg, &ray, visibility, &isect);
+
+  integrator_intersect_closest_result(kg, state, render_buffer, &ray, &isect, hit);
 }
 
 CCL_NAMESPACE_END
@@ -29,26 +29,37 @@ ccl_device_forceinline uint integrate_intersect_shadow_visibility(KernelGlobals
   return visibility;
 }
 
-ccl_device bool integrate_intersect_shadow_opaque(KernelGlobals kg,
-                                                  IntegratorShadowState state,
-                                                  const ccl_private Ray *ray,
-                                                  const uint visibility)
+/* Mask which will pick only opaque visibility bits from the `visibility`.
+ * Calculate the mask at compile time: the visibility will either be a high bits for the shadow
+ * catcher objects, or lower bits for the regular objects (there is no need to check the path
+ * state here again). */
+ccl_device_forceinline uint integrate_intersect_shadow_opaque_visibility(const uint visibility)
 {
-  /* Mask which will pick only opaque visibility bits from the `visibility`.
-   * Calculate the mask at compile time: the visibility will either be a high bits for the shadow
-   * catcher objects, or lower bits for the regular objects (there is no need to check the path
-   * state here again). */
   constexpr const uint opaque_mask = SHADOW_CATCHER_VISIBILITY_SHIFT(PATH_RAY_SHADOW_OPAQUE) |
                                      PATH_RAY_SHADOW_OPAQUE;
+  return visibility & opaque_mask;
+}
 
-  const bool opaque_hit = scene_intersect_shadow(kg, ray, visibility & opaque_mask);
-
+ccl_device_forceinline void integrate_intersect_shadow_opaque_result(IntegratorShadowState state,
+                                                                     const bool opaque_hit)
+{
   /* Only record the number of hits if nothing was hit, so that the shadow shading kernel does not
    * consider any intersections. There is no need to write anything to the state if the hit is
    * opaque because in this case the path is terminated. */
   if (!opaque_hit) {
     INTEGRATOR_STATE_WRITE(state, shadow_path, num_hits) = 0;
   }
+}
+
+ccl_device bool integrate_intersect_shadow_opaque(KernelGlobals kg,
+                                                  IntegratorShadowState state,
+                                                  const ccl_private Ray *ray,
+                                                  const uint visibility)
+{
+  const bool opaque_hit = scene_intersect_shadow(
+      kg, ray, integrate_intersect_shadow_opaque_visibility(visibility));
+
+  integrate_intersect_shadow_opaque_result(state, opaque_hit);
 
   return opaque_hit;
 }
@@ -151,16 +162,42 @@ ccl_device bool integrate_intersect_shadow_transparent(KernelGlobals kg,
 }
 #endif
 
+/* Read the shadow ray from the shadow path state, returns its visibility. */
+ccl_device_forceinline uint integrator_intersect_shadow_ray(KernelGlobals kg,
+                                                            IntegratorShadowState state,
+                                                            ccl_private Ray *ccl_restrict ray)
+{
+  integrator_state_read_shadow_ray(state, ray);
+  integrator_state_read_shadow_ray_self(kg, state, ray);
+  return integrate_intersect_shadow_visibility(kg, state);
+}
+
+ccl_device_forceinline void integrator_intersect_shadow_result(KernelGlobals kg,
+                                                               IntegratorShadowState state,
+                                                               const bool opaque_hit)
+{
+  if (opaque_hit) {
+    /* Hit an opaque surface, shadow path ends here. */
+    integrator_shadow_path_terminate(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW);
+    return;
+  }
+
+  /* Hit nothing or transparent surfaces, continue to shadow kernel
+   * for shading and render buffer output.
+   *
+   * TODO: could also write to render buffer directly if no transparent shadows?
+   * Could save a kernel execution for the common case. */
+  integrator_shadow_path_next(
+      kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW, DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW);
+}
+
 ccl_device void integrator_intersect_shadow(KernelGlobals kg, IntegratorShadowState state)
 {
   PROFILING_INIT(kg, PROFILING_INTERSECT_SHADOW);
 
   /* Read ray from integrator state into local memory. */
   Ray ray ccl_optional_struct_init;
-  integrator_state_read_shadow_ray(state, &ray);
-  integrator_state_read_shadow_ray_self(kg, state, &ray);
-  /* Compute visibility. */
-  const uint visibility = integrate_intersect_shadow_visibility(kg, state);
+  const uint visibility = integrator_intersect_shadow_ray(kg, state, &ray);
 
 #ifdef __TRANSPARENT_SHADOWS__
   /* TODO: compile different kernels depending on this? Especially for OptiX
@@ -172,19 +209,7 @@ ccl_device void integrator_intersect_shadow(KernelGlobals kg, IntegratorShadowSt
   const bool opaque_hit = integrate_intersect_shadow_opaque(kg, state, &ray, visibility);
 #endif
 
-  if (opaque_hit) {
-    /* Hit an opaque surface, shadow path ends here. */
-    integrator_shadow_path_terminate(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW);
-    return;
-  }
-
-  /* Hit nothing or transparent surfaces, continue to shadow kernel
-   * for shading and render buffer output.
-   *
-   * TODO: could also write to render buffer directly if no transparent shadows?
-   * Could save a kernel execution for the common case. */
-  integrator_shadow_path_next(
-      kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW, DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW);
+  integrator_intersect_shadow_result(kg, state, opaque_hit);
 }
 
 CCL_NAMESPACE_END
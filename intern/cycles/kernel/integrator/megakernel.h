@@ -18,6 +18,70 @@
 
 CCL_NAMESPACE_BEGIN
 
+ccl_device_forceinline void integrator_megakernel_shadow(KernelGlobals kg,
+                                                         IntegratorShadowState state,
+                                                         const uint32_t queued_kernel,
+                                                         ccl_global float *ccl_restrict
+                                                             render_buffer)
+{
+  switch (queued_kernel) {
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
+      integrator_intersect_shadow(kg, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW:
+      integrator_shade_shadow(kg, state, render_buffer);
+      break;
+    default:
+      kernel_assert(0);
+      break;
+  }
+}
+
+ccl_device_forceinline void integrator_megakernel_path(KernelGlobals kg,
+                                                       IntegratorState state,
+                                                       const uint32_t queued_kernel,
+                                                       ccl_global float *ccl_restrict render_buffer)
+{
+  switch (queued_kernel) {
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
+      integrator_intersect_closest(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_BACKGROUND:
+      integrator_shade_background(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE:
+      integrator_shade_surface(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME:
+      integrator_shade_volume(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE:
+      integrator_shade_surface_raytrace(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE:
+      integrator_shade_surface_mnee(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT:
+      integrator_shade_light(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_DEDICATED_LIGHT:
+      integrator_shade_dedicated_light(kg, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SUBSURFACE:
+      integrator_intersect_subsurface(kg, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK:
+      integrator_intersect_volume_stack(kg, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_DEDICATED_LIGHT:
+      integrator_intersect_dedicated_light(kg, state);
+      break;
+    default:
+      kernel_assert(0);
+      break;
+  }
+}
+
 ccl_device void integrator_megakernel(KernelGlobals kg,
                                       IntegratorState state,
                                       ccl_global float *ccl_restrict render_buffer)
@@ -29,78 +93,21 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
     const uint32_t shadow_queued_kernel = INTEGRATOR_STATE(
         &state->shadow, shadow_path, queued_kernel);
     if (shadow_queued_kernel) {
-      switch (shadow_queued_kernel) {
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
-          integrator_intersect_shadow(kg, &state->shadow);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW:
-          integrator_shade_shadow(kg, &state->shadow, render_buffer);
-          break;
-        default:
-          kernel_assert(0);
-          break;
-      }
+      integrator_megakernel_shadow(kg, &state->shadow, shadow_queued_kernel, render_buffer);
       continue;
     }
 
     /* Handle any AO paths before we potentially create more AO paths. */
     const uint32_t ao_queued_kernel = INTEGRATOR_STATE(&state->ao, shadow_path, queued_kernel);
     if (ao_queued_kernel) {
-      switch (ao_queued_kernel) {
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
-          integrator_intersect_shadow(kg, &state->ao);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW:
-          integrator_shade_shadow(kg, &state->ao, render_buffer);
-          break;
-        default:
-          kernel_assert(0);
-          break;
-      }
+      integrator_megakernel_shadow(kg, &state->ao, ao_queued_kernel, render_buffer);
       continue;
     }
 
     /* Then handle regular path kernels. */
     const uint32_t queued_kernel = INTEGRATOR_STATE(state, path, queued_kernel);
     if (queued_kernel) {
-      switch (queued_kernel) {
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
-          integrator_intersect_closest(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_BACKGROUND:
-          integrator_shade_background(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE:
-          integrator_shade_surface(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME:
-          integrator_shade_volume(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE:
-          integrator_shade_surface_raytrace(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE:
-          integrator_shade_surface_mnee(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT:
-          integrator_shade_light(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_SHADE_DEDICATED_LIGHT:
-          integrator_shade_dedicated_light(kg, state, render_buffer);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SUBSURFACE:
-          integrator_intersect_subsurface(kg, state);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK:
-          integrator_intersect_volume_stack(kg, state);
-          break;
-        case DEVICE_KERNEL_INTEGRATOR_INTERSECT_DEDICATED_LIGHT:
-          integrator_intersect_dedicated_light(kg, state);
-          break;
-        default:
-          kernel_assert(0);
-          break;
-      }
+      integrator_megakernel_path(kg, state, queued_kernel, render_buffer);
       continue;
     }
 
@@ -108,4 +115,118 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
   }
 }
 
+#ifndef __KERNEL_GPU__
+/* Megakernel for a packet of paths, advancing every path by one kernel at a time in the same
+ * order as integrator_megakernel. Closest hit and opaque shadow intersections of all paths are
+ * gathered and traced together as a ray packet, other kernels are executed per path.
+ *
+ * Paths of neighboring pixels start out coherent, so this mostly benefits camera rays and the
+ * shadow rays from their first hit. */
+ccl_device void integrator_megakernel_packet(KernelGlobals kg,
+                                             IntegratorState *states,
+                                             const int num_states,
+                                             ccl_global float *ccl_restrict render_buffer)
+{
+  kernel_assert(num_states <= INTEGRATOR_PACKET_SIZE);
+
+#  ifdef __TRANSPARENT_SHADOWS__
+  const bool use_shadow_packets = !kernel_data.integrator.transparent_shadows;
+#  else
+  const bool use_shadow_packets = true;
+#  endif
+
+  while (true) {
+    IntegratorState closest_states[INTEGRATOR_PACKET_SIZE];
+    IntegratorShadowState shadow_states[INTEGRATOR_PACKET_SIZE];
+    int num_closest = 0;
+    int num_shadow = 0;
+    bool active = false;
+
+    for (int i = 0; i < num_states; i++) {
+      IntegratorState state = states[i];
+
+      /* Handle shadow and AO paths before regular path kernels, as the megakernel does. */
+      IntegratorShadowState shadow_state = &state->shadow;
+      uint32_t shadow_queued_kernel = INTEGRATOR_STATE(shadow_state, shadow_path, queued_kernel);
+      if (!shadow_queued_kernel) {
+        shadow_state = &state->ao;
+        shadow_queued_kernel = INTEGRATOR_STATE(shadow_state, shadow_path, queued_kernel);
+      }
+
+      if (shadow_queued_kernel) {
+        if (use_shadow_packets &&
+            shadow_queued_kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW)
+        {
+          shadow_states[num_shadow++] = shadow_state;
+        }
+        else {
+          integrator_megakernel_shadow(kg, shadow_state, shadow_queued_kernel, render_buffer);
+        }
+        active = true;
+        continue;
+      }
+
+      const uint32_t queued_kernel = INTEGRATOR_STATE(state, path, queued_kernel);
+      if (queued_kernel) {
+        if (queued_kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) {
+          closest_states[num_closest++] = state;
+        }
+        else {
+          integrator_megakernel_path(kg, state, queued_kernel, render_buffer);
+        }
+        active = true;
+      }
+    }
+
+    if (!active) {
+      break;
+    }
+
+    Ray rays[INTEGRATOR_PACKET_SIZE];
+    uint visibility[INTEGRATOR_PACKET_SIZE];
+    bool hit[INTEGRATOR_PACKET_SIZE];
+
+    if (num_shadow == 1) {
+      integrator_intersect_shadow(kg, shadow_states[0]);
+    }
+    else if (num_shadow > 1) {
+      PROFILING_INIT(kg, PROFILING_INTERSECT_SHADOW);
+
+      for (int i = 0; i < num_shadow; i++) {
+        visibility[i] = integrate_intersect_shadow_opaque_visibility(
+            integrator_intersect_shadow_ray(kg, shadow_states[i], &rays[i]));
+      }
+
+      scene_intersect_shadow_packet(kg, rays, visibility, num_shadow, hit);
+
+      for (int i = 0; i < num_shadow; i++) {
+        integrate_intersect_shadow_opaque_result(shadow_states[i], hit[i]);
+        integrator_intersect_shadow_result(kg, shadow_states[i], hit[i]);
+      }
+    }
+
+    if (num_closest == 1) {
+      integrator_intersect_closest(kg, closest_states[0], render_buffer);
+    }
+    else if (num_closest > 1) {
+      PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
+
+      Intersection isect[INTEGRATOR_PACKET_SIZE];
+      for (int i = 0; i < num_closest; i++) {
+        visibility[i] = integrator_intersect_closest_ray(kg, closest_states[i], &rays[i]);
+        isect[i].object = OBJECT_NONE;
+        isect[i].prim = PRIM_NONE;
+      }
+
+      scene_intersect_packet(kg, rays, visibility, num_closest, isect, hit);
+
+      for (int i = 0; i < num_closest; i++) {
+        integrator_intersect_closest_result(
+            kg, closest_states[i], render_buffer, &rays[i], &isect[i], hit[i]);
+      }
+    }
+  }
+}
+#endif
+
 CCL_NAMESPACE_END
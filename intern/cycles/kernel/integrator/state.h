@@ -95,6 +95,10 @@ struct IntegratorStateCPU {
   IntegratorShadowStateCPU ao;
 };
 
+/* Number of paths the CPU advances together when tracing ray packets, matching the Embree
+ * rtcIntersect8 and rtcOccluded8 packet size. */
+#define INTEGRATOR_PACKET_SIZE 8
+
 /* Path Queue
  *
  * Keep track of which kernels are queued to be executed next in the path
@@ -62,6 +62,7 @@ light_sample_shader_eval(KernelGlobals kg,
     }
 
     PROFILING_SHADER(emission_sd->object, emission_sd->shader);
+    PROFILING_LIGHT(ls->lamp);
     PROFILING_EVENT(PROFILING_SHADE_LIGHT_EVAL);
 
     /* No proper path flag, we're evaluating this for all closures. that's
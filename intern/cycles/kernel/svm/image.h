@@ -17,15 +17,25 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device float4
-svm_image_texture(KernelGlobals kg, const int id, const float x, float y, const uint flags)
+ccl_device float4 svm_image_texture(KernelGlobals kg,
+                                    const int id,
+                                    const float x,
+                                    float y,
+                                    const float2 dx,
+                                    const float2 dy,
+                                    const uint flags)
 {
   if (id == -1) {
     return make_float4(
         TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
   }
 
+#ifndef __KERNEL_GPU__
+  /* Only the texture cache of the CPU uses the differentials, to select the mipmap level. */
+  float4 r = kernel_tex_image_interp_filtered(kg, id, x, y, dx, dy);
+#else
   float4 r = kernel_tex_image_interp(kg, id, x, y);
+#endif
   const float alpha = r.w;
 
   if ((flags & NODE_IMAGE_ALPHA_UNASSOCIATE) && alpha != 1.0f && alpha != 0.0f) {
@@ -40,12 +50,42 @@ svm_image_texture(KernelGlobals kg, const int id, const float x, float y, const
   return r;
 }
 
+ccl_device float4
+svm_image_texture(KernelGlobals kg, const int id, const float x, float y, const uint flags)
+{
+  return svm_image_texture(kg, id, x, y, zero_float2(), zero_float2(), flags);
+}
+
 /* Remap coordinate from 0..1 box to -1..-1 */
 ccl_device_inline float3 texco_remap_square(const float3 co)
 {
   return (co - make_float3(0.5f, 0.5f, 0.5f)) * 2.0f;
 }
 
+ccl_device_inline float2 svm_image_projection(const float3 co, const uint projection)
+{
+  if (projection == NODE_IMAGE_PROJ_SPHERE) {
+    return map_to_sphere(texco_remap_square(co));
+  }
+  if (projection == NODE_IMAGE_PROJ_TUBE) {
+    return map_to_tube(texco_remap_square(co));
+  }
+  return make_float2(co.x, co.y);
+}
+
+/* Difference to the texture coordinate of a neighboring ray. */
+ccl_device_inline float2 svm_image_differential(const float3 co,
+                                                const float2 tex_co,
+                                                const uint projection)
+{
+  float2 d = svm_image_projection(co, projection) - tex_co;
+  if (projection != NODE_IMAGE_PROJ_FLAT) {
+    /* Don't let the seam of the spherical mapping blur the whole image. */
+    d.x -= floorf(d.x + 0.5f);
+  }
+  return d;
+}
+
 ccl_device_noinline int svm_node_tex_image(KernelGlobals kg,
                                            ccl_private ShaderData * /*sd*/,
                                            ccl_private float *stack,
@@ -59,18 +99,17 @@ ccl_device_noinline int svm_node_tex_image(KernelGlobals kg,
 
   svm_unpack_node_uchar4(node.z, &co_offset, &out_offset, &alpha_offset, &flags);
 
-  float3 co = stack_load_float3(stack, co_offset);
-  float2 tex_co;
-  if (node.w == NODE_IMAGE_PROJ_SPHERE) {
-    co = texco_remap_square(co);
-    tex_co = map_to_sphere(co);
-  }
-  else if (node.w == NODE_IMAGE_PROJ_TUBE) {
-    co = texco_remap_square(co);
-    tex_co = map_to_tube(co);
-  }
-  else {
-    tex_co = make_float2(co.x, co.y);
+  const float3 co = stack_load_float3(stack, co_offset);
+  float2 tex_co = svm_image_projection(co, node.w);
+
+  float2 dx = zero_float2();
+  float2 dy = zero_float2();
+  if (flags & NODE_IMAGE_DIFFERENTIALS) {
+    const uint4 differentials_node = read_node(kg, &offset);
+    dx = svm_image_differential(
+        stack_load_float3(stack, differentials_node.x), tex_co, node.w);
+    dy = svm_image_differential(
+        stack_load_float3(stack, differentials_node.y), tex_co, node.w);
   }
 
   /* TODO(lukas): Consider moving tile information out of the SVM node.
@@ -116,7 +155,7 @@ ccl_device_noinline int svm_node_tex_image(KernelGlobals kg,
     id = -num_nodes;
   }
 
-  const float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags);
+  const float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, dx, dy, flags);
 
   if (stack_valid(out_offset)) {
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
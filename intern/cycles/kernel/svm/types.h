@@ -356,6 +356,8 @@ enum NodeImageProjection {
 enum NodeImageFlags {
   NODE_IMAGE_COMPRESS_AS_SRGB = 1,
   NODE_IMAGE_ALPHA_UNASSOCIATE = 2,
+  /* Texture coordinates for the ray differentials follow in an extra node. */
+  NODE_IMAGE_DIFFERENTIALS = 4,
 };
 
 enum NodeEnvironmentProjection {
@@ -567,6 +567,10 @@ enum PassType {
   PASS_GUIDING_PROBABILITY,
   /* The avg. roughness at the first bounce. */
   PASS_GUIDING_AVG_ROUGHNESS,
+
+  /* Time spent rendering the pixel, averaged per sample in microseconds. Only written by the CPU
+   * device. */
+  PASS_RENDER_TIME,
   PASS_CATEGORY_DATA_END = 63,
 
   PASS_BAKE_PRIMITIVE,
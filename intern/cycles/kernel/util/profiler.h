@@ -18,11 +18,13 @@ CCL_NAMESPACE_BEGIN
     ProfilingWithShaderHelper profiling_helper((ProfilingState *)&kg->profiler, event)
 #  define PROFILING_SHADER(object, shader) \
     profiling_helper.set_shader(object, (shader) & SHADER_MASK);
+#  define PROFILING_LIGHT(light) profiling_helper.set_light(light);
 #else
 #  define PROFILING_INIT(kg, event)
 #  define PROFILING_EVENT(event)
 #  define PROFILING_INIT_FOR_SHADER(kg, event)
 #  define PROFILING_SHADER(object, shader)
+#  define PROFILING_LIGHT(light)
 #endif /* !__KERNEL_GPU__ */
 
 CCL_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include "scene/image.h"
 #include "device/device.h"
 #include "scene/colorspace.h"
+#include "scene/image_cache.h"
 #include "scene/image_oiio.h"
 #include "scene/image_vdb.h"
 #include "scene/scene.h"
@@ -16,6 +17,7 @@
 #include "util/progress.h"
 #include "util/task.h"
 #include "util/texture.h"
+#include "util/texture_compress.h"
 
 #ifdef WITH_OSL
 #  include <OSL/oslexec.h>
@@ -52,6 +54,14 @@ const char *name_from_type(ImageDataType type)
       return "nanovdb_fpn";
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
       return "nanovdb_fp16";
+    case IMAGE_DATA_TYPE_CACHED:
+      return "cached";
+    case IMAGE_DATA_TYPE_BC1:
+      return "bc1";
+    case IMAGE_DATA_TYPE_BC3:
+      return "bc3";
+    case IMAGE_DATA_TYPE_BC4:
+      return "bc4";
     case IMAGE_DATA_NUM_TYPES:
       assert(!"System enumerator type, should never be used");
       return "";
@@ -313,6 +323,11 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+
+  /* The kernel calls into the texture cache, which only works on the CPU. Block compressed
+   * images are only decoded by the CPU kernel. */
+  texture_cache_supported = (info.type == DEVICE_CPU);
+  texture_compression_supported = (info.type == DEVICE_CPU);
 }
 
 ImageManager::~ImageManager()
@@ -327,6 +342,13 @@ void ImageManager::set_osl_texture_system(void *texture_system)
   osl_texture_system = texture_system;
 }
 
+bool ImageManager::use_texture_cache(const Scene *scene) const
+{
+  /* OSL has its own texture system for image files. */
+  return texture_cache_supported && scene->params.use_texture_cache &&
+         scene->params.shadingsystem == SHADINGSYSTEM_SVM;
+}
+
 bool ImageManager::set_animation_frame_update(const int frame)
 {
   if (frame != animation_frame) {
@@ -693,6 +715,84 @@ bool ImageManager::file_load_image(Image *img, const int texture_limit)
   return true;
 }
 
+bool ImageManager::cache_init_image(const Scene *scene, Image *img, TextureCacheImage &image)
+{
+  if (!texture_cache || !use_texture_cache(scene)) {
+    return false;
+  }
+
+  /* Only 2D image files, alpha is associated by the texture system like when loading the file. */
+  const ustring filepath = img->loader->osl_filepath();
+  if (filepath.empty() || img->metadata.depth > 1 ||
+      img->params.alpha_type == IMAGE_ALPHA_CHANNEL_PACKED ||
+      img->params.alpha_type == IMAGE_ALPHA_IGNORE)
+  {
+    return false;
+  }
+
+  return texture_cache->init_image(filepath, img->params, img->metadata, image);
+}
+
+bool ImageManager::use_texture_compression(const Scene *scene) const
+{
+  return texture_compression_supported && scene->params.use_texture_compression;
+}
+
+void ImageManager::device_compress_image(Device *device, Image *img, const size_t slot)
+{
+  const device_texture &mem = *img->mem;
+  const int width = mem.info.width;
+  const int height = mem.info.height;
+  if (mem.info.depth > 1) {
+    return;
+  }
+
+  /* Compress into a separate buffer first, so the uncompressed and compressed pixels are only in
+   * memory together briefly. */
+  ImageDataType type;
+  vector<uchar> blocks;
+  const size_t num_blocks = texture_compress_num_blocks(width, height);
+
+  if (mem.info.data_type == IMAGE_DATA_TYPE_BYTE4) {
+    const uchar4 *pixels = (const uchar4 *)mem.host_pointer;
+    bool has_alpha = false;
+    for (size_t i = 0; i < size_t(width) * height; i++) {
+      if (pixels[i].w != 255) {
+        has_alpha = true;
+        break;
+      }
+    }
+
+    if (has_alpha) {
+      type = IMAGE_DATA_TYPE_BC3;
+      blocks.resize(num_blocks * sizeof(TextureBlockBC3));
+      texture_compress_bc3(pixels, width, height, (TextureBlockBC3 *)blocks.data());
+    }
+    else {
+      type = IMAGE_DATA_TYPE_BC1;
+      blocks.resize(num_blocks * sizeof(TextureBlockBC1));
+      texture_compress_bc1(pixels, width, height, (TextureBlockBC1 *)blocks.data());
+    }
+  }
+  else if (mem.info.data_type == IMAGE_DATA_TYPE_BYTE) {
+    type = IMAGE_DATA_TYPE_BC4;
+    blocks.resize(num_blocks * sizeof(TextureBlockBC4));
+    texture_compress_bc4(
+        (const uchar *)mem.host_pointer, width, height, (TextureBlockBC4 *)blocks.data());
+  }
+  else {
+    return;
+  }
+
+  const thread_scoped_lock device_lock(device_mutex);
+  img->mem.reset();
+  img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(type), (int)slot);
+  img->mem = make_unique<device_texture>(
+      device, img->mem_name.c_str(), slot, type, img->params.interpolation, img->params.extension);
+  void *data = img->mem->alloc(width, height);
+  memcpy(data, blocks.data(), blocks.size());
+}
+
 void ImageManager::device_load_image(Device *device,
                                      Scene *scene,
                                      const size_t slot,
@@ -709,7 +809,11 @@ void ImageManager::device_load_image(Device *device,
   const int texture_limit = scene->params.texture_limit;
 
   load_image_metadata(img);
-  const ImageDataType type = img->metadata.type;
+
+  TextureCacheImage cache_image;
+  const ImageDataType type = (cache_init_image(scene, img, cache_image)) ?
+                                 IMAGE_DATA_TYPE_CACHED :
+                                 img->metadata.type;
 
   /* Name for debugging. */
   img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(type), (int)slot);
@@ -726,7 +830,13 @@ void ImageManager::device_load_image(Device *device,
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
   /* Create new texture. */
-  if (type == IMAGE_DATA_TYPE_FLOAT4) {
+  if (type == IMAGE_DATA_TYPE_CACHED) {
+    /* Pixels are read on demand by the kernel. */
+    const thread_scoped_lock device_lock(device_mutex);
+    TextureCacheImage *image = (TextureCacheImage *)img->mem->alloc(sizeof(TextureCacheImage), 0);
+    *image = cache_image;
+  }
+  else if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       const thread_scoped_lock device_lock(device_mutex);
@@ -758,6 +868,9 @@ void ImageManager::device_load_image(Device *device,
       pixels[2] = (TEX_IMAGE_MISSING_B * 255);
       pixels[3] = (TEX_IMAGE_MISSING_A * 255);
     }
+    else if (use_texture_compression(scene)) {
+      device_compress_image(device, img, slot);
+    }
   }
   else if (type == IMAGE_DATA_TYPE_BYTE) {
     if (!file_load_image<TypeDesc::UINT8, uchar>(img, texture_limit)) {
@@ -767,6 +880,9 @@ void ImageManager::device_load_image(Device *device,
 
       pixels[0] = (TEX_IMAGE_MISSING_R * 255);
     }
+    else if (use_texture_compression(scene)) {
+      device_compress_image(device, img, slot);
+    }
   }
   else if (type == IMAGE_DATA_TYPE_HALF4) {
     if (!file_load_image<TypeDesc::HALF, half>(img, texture_limit)) {
@@ -850,6 +966,10 @@ void ImageManager::device_free_image(Device * /*unused*/, size_t slot)
   }
 
   if (img->mem) {
+    if (img->mem->info.data_type == IMAGE_DATA_TYPE_CACHED) {
+      texture_cache->invalidate(img->loader->osl_filepath());
+    }
+
     const thread_scoped_lock device_lock(device_mutex);
     img->mem.reset();
   }
@@ -869,6 +989,13 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  if (use_texture_cache(scene)) {
+    if (!texture_cache) {
+      texture_cache = make_unique<TextureCache>();
+    }
+    texture_cache->set_memory_limit(scene->params.texture_cache_size);
+  }
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot].get();
@@ -949,9 +1076,18 @@ void ImageManager::collect_statistics(RenderStats *stats)
       /* Image may have been freed due to lack of users. */
       continue;
     }
+    if (image->mem->info.data_type == IMAGE_DATA_TYPE_CACHED) {
+      /* Memory is reported for the texture cache as a whole. */
+      stats->image.texture_cache.num_images++;
+      continue;
+    }
     stats->image.textures.add_entry(
         NamedSizeEntry(image->loader->name(), image->mem->memory_size()));
   }
+
+  if (texture_cache) {
+    texture_cache->collect_statistics(stats->image.texture_cache);
+  }
 }
 
 void ImageManager::tag_update()
@@ -26,6 +26,7 @@ class Progress;
 class RenderStats;
 class Scene;
 class ColorSpaceProcessor;
+class TextureCache;
 class VDBImageLoader;
 
 /* Image Parameters */
@@ -184,6 +185,9 @@ class ImageManager {
   void set_osl_texture_system(void *texture_system);
   bool set_animation_frame_update(const int frame);
 
+  /* Images are read on demand through the texture cache, see #TextureCache. */
+  bool use_texture_cache(const Scene *scene) const;
+
   void collect_statistics(RenderStats *stats);
 
   void tag_update();
@@ -219,6 +223,11 @@ class ImageManager {
   vector<unique_ptr<Image>> images;
   void *osl_texture_system;
 
+  bool texture_cache_supported;
+  unique_ptr<TextureCache> texture_cache;
+
+  bool texture_compression_supported;
+
   size_t add_image_slot(unique_ptr<ImageLoader> &&loader,
                         const ImageParams &params,
                         const bool builtin);
@@ -230,6 +239,10 @@ class ImageManager {
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, const int texture_limit);
+  bool cache_init_image(const Scene *scene, Image *img, TextureCacheImage &image);
+
+  bool use_texture_compression(const Scene *scene) const;
+  void device_compress_image(Device *device, Image *img, const size_t slot);
 
   void device_load_image(Device *device, Scene *scene, const size_t slot, Progress &progress);
   void device_free_image(Device *device, const size_t slot);
@@ -0,0 +1,173 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "scene/image_cache.h"
+#include "scene/colorspace.h"
+#include "scene/image.h"
+#include "scene/stats.h"
+
+#include "util/log.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+OIIO::TextureOpt::Wrap texture_cache_wrap(const uint extension)
+{
+  switch (extension) {
+    case EXTENSION_EXTEND:
+      return OIIO::TextureOpt::WrapClamp;
+    case EXTENSION_CLIP:
+      return OIIO::TextureOpt::WrapBlack;
+    case EXTENSION_MIRROR:
+      return OIIO::TextureOpt::WrapMirror;
+    case EXTENSION_REPEAT:
+    default:
+      return OIIO::TextureOpt::WrapPeriodic;
+  }
+}
+
+OIIO::TextureOpt::InterpMode texture_cache_interp(const uint interpolation)
+{
+  switch (interpolation) {
+    case INTERPOLATION_CLOSEST:
+      return OIIO::TextureOpt::InterpClosest;
+    case INTERPOLATION_CUBIC:
+      return OIIO::TextureOpt::InterpBicubic;
+    case INTERPOLATION_SMART:
+      return OIIO::TextureOpt::InterpSmartBicubic;
+    case INTERPOLATION_LINEAR:
+    default:
+      return OIIO::TextureOpt::InterpBilinear;
+  }
+}
+
+/* Called from the kernel, for images of type IMAGE_DATA_TYPE_CACHED. */
+float4 texture_cache_lookup(const TextureCacheImage *image,
+                            const float x,
+                            const float y,
+                            const float2 dx,
+                            const float2 dy)
+{
+  OIIO::TextureSystem *texture_system = (OIIO::TextureSystem *)image->texture_system;
+
+  OIIO::TextureOpt options;
+  options.swrap = options.twrap = texture_cache_wrap(image->extension);
+  options.interpmode = texture_cache_interp(image->interpolation);
+  /* Opaque alpha for images without alpha channel. */
+  options.fill = 1.0f;
+
+  /* Image rows are stored bottom to top in Cycles, top to bottom in files. */
+  float4 result;
+  if (!texture_system->texture((OIIO::TextureSystem::TextureHandle *)image->handle,
+                               nullptr,
+                               options,
+                               x,
+                               1.0f - y,
+                               dx.x,
+                               -dx.y,
+                               dy.x,
+                               -dy.y,
+                               4,
+                               &result.x))
+  {
+    /* Clear the error, so messages don't accumulate. */
+    texture_system->geterror();
+    return make_float4(
+        TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
+  }
+
+  if (image->processor) {
+    ColorSpaceManager::to_scene_linear((ColorSpaceProcessor *)image->processor, &result.x, 4);
+  }
+
+  return result;
+}
+
+template<typename T> T texture_cache_stat(OIIO::TextureSystem *texture_system, const char *name)
+{
+  /* Statistics are a mix of 32 and 64 bit integers, depending on the OpenImageIO version. */
+  long long value64 = 0;
+  if (texture_system->getattribute(name, OIIO::TypeDesc::INT64, &value64)) {
+    return T(value64);
+  }
+  int value32 = 0;
+  if (texture_system->getattribute(name, OIIO::TypeDesc::INT, &value32)) {
+    return T(value32);
+  }
+  float valuef = 0.0f;
+  if (texture_system->getattribute(name, OIIO::TypeDesc::FLOAT, &valuef)) {
+    return T(valuef);
+  }
+  return T(0);
+}
+
+}  // namespace
+
+TextureCache::TextureCache() : memory_limit_mb(0)
+{
+  /* Not shared with OSL, so the memory limit and statistics only cover SVM images. */
+  texture_system = OIIO::TextureSystem::create(false);
+  texture_system->attribute("automip", 1);
+  texture_system->attribute("autotile", 64);
+  texture_system->attribute("gray_to_rgb", 1);
+}
+
+TextureCache::~TextureCache()
+{
+  texture_system->invalidate_all(true);
+  OIIO::TextureSystem::destroy(texture_system);
+}
+
+void TextureCache::set_memory_limit(const size_t limit_mb)
+{
+  if (limit_mb != memory_limit_mb) {
+    memory_limit_mb = limit_mb;
+    texture_system->attribute("max_memory_MB", float(limit_mb));
+  }
+}
+
+bool TextureCache::init_image(ustring filepath,
+                              const ImageParams &params,
+                              const ImageMetaData &metadata,
+                              TextureCacheImage &image)
+{
+  OIIO::TextureSystem::TextureHandle *handle = texture_system->get_texture_handle(filepath);
+  if (!handle || !texture_system->good(handle)) {
+    VLOG_WARNING << "Texture cache failed to open " << filepath.string() << ": "
+                 << texture_system->geterror();
+    return false;
+  }
+
+  image.lookup = texture_cache_lookup;
+  image.texture_system = &*texture_system;
+  image.handle = handle;
+  /* Images compressed as sRGB are converted in the kernel, like other images. */
+  image.processor = (metadata.compress_as_srgb) ?
+                        nullptr :
+                        ColorSpaceManager::get_processor(metadata.colorspace);
+  image.interpolation = params.interpolation;
+  image.extension = params.extension;
+
+  return true;
+}
+
+void TextureCache::invalidate(ustring filepath)
+{
+  texture_system->invalidate(filepath);
+}
+
+void TextureCache::collect_statistics(TextureCacheStats &stats)
+{
+  OIIO::TextureSystem *ts = &*texture_system;
+  stats.enabled = true;
+  stats.memory_limit = memory_limit_mb * 1024 * 1024;
+  stats.memory_used = texture_cache_stat<size_t>(ts, "stat:cache_memory_used");
+  stats.bytes_read = texture_cache_stat<size_t>(ts, "stat:bytes_read");
+  stats.tile_lookups = texture_cache_stat<uint64_t>(ts, "stat:find_tile_calls");
+  stats.tile_misses = texture_cache_stat<uint64_t>(ts, "stat:find_tile_cache_misses");
+  stats.file_io_time = texture_cache_stat<double>(ts, "stat:fileio_time");
+}
+
+CCL_NAMESPACE_END
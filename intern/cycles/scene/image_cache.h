@@ -0,0 +1,53 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include <OpenImageIO/texture.h>
+
+#include "util/string.h"
+#include "util/texture.h"
+
+CCL_NAMESPACE_BEGIN
+
+class ImageMetaData;
+class ImageParams;
+class TextureCacheStats;
+
+/* Texture Cache
+ *
+ * Reads tiles and mipmap levels of image files on demand with the OpenImageIO texture system,
+ * instead of loading full resolution images into memory. Tiled and mipmapped files (.tx, tiled
+ * EXR) are read directly, other files are tiled and mipmapped in memory on first use.
+ *
+ * Only the CPU device can use it, since the kernel calls into the texture system. */
+class TextureCache {
+ public:
+  TextureCache();
+  ~TextureCache();
+
+  /* Budget for tiles held in memory, least recently used tiles are freed beyond it. */
+  void set_memory_limit(const size_t limit_mb);
+
+  /* Fill in the image sampled by the kernel, returns false if the file can't be read. */
+  bool init_image(ustring filepath,
+                  const ImageParams &params,
+                  const ImageMetaData &metadata,
+                  TextureCacheImage &image);
+
+  /* Free tiles and close the file of an image that is no longer used. */
+  void invalidate(ustring filepath);
+
+  void collect_statistics(TextureCacheStats &stats);
+
+ protected:
+#if OIIO_VERSION_MAJOR >= 3
+  std::shared_ptr<OIIO::TextureSystem> texture_system;
+#else
+  OIIO::TextureSystem *texture_system;
+#endif
+  size_t memory_limit_mb;
+};
+
+CCL_NAMESPACE_END
@@ -239,6 +239,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
     case IMAGE_DATA_TYPE_NANOVDB_FPN:
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
+    case IMAGE_DATA_TYPE_CACHED:
+    case IMAGE_DATA_TYPE_BC1:
+    case IMAGE_DATA_TYPE_BC3:
+    case IMAGE_DATA_TYPE_BC4:
     case IMAGE_DATA_NUM_TYPES:
       break;
   }
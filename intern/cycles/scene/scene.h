@@ -71,6 +71,11 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Read image tiles on demand through the texture cache, with a memory budget in MB. */
+  bool use_texture_cache;
+  int texture_cache_size;
+  /* Store byte images block compressed. */
+  bool use_texture_compression;
 
   bool background;
 
@@ -86,6 +91,9 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    use_texture_cache = false;
+    texture_cache_size = 4096;
+    use_texture_compression = false;
     background = true;
   }
 
@@ -98,7 +106,10 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             use_texture_cache == params.use_texture_cache &&
+             texture_cache_size == params.texture_cache_size &&
+             use_texture_compression == params.use_texture_compression);
   }
 
   int curve_subdivisions()
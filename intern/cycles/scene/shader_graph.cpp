@@ -5,6 +5,7 @@
 #include "scene/shader_graph.h"
 #include "scene/attribute.h"
 #include "scene/constant_fold.h"
+#include "scene/image.h"
 #include "scene/scene.h"
 #include "scene/shader.h"
 #include "scene/shader_nodes.h"
@@ -360,6 +361,9 @@ void ShaderGraph::simplify(Scene *scene)
     default_inputs(scene->shader_manager->use_osl());
     clean(scene);
     refine_bump_nodes();
+    if (scene->image_manager->use_texture_cache(scene)) {
+      refine_texture_differentials();
+    }
 
     simplified = true;
   }
@@ -967,6 +971,55 @@ void ShaderGraph::refine_bump_nodes()
   }
 }
 
+void ShaderGraph::refine_texture_differentials()
+{
+  /* Like for bump nodes, copy the sub-graph defining the texture coordinate of image nodes,
+   * shifted by the ray differentials. The texture cache uses the difference to select the
+   * mipmap level, instead of always reading the full resolution image. */
+
+  /* Displacement is evaluated on its own, and copied for bump mapping afterwards. */
+  ShaderNodeSet nodes_displacement;
+  ShaderInput *displacement_in = output()->input("Displacement");
+  if (displacement_in && displacement_in->link) {
+    find_dependencies(nodes_displacement, displacement_in);
+  }
+
+  /* No range based for loop because we modify the vector. */
+  for (int i = 0; i < nodes.size(); i++) {
+    ShaderNode *node = nodes[i];
+
+    ShaderInput *vector_in = node->input("Vector");
+    ShaderInput *vector_dx_in = node->input("VectorDx");
+    ShaderInput *vector_dy_in = node->input("VectorDy");
+
+    if (!vector_dx_in || !vector_dy_in || !vector_in || !vector_in->link ||
+        node->bump != SHADER_BUMP_NONE || nodes_displacement.count(node))
+    {
+      continue;
+    }
+
+    ShaderNodeSet nodes_vector;
+    ShaderNodeMap nodes_dx;
+    ShaderNodeMap nodes_dy;
+
+    find_dependencies(nodes_vector, vector_in);
+
+    copy_nodes(nodes_vector, nodes_dx);
+    copy_nodes(nodes_vector, nodes_dy);
+
+    for (const NodePair &pair : nodes_dx) {
+      pair.second->bump = SHADER_BUMP_DX;
+    }
+    for (const NodePair &pair : nodes_dy) {
+      pair.second->bump = SHADER_BUMP_DY;
+    }
+
+    ShaderOutput *out = vector_in->link;
+    connect(nodes_dx[out->parent]->output(out->name()), vector_dx_in);
+    connect(nodes_dy[out->parent]->output(out->name()), vector_dy_in);
+  }
+}
+
 void ShaderGraph::bump_from_displacement(bool use_object_space)
 {
   /* generate bump mapping automatically from displacement. bump mapping is
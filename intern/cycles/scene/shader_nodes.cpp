@@ -252,6 +252,9 @@ NODE_DEFINE(ImageTextureNode)
   SOCKET_BOOLEAN(animated, "Animated", false);
 
   SOCKET_IN_POINT(vector, "Vector", zero_float3(), SocketType::LINK_TEXTURE_UV);
+  /* Texture coordinates shifted by the ray differentials, for the texture cache. */
+  SOCKET_IN_POINT(vector_dx, "VectorDx", zero_float3(), SocketType::SVM_INTERNAL);
+  SOCKET_IN_POINT(vector_dy, "VectorDy", zero_float3(), SocketType::SVM_INTERNAL);
 
   SOCKET_OUT_COLOR(color, "Color");
   SOCKET_OUT_FLOAT(alpha, "Alpha");
@@ -395,6 +398,16 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
   }
 
   if (projection != NODE_IMAGE_PROJ_BOX) {
+    ShaderInput *vector_dx_in = input("VectorDx");
+    ShaderInput *vector_dy_in = input("VectorDy");
+    int vector_dx_offset = SVM_STACK_INVALID;
+    int vector_dy_offset = SVM_STACK_INVALID;
+    if (vector_dx_in->link && vector_dy_in->link) {
+      vector_dx_offset = tex_mapping.compile_begin(compiler, vector_dx_in);
+      vector_dy_offset = tex_mapping.compile_begin(compiler, vector_dy_in);
+      flags |= NODE_IMAGE_DIFFERENTIALS;
+    }
+
     /* If there only is one image (a very common case), we encode it as a negative value. */
     int num_nodes;
     if (handle.num_tiles() == 0) {
@@ -412,6 +425,10 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
                                              flags),
                       projection);
 
+    if (flags & NODE_IMAGE_DIFFERENTIALS) {
+      compiler.add_node(vector_dx_offset, vector_dy_offset, 0, 0);
+    }
+
     if (num_nodes > 0) {
       for (int i = 0; i < num_nodes; i++) {
         int4 node;
@@ -428,6 +445,11 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
         compiler.add_node(node.x, node.y, node.z, node.w);
       }
     }
+
+    if (flags & NODE_IMAGE_DIFFERENTIALS) {
+      tex_mapping.compile_end(compiler, vector_dy_in, vector_dy_offset);
+      tex_mapping.compile_end(compiler, vector_dx_in, vector_dx_offset);
+    }
   }
   else {
     assert(handle.num_svm_slots() == 1);
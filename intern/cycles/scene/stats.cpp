@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0 */
 
 #include "scene/stats.h"
+#include "scene/light.h"
 #include "scene/object.h"
 #include "util/algorithm.h"
 
@@ -39,6 +40,24 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+string json_string(const string &value)
+{
+  string result = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      result += string_printf("\\u%04x", c);
+    }
+    else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : size(0) {}
@@ -146,6 +165,24 @@ string NamedNestedSampleStats::full_report(const int indent_level, uint64_t tota
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf(
+      "{\"name\": %s, \"time\": %.3f, \"self_time\": %.3f, \"entries\": [",
+      json_string(name).c_str(),
+      sum_samples * 0.001,
+      self_samples * 0.001);
+
+  sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += (i == 0) ? "" : ", ";
+    result += entries[i].json_report();
+  }
+  return result + "]}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name,
@@ -201,6 +238,39 @@ string NamedSampleCountStats::full_report(const int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+
+  uint64_t total_hits = 0;
+  uint64_t total_samples = 0;
+  for (entry_map::const_reference entry : entries) {
+    total_hits += entry.second.hits;
+    total_samples += entry.second.samples;
+    sorted_entries.push_back(entry.second);
+  }
+  const double avg_samples_per_hit = (total_hits) ? ((double)total_samples) / total_hits : 0.0;
+
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  for (size_t i = 0; i < sorted_entries.size(); i++) {
+    const NamedSampleCountPair &entry = sorted_entries[i];
+    const double relative = (entry.hits) ?
+                                ((double)entry.samples) / (entry.hits * avg_samples_per_hit) :
+                                0.0;
+    result += string_printf(
+        "%s{\"name\": %s, \"time\": %.3f, \"hits\": %llu, \"relative_cost\": %.3f}",
+        (i == 0) ? "" : ", ",
+        json_string(entry.name.string()).c_str(),
+        entry.samples * 0.001,
+        (unsigned long long)entry.hits,
+        relative);
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats() = default;
@@ -213,6 +283,43 @@ string MeshStats::full_report(const int indent_level)
   return result;
 }
 
+/* Texture cache statistics. */
+
+TextureCacheStats::TextureCacheStats()
+    : enabled(false),
+      num_images(0),
+      memory_limit(0),
+      memory_used(0),
+      bytes_read(0),
+      tile_lookups(0),
+      tile_misses(0),
+      file_io_time(0.0)
+{
+}
+
+string TextureCacheStats::full_report(const int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  const double hit_rate = (tile_lookups) ? 1.0 - double(tile_misses) / double(tile_lookups) :
+                                           0.0;
+  string result;
+  result += string_printf("%sImages: %d\n", indent.c_str(), num_images);
+  result += string_printf("%sMemory: %s of %s\n",
+                          indent.c_str(),
+                          string_human_readable_size(memory_used).c_str(),
+                          string_human_readable_size(memory_limit).c_str());
+  result += string_printf("%sTile lookups: %s, misses: %s (%.2f%% hits)\n",
+                          indent.c_str(),
+                          string_human_readable_number(tile_lookups).c_str(),
+                          string_human_readable_number(tile_misses).c_str(),
+                          hit_rate * 100.0);
+  result += string_printf("%sRead from disk: %s in %.2fs\n",
+                          indent.c_str(),
+                          string_human_readable_size(bytes_read).c_str(),
+                          file_io_time);
+  return result;
+}
+
 /* Image statistics. */
 
 ImageStats::ImageStats() = default;
@@ -222,6 +329,9 @@ string ImageStats::full_report(const int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result;
   result += indent + "Textures:\n" + textures.full_report(indent_level + 1);
+  if (texture_cache.enabled) {
+    result += indent + "Texture Cache:\n" + texture_cache.full_report(indent_level + 1);
+  }
   return result;
 }
 
@@ -285,6 +395,21 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
       objects.add(object->name, samples, hits);
     }
   }
+
+  /* The kernel indexes lights by their position among enabled lights, same as LightManager. */
+  lights.entries.clear();
+  int light_index = 0;
+  for (Light *light : scene->lights) {
+    if (light->get_is_portal() || !light->get_is_enabled()) {
+      continue;
+    }
+    uint64_t samples;
+    uint64_t hits;
+    if (prof.get_light(light_index, samples, hits)) {
+      lights.add(light->name, samples, hits);
+    }
+    light_index++;
+  }
 }
 
 string RenderStats::full_report()
@@ -296,6 +421,7 @@ string RenderStats::full_report()
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
+    result += "Light statistics:\n" + lights.full_report(1);
   }
   else {
     result += "Profiling information not available (only works with CPU rendering)";
@@ -303,6 +429,20 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  if (!has_profiling) {
+    return "{\"profiling\": false}";
+  }
+
+  string result = "{\"profiling\": true";
+  result += ", \"kernel\": " + kernel.json_report();
+  result += ", \"shaders\": " + shaders.json_report();
+  result += ", \"objects\": " + objects.json_report();
+  result += ", \"lights\": " + lights.json_report();
+  return result + "}";
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
 string UpdateTimeStats::full_report(const int indent_level)
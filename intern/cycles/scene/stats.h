@@ -99,6 +99,7 @@ class NamedNestedSampleStats {
   void update_sum();
 
   string full_report(const int indent_level = 0, const uint64_t total_samples = 0);
+  string json_report();
 
   string name;
 
@@ -127,6 +128,7 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(const int indent_level = 0);
+  string json_report();
   void add(const ustring &name, const uint64_t samples, const uint64_t hits);
 
   using entry_map = unordered_map<ustring, NamedSampleCountPair>;
@@ -148,6 +150,24 @@ class MeshStats {
   NamedSizeStats geometry;
 };
 
+/* Statistics of the texture cache, which reads image tiles on demand. */
+class TextureCacheStats {
+ public:
+  TextureCacheStats();
+
+  /* Generate full human-readable report. */
+  string full_report(const int indent_level = 0);
+
+  bool enabled;
+  int num_images;
+  size_t memory_limit;
+  size_t memory_used;
+  size_t bytes_read;
+  uint64_t tile_lookups;
+  uint64_t tile_misses;
+  double file_io_time;
+};
+
 /* Statistics about images held in memory. */
 class ImageStats {
  public:
@@ -157,6 +177,7 @@ class ImageStats {
   string full_report(const int indent_level = 0);
 
   NamedSizeStats textures;
+  TextureCacheStats texture_cache;
 };
 
 /* Render process statistics. */
@@ -167,6 +188,10 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return render time attributed to kernels, shaders, objects and lights as JSON, for scripts
+   * that look for expensive parts of a scene. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -177,6 +202,7 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+  NamedSampleCountStats lights;
 };
 
 class UpdateTimeStats {
@@ -422,7 +422,7 @@ RenderWork Session::run_update_for_next_iteration()
     }
 
     if (update_scene(width, height)) {
-      profiler.reset(scene->shaders.size(), scene->objects.size());
+      profiler.reset(scene->shaders.size(), scene->objects.size(), scene->lights.size());
     }
 
     /* Unlock scene mutex before loading denoiser kernels, since that may attempt to activate
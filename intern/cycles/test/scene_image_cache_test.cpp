@@ -0,0 +1,119 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/imageio.h>
+
+#include "scene/image.h"
+#include "scene/image_cache.h"
+
+#include "util/path.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int image_size = 16;
+constexpr int tile_size = 8;
+
+/* Color of the tile containing the pixel, tiles are numbered top to bottom like in the file. */
+float4 image_cache_test_color(const int x, const int y)
+{
+  const int tile = (y / tile_size) * (image_size / tile_size) + (x / tile_size);
+  return make_float4(0.25f * float(tile), 0.5f, 1.0f - 0.25f * float(tile), 1.0f);
+}
+
+/* Write a small tiled EXR with a different color for every tile. */
+bool image_cache_test_write_exr(const string &filepath)
+{
+  auto out = OIIO::ImageOutput::create(filepath);
+  if (!out) {
+    return false;
+  }
+
+  OIIO::ImageSpec spec(image_size, image_size, 4, OIIO::TypeDesc::FLOAT);
+  spec.tile_width = tile_size;
+  spec.tile_height = tile_size;
+  if (!out->open(filepath, spec)) {
+    return false;
+  }
+
+  vector<float4> pixels(image_size * image_size);
+  for (int y = 0; y < image_size; y++) {
+    for (int x = 0; x < image_size; x++) {
+      pixels[y * image_size + x] = image_cache_test_color(x, y);
+    }
+  }
+
+  const bool ok = out->write_image(OIIO::TypeDesc::FLOAT, pixels.data(), sizeof(float4));
+  out->close();
+  return ok;
+}
+
+class TextureCacheTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    filepath = path_join(OIIO::Filesystem::temp_directory_path(),
+                         OIIO::Filesystem::unique_path("cycles_texture_cache_%%%%%%%%.exr"));
+    ASSERT_TRUE(image_cache_test_write_exr(filepath));
+
+    params.interpolation = INTERPOLATION_CLOSEST;
+    params.extension = EXTENSION_EXTEND;
+    metadata.colorspace = u_colorspace_raw;
+    metadata.compress_as_srgb = false;
+  }
+
+  void TearDown() override
+  {
+    path_remove(filepath);
+  }
+
+  string filepath;
+  ImageParams params;
+  ImageMetaData metadata;
+};
+
+}  // namespace
+
+TEST_F(TextureCacheTest, init_image_missing_file)
+{
+  TextureCache cache;
+  TextureCacheImage image;
+  EXPECT_FALSE(cache.init_image(ustring(filepath + ".missing"), params, metadata, image));
+}
+
+TEST_F(TextureCacheTest, lookup_tiles)
+{
+  TextureCache cache;
+  cache.set_memory_limit(16);
+
+  TextureCacheImage image;
+  ASSERT_TRUE(cache.init_image(ustring(filepath), params, metadata, image));
+  EXPECT_EQ(image.interpolation, INTERPOLATION_CLOSEST);
+  EXPECT_EQ(image.extension, EXTENSION_EXTEND);
+
+  /* Sample the center of every tile at the finest level. Texture coordinates go bottom to top,
+   * while file rows go top to bottom. */
+  const float2 zero = make_float2(0.0f, 0.0f);
+  for (int tile_y = 0; tile_y < image_size / tile_size; tile_y++) {
+    for (int tile_x = 0; tile_x < image_size / tile_size; tile_x++) {
+      const int x = tile_x * tile_size + tile_size / 2;
+      const int y = tile_y * tile_size + tile_size / 2;
+      const float u = (float(x) + 0.5f) / float(image_size);
+      const float v = 1.0f - (float(y) + 0.5f) / float(image_size);
+
+      const float4 result = image.lookup(&image, u, v, zero, zero);
+      const float4 expected = image_cache_test_color(x, y);
+      EXPECT_NEAR(result.x, expected.x, 1e-5f);
+      EXPECT_NEAR(result.y, expected.y, 1e-5f);
+      EXPECT_NEAR(result.z, expected.z, 1e-5f);
+      EXPECT_NEAR(result.w, expected.w, 1e-5f);
+    }
+  }
+}
+
+CCL_NAMESPACE_END
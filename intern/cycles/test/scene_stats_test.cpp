@@ -0,0 +1,72 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "scene/stats.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(RenderStats, json_report_no_profiling)
+{
+  RenderStats stats;
+  EXPECT_EQ(stats.json_report(), "{\"profiling\": false}");
+}
+
+TEST(RenderStats, json_report_empty)
+{
+  RenderStats stats;
+  stats.has_profiling = true;
+  EXPECT_EQ(stats.json_report(),
+            "{\"profiling\": true, "
+            "\"kernel\": {\"name\": \"\", \"time\": 0.000, \"self_time\": 0.000, \"entries\": []}, "
+            "\"shaders\": [], \"objects\": [], \"lights\": []}");
+}
+
+TEST(RenderStats, json_report_lights)
+{
+  RenderStats stats;
+  stats.has_profiling = true;
+  stats.lights.add(ustring("Lamp"), 1000, 2);
+  stats.lights.add(ustring("Sun"), 3000, 2);
+  EXPECT_EQ(stats.json_report(),
+            "{\"profiling\": true, "
+            "\"kernel\": {\"name\": \"\", \"time\": 0.000, \"self_time\": 0.000, \"entries\": []}, "
+            "\"shaders\": [], \"objects\": [], \"lights\": ["
+            "{\"name\": \"Sun\", \"time\": 3.000, \"hits\": 2, \"relative_cost\": 1.500}, "
+            "{\"name\": \"Lamp\", \"time\": 1.000, \"hits\": 2, \"relative_cost\": 0.500}]}");
+}
+
+TEST(NamedSampleCountStats, json_report_no_hits)
+{
+  NamedSampleCountStats stats;
+  EXPECT_EQ(stats.json_report(), "[]");
+
+  stats.add(ustring("Unused"), 0, 0);
+  EXPECT_EQ(stats.json_report(),
+            "[{\"name\": \"Unused\", \"time\": 0.000, \"hits\": 0, \"relative_cost\": 0.000}]");
+}
+
+TEST(NamedSampleCountStats, json_report_escape)
+{
+  NamedSampleCountStats stats;
+  stats.add(ustring("Quote\" Backslash\\ Newline\n"), 1000, 1);
+  EXPECT_EQ(stats.json_report(),
+            "[{\"name\": \"Quote\\\" Backslash\\\\ Newline\\u000a\", \"time\": 1.000, "
+            "\"hits\": 1, \"relative_cost\": 1.000}]");
+}
+
+TEST(NamedNestedSampleStats, json_report)
+{
+  NamedNestedSampleStats stats("Total\t", 0);
+  stats.add_entry("Intersect", 1000);
+  stats.add_entry("Shade", 2000).add_entry("Surface", 500);
+  EXPECT_EQ(stats.json_report(),
+            "{\"name\": \"Total\\u0009\", \"time\": 3.500, \"self_time\": 0.000, \"entries\": ["
+            "{\"name\": \"Shade\", \"time\": 2.500, \"self_time\": 2.000, \"entries\": ["
+            "{\"name\": \"Surface\", \"time\": 0.500, \"self_time\": 0.500, \"entries\": []}]}, "
+            "{\"name\": \"Intersect\", \"time\": 1.000, \"self_time\": 1.000, \"entries\": []}]}");
+}
+
+CCL_NAMESPACE_END
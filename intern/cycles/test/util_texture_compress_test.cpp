@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "util/texture_compress.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+static vector<uchar4> test_image_rgba(const int width, const int height)
+{
+  vector<uchar4> pixels(width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      /* Smooth gradients, like most texture images within a 4x4 block. */
+      pixels[y * width + x] = make_uchar4(uchar(x * 4), uchar(y * 6), 128, uchar(255 - x * 3));
+    }
+  }
+  return pixels;
+}
+
+TEST(util, util_texture_compress_bc1)
+{
+  /* Size not a multiple of the block size. */
+  const int width = 61;
+  const int height = 30;
+  const vector<uchar4> pixels = test_image_rgba(width, height);
+
+  vector<TextureBlockBC1> blocks(texture_compress_num_blocks(width, height));
+  texture_compress_bc1(pixels.data(), width, height, blocks.data());
+  EXPECT_EQ(blocks.size(), 16 * 8);
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const float3 color = texture_block_bc1_decode(blocks[texture_block_index(x, y, width)],
+                                                    texture_block_pixel(x, y));
+      const uchar4 expected = pixels[y * width + x];
+      EXPECT_NEAR(color.x, expected.x / 255.0f, 0.05f);
+      EXPECT_NEAR(color.y, expected.y / 255.0f, 0.05f);
+      EXPECT_NEAR(color.z, expected.z / 255.0f, 0.05f);
+    }
+  }
+}
+
+TEST(util, util_texture_compress_bc3)
+{
+  const int width = 32;
+  const int height = 32;
+  const vector<uchar4> pixels = test_image_rgba(width, height);
+
+  vector<TextureBlockBC3> blocks(texture_compress_num_blocks(width, height));
+  texture_compress_bc3(pixels.data(), width, height, blocks.data());
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const float4 color = texture_block_bc3_decode(blocks[texture_block_index(x, y, width)],
+                                                    texture_block_pixel(x, y));
+      const uchar4 expected = pixels[y * width + x];
+      EXPECT_NEAR(color.x, expected.x / 255.0f, 0.05f);
+      EXPECT_NEAR(color.w, expected.w / 255.0f, 0.01f);
+    }
+  }
+}
+
+TEST(util, util_texture_compress_bc4)
+{
+  const int width = 4;
+  const int height = 4;
+
+  /* Constant and two-valued blocks are exact. */
+  uchar constant[16];
+  uchar two_values[16];
+  for (int i = 0; i < 16; i++) {
+    constant[i] = 77;
+    two_values[i] = (i % 3) ? 10 : 240;
+  }
+
+  TextureBlockBC4 block;
+  texture_compress_bc4(constant, width, height, &block);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_FLOAT_EQ(texture_block_bc4_decode(block, i), 77.0f / 255.0f);
+  }
+
+  texture_compress_bc4(two_values, width, height, &block);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_FLOAT_EQ(texture_block_bc4_decode(block, i), two_values[i] / 255.0f);
+  }
+}
+
+CCL_NAMESPACE_END
@@ -32,6 +32,7 @@ void DebugFlags::CPU::reset()
 #undef CHECK_CPU_FLAGS
 
   bvh_layout = BVH_LAYOUT_AUTO;
+  ray_packets = (getenv("CYCLES_CPU_RAY_PACKETS") != nullptr);
 }
 
 DebugFlags::CUDA::CUDA()
@@ -45,6 +45,10 @@ class DebugFlags {
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout = BVH_LAYOUT_AUTO;
+
+    /* Trace camera and shadow rays of neighboring pixels together as Embree ray packets,
+     * instead of one path at a time. */
+    bool ray_packets = false;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
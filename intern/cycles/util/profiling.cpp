@@ -27,6 +27,7 @@ void Profiler::run()
       const uint32_t cur_event = state->event;
       const int32_t cur_shader = state->shader;
       const int32_t cur_object = state->object;
+      const int32_t cur_light = state->light;
 
       /* The state reads/writes should be atomic, but just to be sure
        * check the values for validity anyways. */
@@ -41,6 +42,10 @@ void Profiler::run()
       if (cur_object >= 0 && cur_object < object_samples.size()) {
         object_samples[cur_object]++;
       }
+
+      if (cur_light >= 0 && cur_light < light_samples.size()) {
+        light_samples[cur_light]++;
+      }
     }
     lock.unlock();
 
@@ -53,7 +58,7 @@ void Profiler::run()
   }
 }
 
-void Profiler::reset(const int num_shaders, const int num_objects)
+void Profiler::reset(const int num_shaders, const int num_objects, const int num_lights)
 {
   const bool running = (worker != nullptr);
   if (running) {
@@ -63,10 +68,12 @@ void Profiler::reset(const int num_shaders, const int num_objects)
   /* Resize and clear the accumulation vectors. */
   shader_hits.assign(num_shaders, 0);
   object_hits.assign(num_objects, 0);
+  light_hits.assign(num_lights, 0);
 
   event_samples.assign(PROFILING_NUM_EVENTS, 0);
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
+  light_samples.assign(num_lights, 0);
 
   if (running) {
     start();
@@ -101,11 +108,13 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->light_hits.assign(light_hits.size(), 0);
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
   state->shader = -1;
   state->object = -1;
+  state->light = -1;
   state->active = true;
 }
 
@@ -127,6 +136,11 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  assert(light_hits.size() == state->light_hits.size());
+  for (int i = 0; i < light_hits.size(); i++) {
+    light_hits[i] += state->light_hits[i];
+  }
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -157,6 +171,17 @@ bool Profiler::get_object(const int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+bool Profiler::get_light(const int light, uint64_t &samples, uint64_t &hits)
+{
+  assert(worker == nullptr);
+  if (light_samples[light] == 0) {
+    return false;
+  }
+  samples = light_samples[light];
+  hits = light_hits[light];
+  return true;
+}
+
 bool Profiler::active() const
 {
   return (worker != nullptr);
@@ -62,10 +62,12 @@ struct ProfilingState {
   volatile uint32_t event = PROFILING_UNKNOWN;
   volatile int32_t shader = -1;
   volatile int32_t object = -1;
+  volatile int32_t light = -1;
   volatile bool active = false;
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+  vector<uint64_t> light_hits;
 };
 
 class Profiler {
@@ -73,7 +75,7 @@ class Profiler {
   Profiler();
   ~Profiler();
 
-  void reset(const int num_shaders, const int num_objects);
+  void reset(const int num_shaders, const int num_objects, const int num_lights);
 
   void start();
   void stop();
@@ -84,6 +86,7 @@ class Profiler {
   uint64_t get_event(ProfilingEvent event);
   bool get_shader(const int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(const int object, uint64_t &samples, uint64_t &hits);
+  bool get_light(const int light, uint64_t &samples, uint64_t &hits);
 
   bool active() const;
 
@@ -96,13 +99,15 @@ class Profiler {
   vector<uint64_t> event_samples;
   vector<uint64_t> shader_samples;
   vector<uint64_t> object_samples;
+  vector<uint64_t> light_samples;
 
-  /* Tracks the total amounts every object/shader was hit.
+  /* Tracks the total amounts every object/shader/light was hit.
    * Used to evaluate relative cost, written by the render thread.
-   * Indexed by the shader and object IDs that the kernel also uses
-   * to index __object_flag and __shaders. */
+   * Indexed by the shader, object and light IDs that the kernel also uses
+   * to index __object_flag, __shaders and __lights. */
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+  vector<uint64_t> light_hits;
 
   volatile bool do_stop_worker;
   unique_ptr<thread> worker;
@@ -145,6 +150,7 @@ class ProfilingWithShaderHelper : public ProfilingHelper {
   {
     state->object = -1;
     state->shader = -1;
+    state->light = -1;
   }
 
   void set_shader(const int object, const int shader)
@@ -164,6 +170,16 @@ class ProfilingWithShaderHelper : public ProfilingHelper {
       }
     }
   }
+
+  void set_light(const int light)
+  {
+    if (state->active && light >= 0) {
+      state->light = light;
+
+      assert(light < state->light_hits.size());
+      state->light_hits[light]++;
+    }
+  }
 };
 
 CCL_NAMESPACE_END
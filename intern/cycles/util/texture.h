@@ -41,6 +41,10 @@ enum ImageDataType {
   IMAGE_DATA_TYPE_NANOVDB_FLOAT3 = 9,
   IMAGE_DATA_TYPE_NANOVDB_FPN = 10,
   IMAGE_DATA_TYPE_NANOVDB_FP16 = 11,
+  IMAGE_DATA_TYPE_CACHED = 12,
+  IMAGE_DATA_TYPE_BC1 = 13,
+  IMAGE_DATA_TYPE_BC3 = 14,
+  IMAGE_DATA_TYPE_BC4 = 15,
 
   IMAGE_DATA_NUM_TYPES
 };
@@ -73,6 +77,12 @@ enum ExtensionType {
   EXTENSION_NUM_TYPES,
 };
 
+/* Block compressed images store blocks of 4x4 pixels, see util/texture_compress.h. */
+ccl_device_inline bool image_data_type_is_block_compressed(const uint type)
+{
+  return type == IMAGE_DATA_TYPE_BC1 || type == IMAGE_DATA_TYPE_BC3 || type == IMAGE_DATA_TYPE_BC4;
+}
+
 struct TextureInfo {
   /* Pointer, offset or texture depending on device. */
   uint64_t data = 0;
@@ -90,4 +100,21 @@ struct TextureInfo {
   Transform transform_3d = transform_zero();
 };
 
+#ifndef __KERNEL_GPU__
+/* Image that is read on demand through the texture cache, only supported on the CPU. The data of
+ * textures with type IMAGE_DATA_TYPE_CACHED points to this. */
+struct TextureCacheImage {
+  /* Filtered lookup, with the coordinate derivatives selecting the mipmap level. */
+  float4 (*lookup)(const TextureCacheImage *image, float x, float y, float2 dx, float2 dy);
+
+  /* Opaque texture system, image handle and color space processor of the texture cache. */
+  void *texture_system;
+  void *handle;
+  void *processor;
+
+  uint interpolation;
+  uint extension;
+};
+#endif
+
 CCL_NAMESPACE_END
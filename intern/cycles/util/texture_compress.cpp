@@ -0,0 +1,271 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "util/texture_compress.h"
+#include "util/algorithm.h"
+#include "util/math.h"
+#include "util/tbb.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Pixels of a 4x4 block, repeating the last row and column at the image border. */
+template<typename T>
+void texture_block_gather(const T *pixels,
+                          const int width,
+                          const int height,
+                          const int block_x,
+                          const int block_y,
+                          T block[16])
+{
+  for (int y = 0; y < 4; y++) {
+    const int py = min(block_y * 4 + y, height - 1);
+    for (int x = 0; x < 4; x++) {
+      const int px = min(block_x * 4 + x, width - 1);
+      block[y * 4 + x] = pixels[size_t(py) * width + px];
+    }
+  }
+}
+
+uint16_t texture_block_quantize_565(const float3 color)
+{
+  const int r = clamp(int(color.x * 31.0f + 0.5f), 0, 31);
+  const int g = clamp(int(color.y * 63.0f + 0.5f), 0, 63);
+  const int b = clamp(int(color.z * 31.0f + 0.5f), 0, 31);
+  return uint16_t((r << 11) | (g << 5) | b);
+}
+
+/* Choose the nearest palette entry for every pixel, returns the squared error. */
+float texture_block_bc1_fit_indices(const float3 colors[16], TextureBlockBC1 &block)
+{
+  float3 palette[4];
+  for (int i = 0; i < 4; i++) {
+    block.indices = uint32_t(i);
+    palette[i] = texture_block_bc1_decode(block, 0);
+  }
+
+  block.indices = 0;
+  float error = 0.0f;
+  for (int i = 0; i < 16; i++) {
+    int best_index = 0;
+    float best_distance = FLT_MAX;
+    for (int j = 0; j < 4; j++) {
+      const float distance = len_squared(colors[i] - palette[j]);
+      if (distance < best_distance) {
+        best_distance = distance;
+        best_index = j;
+      }
+    }
+    block.indices |= uint32_t(best_index) << (2 * i);
+    error += best_distance;
+  }
+  return error;
+}
+
+TextureBlockBC1 texture_block_bc1_from_endpoints(const float3 colors[16],
+                                                 const float3 endpoint0,
+                                                 const float3 endpoint1,
+                                                 float &r_error)
+{
+  TextureBlockBC1 block;
+  block.color0 = texture_block_quantize_565(endpoint0);
+  block.color1 = texture_block_quantize_565(endpoint1);
+  if (block.color0 < block.color1) {
+    swap(block.color0, block.color1);
+  }
+  r_error = texture_block_bc1_fit_indices(colors, block);
+  return block;
+}
+
+TextureBlockBC1 texture_block_bc1_encode(const uchar4 pixels[16])
+{
+  float3 colors[16];
+  float3 mean = zero_float3();
+  for (int i = 0; i < 16; i++) {
+    colors[i] = make_float3(pixels[i].x, pixels[i].y, pixels[i].z) * (1.0f / 255.0f);
+    mean += colors[i];
+  }
+  mean *= 1.0f / 16.0f;
+
+  /* Principal axis of the colors, by power iteration on the covariance matrix. */
+  float cov[6] = {0.0f};
+  float3 color_min = colors[0];
+  float3 color_max = colors[0];
+  for (int i = 0; i < 16; i++) {
+    const float3 d = colors[i] - mean;
+    cov[0] += d.x * d.x;
+    cov[1] += d.x * d.y;
+    cov[2] += d.x * d.z;
+    cov[3] += d.y * d.y;
+    cov[4] += d.y * d.z;
+    cov[5] += d.z * d.z;
+    color_min = min(color_min, colors[i]);
+    color_max = max(color_max, colors[i]);
+  }
+
+  float3 axis = color_max - color_min;
+  for (int iteration = 0; iteration < 4; iteration++) {
+    axis = make_float3(cov[0] * axis.x + cov[1] * axis.y + cov[2] * axis.z,
+                       cov[1] * axis.x + cov[3] * axis.y + cov[4] * axis.z,
+                       cov[2] * axis.x + cov[4] * axis.y + cov[5] * axis.z);
+    const float axis_length = len(axis);
+    if (axis_length < 1e-8f) {
+      break;
+    }
+    axis /= axis_length;
+  }
+
+  float error;
+  if (len_squared(axis) < 1e-16f) {
+    /* Single color block. */
+    return texture_block_bc1_from_endpoints(colors, mean, mean, error);
+  }
+
+  float t_min = FLT_MAX;
+  float t_max = -FLT_MAX;
+  for (int i = 0; i < 16; i++) {
+    const float t = dot(colors[i] - mean, axis);
+    t_min = min(t_min, t);
+    t_max = max(t_max, t);
+  }
+  /* Inset the endpoints, so the interpolated colors better cover the range. */
+  const float inset = (t_max - t_min) * (1.0f / 16.0f);
+  TextureBlockBC1 block = texture_block_bc1_from_endpoints(
+      colors, mean + axis * (t_max - inset), mean + axis * (t_min + inset), error);
+
+  /* Least squares fit of the endpoints for the chosen indices. */
+  float aa = 0.0f;
+  float ab = 0.0f;
+  float bb = 0.0f;
+  float3 ap = zero_float3();
+  float3 bp = zero_float3();
+  for (int i = 0; i < 16; i++) {
+    const uint index = (block.indices >> (2 * i)) & 3;
+    const float t = (index == 0) ? 0.0f :
+                    (index == 1) ? 1.0f :
+                    (index == 2) ? 1.0f / 3.0f :
+                                   2.0f / 3.0f;
+    aa += (1.0f - t) * (1.0f - t);
+    ab += (1.0f - t) * t;
+    bb += t * t;
+    ap += (1.0f - t) * colors[i];
+    bp += t * colors[i];
+  }
+  const float det = aa * bb - ab * ab;
+  if (fabsf(det) > 1e-8f) {
+    const float inv_det = 1.0f / det;
+    const float3 endpoint0 = (ap * bb - bp * ab) * inv_det;
+    const float3 endpoint1 = (bp * aa - ap * ab) * inv_det;
+    float refined_error;
+    const TextureBlockBC1 refined = texture_block_bc1_from_endpoints(
+        colors, endpoint0, endpoint1, refined_error);
+    if (refined_error < error) {
+      block = refined;
+    }
+  }
+
+  return block;
+}
+
+TextureBlockBC4 texture_block_bc4_encode(const uchar values[16])
+{
+  int value_min = values[0];
+  int value_max = values[0];
+  for (int i = 1; i < 16; i++) {
+    value_min = min(value_min, int(values[i]));
+    value_max = max(value_max, int(values[i]));
+  }
+
+  /* value0 > value1 selects the palette with six interpolated values. With equal values all
+   * indices are zero. */
+  TextureBlockBC4 block = {};
+  block.value0 = uint8_t(value_max);
+  block.value1 = uint8_t(value_min);
+
+  float palette[8];
+  for (int i = 0; i < 8; i++) {
+    block.indices[0] = uint8_t(i);
+    palette[i] = texture_block_bc4_decode(block, 0);
+  }
+
+  uint64_t bits = 0;
+  if (value_max != value_min) {
+    for (int i = 0; i < 16; i++) {
+      const float value = float(values[i]) * (1.0f / 255.0f);
+      int best_index = 0;
+      float best_distance = FLT_MAX;
+      for (int j = 0; j < 8; j++) {
+        const float distance = fabsf(value - palette[j]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          best_index = j;
+        }
+      }
+      bits |= uint64_t(best_index) << (3 * i);
+    }
+  }
+
+  for (int i = 0; i < 6; i++) {
+    block.indices[i] = uint8_t(bits >> (8 * i));
+  }
+  return block;
+}
+
+/* Encode rows of blocks in parallel. */
+template<typename PixelT, typename BlockT, typename EncodeFunc>
+void texture_compress(const PixelT *pixels,
+                      const int width,
+                      const int height,
+                      BlockT *blocks,
+                      const EncodeFunc &encode)
+{
+  const int blocks_x = (width + 3) >> 2;
+  const int blocks_y = (height + 3) >> 2;
+
+  parallel_for(0, blocks_y, [&](const int block_y) {
+    for (int block_x = 0; block_x < blocks_x; block_x++) {
+      PixelT block_pixels[16];
+      texture_block_gather(pixels, width, height, block_x, block_y, block_pixels);
+      blocks[size_t(block_y) * blocks_x + block_x] = encode(block_pixels);
+    }
+  });
+}
+
+}  // namespace
+
+void texture_compress_bc1(const uchar4 *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC1 *blocks)
+{
+  texture_compress(pixels, width, height, blocks, texture_block_bc1_encode);
+}
+
+void texture_compress_bc3(const uchar4 *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC3 *blocks)
+{
+  texture_compress(pixels, width, height, blocks, [](const uchar4 block_pixels[16]) {
+    uchar alpha[16];
+    for (int i = 0; i < 16; i++) {
+      alpha[i] = block_pixels[i].w;
+    }
+    TextureBlockBC3 block;
+    block.alpha = texture_block_bc4_encode(alpha);
+    block.color = texture_block_bc1_encode(block_pixels);
+    return block;
+  });
+}
+
+void texture_compress_bc4(const uchar *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC4 *blocks)
+{
+  texture_compress(pixels, width, height, blocks, texture_block_bc4_encode);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,135 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include "util/math.h"
+#include "util/types.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Block Compressed Textures
+ *
+ * Byte images split into blocks of 4x4 pixels, following the BC1, BC3 and BC4 layouts. A block
+ * stores two endpoints and a small index per pixel into a palette interpolated between them.
+ * Compared to uncompressed pixels this is 1/8 of the memory for RGB images (BC1, RGBA bytes),
+ * 1/4 for RGBA images (BC3) and 1/2 for single channel images (BC4).
+ *
+ * Pixels in a block are numbered row by row. Images with a size that is not a multiple of four
+ * are padded by repeating the last row and column. */
+
+struct TextureBlockBC1 {
+  /* RGB 5:6:5 endpoints, color0 > color1 so the four color palette is used. */
+  uint16_t color0;
+  uint16_t color1;
+  /* 2 bits per pixel. */
+  uint32_t indices;
+};
+
+struct TextureBlockBC4 {
+  uint8_t value0;
+  uint8_t value1;
+  /* 3 bits per pixel. */
+  uint8_t indices[6];
+};
+
+struct TextureBlockBC3 {
+  TextureBlockBC4 alpha;
+  TextureBlockBC1 color;
+};
+
+ccl_device_inline int texture_block_index(const int x, const int y, const int width)
+{
+  return (y >> 2) * ((width + 3) >> 2) + (x >> 2);
+}
+
+ccl_device_inline int texture_block_pixel(const int x, const int y)
+{
+  return ((y & 3) << 2) | (x & 3);
+}
+
+ccl_device_inline float3 texture_block_color_565(const uint16_t color)
+{
+  return make_float3(float((color >> 11) & 31) * (1.0f / 31.0f),
+                     float((color >> 5) & 63) * (1.0f / 63.0f),
+                     float(color & 31) * (1.0f / 31.0f));
+}
+
+ccl_device_inline float3 texture_block_bc1_decode(const TextureBlockBC1 &block, const int pixel)
+{
+  const uint index = (block.indices >> (2 * pixel)) & 3;
+  const float3 color0 = texture_block_color_565(block.color0);
+  const float3 color1 = texture_block_color_565(block.color1);
+
+  if (index == 0) {
+    return color0;
+  }
+  if (index == 1) {
+    return color1;
+  }
+  return color0 + (color1 - color0) * ((index == 2) ? (1.0f / 3.0f) : (2.0f / 3.0f));
+}
+
+ccl_device_inline float texture_block_bc4_decode(const TextureBlockBC4 &block, const int pixel)
+{
+  const int bit = 3 * pixel;
+  /* Indices may straddle two bytes. */
+  const int byte = bit >> 3;
+  uint bits = block.indices[byte];
+  if (byte < 5) {
+    bits |= uint(block.indices[byte + 1]) << 8;
+  }
+  const uint index = (bits >> (bit & 7)) & 7;
+
+  const float value0 = float(block.value0) * (1.0f / 255.0f);
+  const float value1 = float(block.value1) * (1.0f / 255.0f);
+
+  if (index == 0) {
+    return value0;
+  }
+  if (index == 1) {
+    return value1;
+  }
+  if (block.value0 > block.value1) {
+    /* Six interpolated values. */
+    return (float(8 - index) * value0 + float(index - 1) * value1) * (1.0f / 7.0f);
+  }
+  /* Four interpolated values, and exact zero and one. */
+  if (index == 6) {
+    return 0.0f;
+  }
+  if (index == 7) {
+    return 1.0f;
+  }
+  return (float(6 - index) * value0 + float(index - 1) * value1) * (1.0f / 5.0f);
+}
+
+ccl_device_inline float4 texture_block_bc3_decode(const TextureBlockBC3 &block, const int pixel)
+{
+  const float3 color = texture_block_bc1_decode(block.color, pixel);
+  return make_float4(color.x, color.y, color.z, texture_block_bc4_decode(block.alpha, pixel));
+}
+
+#ifndef __KERNEL_GPU__
+ccl_device_inline size_t texture_compress_num_blocks(const int width, const int height)
+{
+  return size_t((width + 3) >> 2) * size_t((height + 3) >> 2);
+}
+
+/* Compress images into #texture_compress_num_blocks blocks. */
+void texture_compress_bc1(const uchar4 *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC1 *blocks);
+void texture_compress_bc3(const uchar4 *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC3 *blocks);
+void texture_compress_bc4(const uchar *pixels,
+                          const int width,
+                          const int height,
+                          TextureBlockBC4 *blocks);
+#endif
+
+CCL_NAMESPACE_END
@@ -77,6 +77,33 @@ class DATA_PT_volume_file(DataButtonsPanel, Panel):
             col.label(text=error_msg)
 
 
+class DATA_PT_volume_file_load_bounds(DataButtonsPanel, Panel):
+    bl_label = "Load Bounds"
+    bl_parent_id = "DATA_PT_volume_file"
+    bl_options = {'DEFAULT_CLOSED'}
+    COMPAT_ENGINES = {
+        'BLENDER_RENDER',
+        'BLENDER_EEVEE_NEXT',
+        'BLENDER_WORKBENCH',
+    }
+
+    def draw_header(self, context):
+        volume = context.volume
+        self.layout.prop(volume, "use_load_bounds", text="")
+
+    def draw(self, context):
+        layout = self.layout
+        layout.use_property_split = True
+        layout.use_property_decorate = False
+
+        volume = context.volume
+
+        col = layout.column()
+        col.active = volume.use_load_bounds
+        col.prop(volume, "load_bounds_min", text="Min")
+        col.prop(volume, "load_bounds_max", text="Max")
+
+
 class VOLUME_UL_grids(UIList):
     def draw_item(self, _context, layout, _data, grid, _icon, _active_data, _active_propname, _index):
         name = grid.name
@@ -225,6 +252,7 @@ classes = (
     DATA_PT_context_volume,
     DATA_PT_volume_grids,
     DATA_PT_volume_file,
+    DATA_PT_volume_file_load_bounds,
     DATA_PT_volume_viewport_display,
     DATA_PT_volume_viewport_display_slicing,
     DATA_PT_volume_render,
@@ -12,13 +12,28 @@
 
 namespace blender::bke::bake {
 
+enum class BlobCompression : int8_t {
+  None = 0,
+  Zstd = 1,
+};
+
 /**
  * Reference to a slice of memory typically stored on disk.
  * A blob is a "binary large object".
  */
 struct BlobSlice {
   std::string name;
+  /** Range of the stored (potentially compressed) bytes. */
   IndexRange range;
+  BlobCompression compression = BlobCompression::None;
+  /** Size of the data after decompression. Only used if the slice is compressed. */
+  int64_t decompressed_size = 0;
+
+  /** Number of bytes that are read from the slice. */
+  int64_t data_size() const
+  {
+    return compression == BlobCompression::None ? range.size() : decompressed_size;
+  }
 
   std::shared_ptr<io::serialize::DictionaryValue> serialize() const;
   static std::optional<BlobSlice> deserialize(const io::serialize::DictionaryValue &io_slice);
@@ -32,11 +47,21 @@ class BlobReader {
   virtual ~BlobReader() = default;
 
   /**
-   * Read the data from the given slice into the provided memory buffer.
+   * Read the data from the given slice into the provided memory buffer. The buffer has to be
+   * large enough for #BlobSlice::data_size bytes. Compressed slices are decompressed.
    * \return True on success, otherwise false.
    */
   [[nodiscard]] virtual bool read(const BlobSlice &slice, void *r_data) const = 0;
 
+  /**
+   * Provide direct access to the stored bytes of an uncompressed slice without copying them. The
+   * returned sharing info has a user that is owned by the caller. The referenced memory may be
+   * modified by the new owner without affecting the stored data.
+   * \return None if the reader does not support this for the slice.
+   */
+  [[nodiscard]] virtual std::optional<ImplicitSharingInfoAndData> read_without_copy(
+      const BlobSlice &slice) const;
+
   /**
    * Provides an #istream that can be used to read the data from the given slice.
    * \return True on success, otherwise false.
@@ -51,6 +76,7 @@ class BlobReader {
 class BlobWriter {
  protected:
   int64_t total_written_size_ = 0;
+  BlobCompression compression_ = BlobCompression::None;
 
  public:
   virtual ~BlobWriter() = default;
@@ -61,6 +87,17 @@ class BlobWriter {
    */
   virtual BlobSlice write(const void *data, int64_t size) = 0;
 
+  /**
+   * Same as #write, but compresses the data first if compression is enabled and reduces the size.
+   */
+  BlobSlice write_compressed(const void *data, int64_t size);
+
+  /** Compression used for arrays that are written with #write_compressed. */
+  void set_compression(const BlobCompression compression)
+  {
+    compression_ = compression;
+  }
+
   /**
    * Provides an #ostream that can be used to write the blob.
    * \param file_extension: May be used if the data is written to an independent file. Based on the
@@ -156,22 +193,34 @@ class BlobReadSharing : NonCopyable, NonMovable {
       FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const;
 };
 
+class MappedBlobFile;
+
 /**
- * A specific #BlobReader that reads from disk.
+ * A specific #BlobReader that reads from disk. Blob files are memory-mapped, so that arrays can
+ * be used directly without reading them into separately allocated buffers.
  */
 class DiskBlobReader : public BlobReader {
  private:
   const std::string blobs_dir_;
   mutable std::mutex mutex_;
-  mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /** Files mapped by this reader. Each one has a user that is owned by the reader. */
+  mutable Map<std::string, const MappedBlobFile *> mapped_files_;
 
  public:
   DiskBlobReader(std::string blobs_dir);
+  ~DiskBlobReader();
+
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
+  [[nodiscard]] std::optional<ImplicitSharingInfoAndData> read_without_copy(
+      const BlobSlice &slice) const override;
+
+ private:
+  const MappedBlobFile *get_mapped_file(StringRef name) const;
 };
 
 /**
- * A specific #BlobWriter that writes to a file on disk.
+ * A specific #BlobWriter that writes to a file on disk. Written slices are aligned, so that they
+ * can be used in-place when the file is memory-mapped.
  */
 class DiskBlobWriter : public BlobWriter {
  private:
@@ -8,6 +8,12 @@
  * \ingroup bke
  */
 
+#include <cstdint>
+
+namespace blender::bke {
+struct GeometrySet;
+}
+
 struct CacheFile;
 struct CacheFileLayer;
 struct CacheReader;
@@ -39,6 +45,44 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
                                const char *object_path);
 void BKE_cachefile_reader_free(CacheFile *cache_file, CacheReader **reader);
 
+struct CacheFileReadGeometryParams {
+  /** Path of the object inside the archive that the reader was opened for. */
+  const char *object_path;
+  /** Scene frame to read, the time settings of the cache file are applied to it. */
+  double frame;
+  double fps;
+  /** Combination of the `MOD_MESHSEQ_READ_*` flags. */
+  int read_flag;
+  /** Factor applied to the velocities read from Alembic files. */
+  float velocity_scale;
+};
+
+/**
+ * Read the geometry of \a reader into \a geometry_set, which also provides the geometry that the
+ * reader uses as template.
+ *
+ * When #CacheFile.playback_prefetch_frames is set, decoded frames are stored in the global memory
+ * cache and the frames following the requested one are decoded on a background thread, so that
+ * playback does not have to wait for the file to be read.
+ */
+void BKE_cachefile_reader_read_geometry(CacheFile *cache_file,
+                                        CacheReader *reader,
+                                        Object *object,
+                                        const Depsgraph *depsgraph,
+                                        blender::bke::GeometrySet &geometry_set,
+                                        const CacheFileReadGeometryParams &params,
+                                        const char **r_err_str);
+
+struct CacheFilePlaybackStats {
+  /** Number of frames that were found in the cache of decoded frames. */
+  int64_t hits;
+  /** Number of frames that had to be read from the file while waiting for them. */
+  int64_t misses;
+};
+
+/** Statistics of the decoded frame cache, gathered by the active depsgraph. */
+CacheFilePlaybackStats BKE_cachefile_playback_stats(const CacheFile *cache_file);
+
 /**
  * Determine whether the #CacheFile should use a render engine procedural. If so, data is not read
  * from the file and bounding boxes are used to represent the objects in the Scene.
@@ -0,0 +1,39 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Shared logic for caches that read frames ahead of playback in the background.
+ */
+
+#include <optional>
+
+namespace blender::bke {
+
+/**
+ * Find the first frame in the read-ahead window from the frame after \a frame up to
+ * \a last_frame that still has to be scheduled, and update \a prefetched_until for the next call.
+ *
+ * During playback only the frames that entered the window since the previous call are returned.
+ * When jumping to another frame, the window starts again after the current one; frames that are
+ * cached already are expected to be skipped cheaply by the caller. Nothing has to be scheduled
+ * when the returned frame is larger than \a last_frame.
+ */
+template<typename T>
+T playback_prefetch_first_frame(std::optional<T> &prefetched_until,
+                                const T frame,
+                                const T last_frame)
+{
+  T first_frame = frame + T(1);
+  if (prefetched_until && *prefetched_until >= frame && *prefetched_until <= last_frame) {
+    first_frame = *prefetched_until + T(1);
+  }
+  prefetched_until = last_frame;
+  return first_frame;
+}
+
+}  // namespace blender::bke
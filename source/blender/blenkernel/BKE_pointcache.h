@@ -34,6 +34,8 @@ extern "C" {
 
 /* Add the blend-file name after `blendcache_`. */
 #define PTCACHE_EXT ".bphys"
+/* Extension of a disk cache storing all frames in one file, see #PTCACHE_DISK_CONTAINER. */
+#define PTCACHE_CONTAINER_EXT ".bphyc"
 #define PTCACHE_PATH "blendcache_"
 
 /* File open options, for BKE_ptcache_file_open */
@@ -63,6 +65,8 @@ extern "C" {
 #define PTCACHE_READ_OLD 3
 
 /* Structs */
+struct BLI_mmap_file;
+struct PTCacheContainerWrite;
 struct BlendDataReader;
 struct BlendWriter;
 struct ClothModifierData;
@@ -94,6 +98,13 @@ typedef struct PTCacheData {
 
 typedef struct PTCacheFile {
   FILE *fp;
+  /** Read through a memory map of the file when available, starting at #mmap_offset. */
+  struct BLI_mmap_file *mmap_file;
+  size_t mmap_offset;
+  /** Start of the frame in the file, non-zero for frames stored in a container file. */
+  size_t frame_offset;
+  /** Frame that is appended to a container file, its index is updated when closing the file. */
+  struct PTCacheContainerWrite *container_write;
 
   int frame, old_format;
   unsigned int totpoint, type;
@@ -389,6 +400,11 @@ void BKE_ptcache_mem_to_disk(struct PTCacheID *pid);
  * Convert disk cache to memory cache and vice versa. Clears the cache that was converted.
  */
 void BKE_ptcache_toggle_disk_cache(struct PTCacheID *pid);
+/**
+ * Move the frames of a disk cache between a file per frame and a single container file, after
+ * #PTCACHE_DISK_CONTAINER was changed.
+ */
+void BKE_ptcache_toggle_disk_container(struct PTCacheID *pid);
 /**
  * Rename all disk cache files with a new name. Doesn't touch the actual content of the files.
  */
@@ -10,6 +10,10 @@
 
 #ifdef WITH_OPENVDB
 
+#  include <optional>
+
+#  include "BLI_bounds_types.hh"
+#  include "BLI_math_vector_types.hh"
 #  include "BLI_vector.hh"
 
 #  include "BKE_volume_grid.hh"
@@ -25,8 +29,14 @@ namespace blender::bke::volume_grid::file_cache {
 /**
  * Get the volume grid identified by the parameters from a cache. This does not load the tree data
  * in grid because that is done on demand when it is accessed.
+ *
+ * \param clip_bounds: When set, only the leaf nodes that intersect these bounds (in the space of
+ * the grid transforms) are read from the file, the rest of the grid is empty.
  */
-GVolumeGrid get_grid_from_file(StringRef file_path, StringRef grid_name, int simplify_level = 0);
+GVolumeGrid get_grid_from_file(StringRef file_path,
+                               StringRef grid_name,
+                               int simplify_level = 0,
+                               const std::optional<Bounds<float3>> &clip_bounds = std::nullopt);
 
 struct GridsFromFile {
   /**
@@ -47,13 +57,31 @@ struct GridsFromFile {
  * Get all the data stored in a `.vdb` file.
  * This does not actually load the tree data, which is done on demand.
  */
-GridsFromFile get_all_grids_from_file(StringRef file_path, int simplify_level = 0);
+GridsFromFile get_all_grids_from_file(
+    StringRef file_path,
+    int simplify_level = 0,
+    const std::optional<Bounds<float3>> &clip_bounds = std::nullopt);
 
 /**
- * Remove all cached volume grids that are currently not referenced outside of the cache.
+ * Remove all cached volume grids that are currently not referenced outside of the cache, and the
+ * meta-data of files that don't have any referenced grids anymore. Loaded trees are kept in the
+ * global memory cache, which frees the least recently used ones when it is full.
  */
 void unload_unused();
 
+struct CacheStatistics {
+  /** Number of files whose meta-data is cached. */
+  int64_t files_num = 0;
+  /** Number of grid trees kept in the memory cache, and their approximate size in bytes. */
+  int64_t trees_num = 0;
+  int64_t trees_bytes = 0;
+  /** Number of times a tree was found in the memory cache or had to be read from disk. */
+  int64_t hits_num = 0;
+  int64_t misses_num = 0;
+};
+
+CacheStatistics get_statistics();
+
 }  // namespace blender::bke::volume_grid::file_cache
 
 #endif
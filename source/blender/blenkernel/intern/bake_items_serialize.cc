@@ -18,8 +18,11 @@
 #include "BLI_endian_switch.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
+#include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "DNA_object_types.h"
 #include "DNA_volume_types.h"
@@ -27,9 +30,17 @@
 #include "RNA_access.hh"
 #include "RNA_enum_types.hh"
 
+#include <fcntl.h>
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -49,6 +60,10 @@ std::shared_ptr<DictionaryValue> BlobSlice::serialize() const
   io_slice->append_str("name", this->name);
   io_slice->append_int("start", range.start());
   io_slice->append_int("size", range.size());
+  if (this->compression == BlobCompression::Zstd) {
+    io_slice->append_str("compression", "zstd");
+    io_slice->append_int("decompressed_size", this->decompressed_size);
+  }
   return io_slice;
 }
 
@@ -60,8 +75,65 @@ std::optional<BlobSlice> BlobSlice::deserialize(const DictionaryValue &io_slice)
   if (!name || !start || !size) {
     return std::nullopt;
   }
+  BlobSlice slice{*name, {*start, *size}};
+
+  if (const std::optional<StringRefNull> compression = io_slice.lookup_str("compression")) {
+    if (*compression != "zstd") {
+      return std::nullopt;
+    }
+    const std::optional<int64_t> decompressed_size = io_slice.lookup_int("decompressed_size");
+    if (!decompressed_size) {
+      return std::nullopt;
+    }
+    slice.compression = BlobCompression::Zstd;
+    slice.decompressed_size = *decompressed_size;
+  }
+  return slice;
+}
 
-  return BlobSlice{*name, {*start, *size}};
+/**
+ * Copy or decompress the stored bytes of a slice into a buffer of #BlobSlice::data_size bytes.
+ */
+[[nodiscard]] static bool decode_blob_slice(const BlobSlice &slice,
+                                            const Span<std::byte> stored_data,
+                                            void *r_data)
+{
+  BLI_assert(stored_data.size() == slice.range.size());
+  switch (slice.compression) {
+    case BlobCompression::None: {
+      memcpy(r_data, stored_data.data(), stored_data.size());
+      return true;
+    }
+    case BlobCompression::Zstd: {
+      const size_t decompressed_size = ZSTD_decompress(
+          r_data, size_t(slice.decompressed_size), stored_data.data(), stored_data.size());
+      return !ZSTD_isError(decompressed_size) &&
+             int64_t(decompressed_size) == slice.decompressed_size;
+    }
+  }
+  return false;
+}
+
+BlobSlice BlobWriter::write_compressed(const void *data, const int64_t size)
+{
+  /* Decompressing small arrays is not worth the overhead. */
+  const int64_t min_size_to_compress = 1024;
+  if (compression_ == BlobCompression::None || size < min_size_to_compress) {
+    return this->write(data, size);
+  }
+  /* Decompression speed hardly depends on the level, a low level keeps baking fast. */
+  const int zstd_level = 3;
+  const int64_t buffer_size = int64_t(ZSTD_compressBound(size_t(size)));
+  Array<std::byte> buffer(buffer_size, NoInitialization());
+  const size_t compressed_size = ZSTD_compress(
+      buffer.data(), size_t(buffer.size()), data, size_t(size), zstd_level);
+  if (ZSTD_isError(compressed_size) || int64_t(compressed_size) >= size) {
+    return this->write(data, size);
+  }
+  BlobSlice slice = this->write(buffer.data(), int64_t(compressed_size));
+  slice.compression = BlobCompression::Zstd;
+  slice.decompressed_size = size;
+  return slice;
 }
 
 BlobSlice BlobWriter::write_as_stream(const StringRef /*file_extension*/,
@@ -75,7 +147,7 @@ BlobSlice BlobWriter::write_as_stream(const StringRef /*file_extension*/,
 
 bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::istream &)> fn) const
 {
-  const int64_t size = slice.range.size();
+  const int64_t size = slice.data_size();
   std::string buffer;
   buffer.resize(size);
   if (!this->read(slice, buffer.data())) {
@@ -88,29 +160,151 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
-DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
+std::optional<ImplicitSharingInfoAndData> BlobReader::read_without_copy(
+    const BlobSlice & /*slice*/) const
+{
+  return std::nullopt;
+}
 
-[[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
+/**
+ * Opening and freeing memory-mapped files is not thread-safe, because the #BLI_mmap_file
+ * error handling uses a global list of mapped files.
+ */
+static std::mutex &mmap_mutex()
 {
-  if (slice.range.is_empty()) {
-    return true;
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * A memory-mapped blob file that is shared by the reader and all arrays that reference its
+ * memory directly. The file is mapped copy-on-write, so that an array that has become mutable
+ * because it is the last user can be modified in place.
+ */
+class MappedBlobFile : public ImplicitSharingInfo {
+ private:
+  BLI_mmap_file *mmap_file_;
+
+ public:
+  MappedBlobFile(BLI_mmap_file *mmap_file) : mmap_file_(mmap_file) {}
+
+  Span<std::byte> data() const
+  {
+    return {static_cast<const std::byte *>(BLI_mmap_get_pointer(mmap_file_)),
+            int64_t(BLI_mmap_get_length(mmap_file_))};
+  }
+
+  /** Check whether any IO error happened when accessing the mapped memory so far. */
+  bool has_io_error() const
+  {
+    char dummy;
+    return !BLI_mmap_read(mmap_file_, &dummy, 0, 0);
+  }
+
+  [[nodiscard]] bool read(const int64_t offset, const int64_t size, void *r_data) const
+  {
+    return BLI_mmap_read(mmap_file_, r_data, size_t(offset), size_t(size));
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    {
+      std::lock_guard lock{mmap_mutex()};
+      BLI_mmap_free(mmap_file_);
+    }
+    MEM_delete(this);
   }
+};
 
-  char blob_path[FILE_MAX];
-  BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), slice.name.c_str());
+DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
+DiskBlobReader::~DiskBlobReader()
+{
+  for (const MappedBlobFile *mapped_file : mapped_files_.values()) {
+    if (mapped_file) {
+      mapped_file->remove_user_and_delete_if_last();
+    }
+  }
+}
+
+const MappedBlobFile *DiskBlobReader::get_mapped_file(const StringRef name) const
+{
   std::lock_guard lock{mutex_};
-  std::unique_ptr<fstream> &blob_file = open_input_streams_.lookup_or_add_cb_as(blob_path, [&]() {
-    return std::make_unique<fstream>(blob_path, std::ios::in | std::ios::binary);
+  return mapped_files_.lookup_or_add_cb_as(name, [&]() -> const MappedBlobFile * {
+    char blob_path[FILE_MAX];
+    BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), std::string(name).c_str());
+    const int file = BLI_open(blob_path, O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return nullptr;
+    }
+    BLI_mmap_file *mmap_file;
+    {
+      std::lock_guard mmap_lock{mmap_mutex()};
+      mmap_file = BLI_mmap_open_ex(file, true);
+    }
+    /* The mapping stays valid after the file is closed. */
+    close(file);
+    if (!mmap_file) {
+      return nullptr;
+    }
+    return MEM_new<MappedBlobFile>(__func__, mmap_file);
   });
-  blob_file->seekg(slice.range.start());
-  blob_file->read(static_cast<char *>(r_data), slice.range.size());
-  if (blob_file->gcount() != slice.range.size()) {
+}
+
+[[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
+{
+  if (slice.range.is_empty()) {
+    return true;
+  }
+  const MappedBlobFile *mapped_file = this->get_mapped_file(slice.name);
+  if (!mapped_file) {
     return false;
   }
-  return true;
+  const Span<std::byte> file_data = mapped_file->data();
+  if (!file_data.index_range().contains(slice.range)) {
+    return false;
+  }
+  if (slice.compression == BlobCompression::None) {
+    return mapped_file->read(slice.range.start(), slice.range.size(), r_data);
+  }
+  if (!decode_blob_slice(slice, file_data.slice(slice.range), r_data)) {
+    return false;
+  }
+  return !mapped_file->has_io_error();
+}
+
+std::optional<ImplicitSharingInfoAndData> DiskBlobReader::read_without_copy(
+    const BlobSlice &slice) const
+{
+#ifdef WIN32
+  /* Files can't be removed while they are mapped on Windows. Since the loaded geometry can
+   * outlive the bake, this would make it impossible to delete or overwrite baked data. */
+  UNUSED_VARS(slice);
+  return std::nullopt;
+#else
+  if (slice.compression != BlobCompression::None || slice.range.is_empty()) {
+    return std::nullopt;
+  }
+  const MappedBlobFile *mapped_file = this->get_mapped_file(slice.name);
+  if (!mapped_file) {
+    return std::nullopt;
+  }
+  const Span<std::byte> file_data = mapped_file->data();
+  if (!file_data.index_range().contains(slice.range)) {
+    return std::nullopt;
+  }
+  mapped_file->add_user();
+  return ImplicitSharingInfoAndData{mapped_file, file_data.slice(slice.range).data()};
+#endif
 }
 
+/**
+ * Slices in blob files start at multiples of this, so that arrays can be used directly from the
+ * memory-mapped file.
+ */
+static constexpr int64_t blob_slice_alignment = 16;
+
 DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
     : blob_dir_(std::move(blob_dir)), base_name_(std::move(base_name))
 {
@@ -126,6 +320,14 @@ BlobSlice DiskBlobWriter::write(const void *data, const int64_t size)
     blob_stream_.open(blob_path, std::ios::out | std::ios::binary);
   }
 
+  const int64_t padding = -current_offset_ & (blob_slice_alignment - 1);
+  if (padding > 0) {
+    const char zeros[blob_slice_alignment] = {0};
+    blob_stream_.write(zeros, padding);
+    current_offset_ += padding;
+    total_written_size_ += padding;
+  }
+
   const int64_t old_offset = current_offset_;
   blob_stream_.write(static_cast<const char *>(data), size);
   current_offset_ += size;
@@ -172,9 +374,7 @@ bool MemoryBlobReader::read(const BlobSlice &slice, void *r_data) const
   if (!blob_data.index_range().contains(slice.range)) {
     return false;
   }
-  const void *copy_src = blob_data.slice(slice.range).data();
-  memcpy(r_data, copy_src, slice.range.size());
-  return true;
+  return decode_blob_slice(slice, blob_data.slice(slice.range), r_data);
 }
 
 MemoryBlobWriter::MemoryBlobWriter(std::string base_name) : base_name_(std::move(base_name))
@@ -257,7 +457,7 @@ std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplic
 {
   const uint64_t content_hash = XXH3_64bits(data, size_in_bytes);
   const BlobSlice slice = slice_by_content_hash_.lookup_or_add_cb(
-      content_hash, [&]() { return writer.write(data, size_in_bytes); });
+      content_hash, [&]() { return writer.write_compressed(data, size_in_bytes); });
   return slice.serialize();
 }
 
@@ -265,25 +465,35 @@ std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
     const DictionaryValue &io_data,
     FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const
 {
-  std::lock_guard lock{mutex_};
-
   io::serialize::JsonFormatter formatter;
   std::stringstream ss;
   formatter.serialize(ss, io_data);
   const std::string key = ss.str();
 
-  if (const ImplicitSharingInfoAndData *shared_data = runtime_by_stored_.lookup_ptr(key)) {
-    shared_data->sharing_info->add_user();
-    return *shared_data;
+  {
+    std::lock_guard lock{mutex_};
+    if (const ImplicitSharingInfoAndData *shared_data = runtime_by_stored_.lookup_ptr(key)) {
+      shared_data->sharing_info->add_user();
+      return *shared_data;
+    }
   }
+  /* Read without holding the lock so that different data can be loaded in parallel. */
   std::optional<ImplicitSharingInfoAndData> data = read_fn();
   if (!data) {
     return std::nullopt;
   }
-  if (data->sharing_info != nullptr) {
-    data->sharing_info->add_user();
-    runtime_by_stored_.add_new(key, *data);
+  if (data->sharing_info == nullptr) {
+    return data;
+  }
+  std::lock_guard lock{mutex_};
+  if (const ImplicitSharingInfoAndData *shared_data = runtime_by_stored_.lookup_ptr(key)) {
+    /* The same data has been read by another thread in the mean-time. */
+    data->sharing_info->remove_user_and_delete_if_last();
+    shared_data->sharing_info->add_user();
+    return *shared_data;
   }
+  data->sharing_info->add_user();
+  runtime_by_stored_.add_new(key, *data);
   return data;
 }
 
@@ -357,7 +567,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != element_size * elements_num) {
+  if (slice->data_size() != element_size * elements_num) {
     return false;
   }
   if (!blob_reader.read(*slice, r_data)) {
@@ -405,7 +615,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != bytes_num) {
+  if (slice->data_size() != bytes_num) {
     return false;
   }
   return blob_reader.read(*slice, r_data);
@@ -470,6 +680,40 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
       sharing_info, [&]() { return write_blob_simple_gspan(blob_writer, blob_sharing, data); });
 }
 
+/**
+ * Use the stored array directly if it does not have to be converted in any way.
+ */
+static std::optional<ImplicitSharingInfoAndData> try_read_blob_without_copy(
+    const BlobReader &blob_reader,
+    const DictionaryValue &io_data,
+    const CPPType &cpp_type,
+    const int size)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return std::nullopt;
+  }
+  if (slice->compression != BlobCompression::None ||
+      slice->range.size() != cpp_type.size() * int64_t(size))
+  {
+    return std::nullopt;
+  }
+  const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
+  if (stored_endian != get_endian_io_name(ENDIAN_ORDER)) {
+    return std::nullopt;
+  }
+  std::optional<ImplicitSharingInfoAndData> stored_data = blob_reader.read_without_copy(*slice);
+  if (!stored_data) {
+    return std::nullopt;
+  }
+  if (uintptr_t(stored_data->data) % uintptr_t(cpp_type.alignment()) != 0) {
+    /* Files written before slices were aligned. */
+    stored_data->sharing_info->remove_user_and_delete_if_last();
+    return std::nullopt;
+  }
+  return stored_data;
+}
+
 [[nodiscard]] static const void *read_blob_shared_simple_gspan(
     const DictionaryValue &io_data,
     const BlobReader &blob_reader,
@@ -481,6 +725,11 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
   const char *func = __func__;
   const std::optional<ImplicitSharingInfoAndData> sharing_info_and_data = blob_sharing.read_shared(
       io_data, [&]() -> std::optional<ImplicitSharingInfoAndData> {
+        if (std::optional<ImplicitSharingInfoAndData> stored_data = try_read_blob_without_copy(
+                blob_reader, io_data, cpp_type, size))
+        {
+          return stored_data;
+        }
         void *data_mem = MEM_mallocN_aligned(size * cpp_type.size(), cpp_type.alignment(), func);
         if (!read_blob_simple_gspan(blob_reader, io_data, {cpp_type, data_mem, size})) {
           MEM_freeN(data_mem);
@@ -913,12 +1162,17 @@ static std::unique_ptr<Instances> try_load_instances(const DictionaryValue &io_g
   std::unique_ptr<Instances> instances = std::make_unique<Instances>();
   instances->resize(num_instances);
 
-  for (const auto &io_reference_value : io_references->elements()) {
-    const DictionaryValue *io_reference = io_reference_value->as_dictionary_value();
-    GeometrySet reference_geometry;
-    if (io_reference) {
-      reference_geometry = load_geometry(*io_reference, blob_reader, blob_sharing);
+  const Span<std::shared_ptr<io::serialize::Value>> io_reference_values =
+      io_references->elements();
+  Array<GeometrySet> reference_geometries(io_reference_values.size());
+  threading::parallel_for(io_reference_values.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (const DictionaryValue *io_reference = io_reference_values[i]->as_dictionary_value()) {
+        reference_geometries[i] = load_geometry(*io_reference, blob_reader, blob_sharing);
+      }
     }
+  });
+  for (GeometrySet &reference_geometry : reference_geometries) {
     instances->add_new_reference(std::move(reference_geometry));
   }
 
@@ -1008,15 +1262,31 @@ static GeometrySet load_geometry(const DictionaryValue &io_geometry,
                                  const BlobReader &blob_reader,
                                  const BlobReadSharing &blob_sharing)
 {
-  GeometrySet geometry;
-  geometry.replace_mesh(try_load_mesh(io_geometry, blob_reader, blob_sharing));
-  geometry.replace_pointcloud(try_load_pointcloud(io_geometry, blob_reader, blob_sharing));
-  geometry.replace_curves(try_load_curves(io_geometry, blob_reader, blob_sharing));
-  geometry.replace_grease_pencil(try_load_grease_pencil(io_geometry, blob_reader, blob_sharing));
-  geometry.replace_instances(try_load_instances(io_geometry, blob_reader, blob_sharing).release());
+  Mesh *mesh = nullptr;
+  PointCloud *pointcloud = nullptr;
+  Curves *curves = nullptr;
+  GreasePencil *grease_pencil = nullptr;
+  std::unique_ptr<Instances> instances;
+  Volume *volume = nullptr;
+  threading::parallel_invoke(
+      [&]() { mesh = try_load_mesh(io_geometry, blob_reader, blob_sharing); },
+      [&]() { pointcloud = try_load_pointcloud(io_geometry, blob_reader, blob_sharing); },
+      [&]() { curves = try_load_curves(io_geometry, blob_reader, blob_sharing); },
+      [&]() { grease_pencil = try_load_grease_pencil(io_geometry, blob_reader, blob_sharing); },
+      [&]() { instances = try_load_instances(io_geometry, blob_reader, blob_sharing); },
+      [&]() {
 #ifdef WITH_OPENVDB
-  geometry.replace_volume(try_load_volume(io_geometry, blob_reader));
+        volume = try_load_volume(io_geometry, blob_reader);
 #endif
+      });
+
+  GeometrySet geometry;
+  geometry.replace_mesh(mesh);
+  geometry.replace_pointcloud(pointcloud);
+  geometry.replace_curves(curves);
+  geometry.replace_grease_pencil(grease_pencil);
+  geometry.replace_instances(instances.release());
+  geometry.replace_volume(volume);
   return geometry;
 }
 
@@ -1576,13 +1846,14 @@ static std::unique_ptr<BakeItem> deserialize_bake_item(const DictionaryValue &io
       return std::make_unique<StringBakeItem>(io_string.value());
     }
     if (const io::serialize::DictionaryValue *io_string = io_data->get()->as_dictionary_value()) {
-      const std::optional<int64_t> size = io_string->lookup_int("size");
-      if (!size) {
+      const std::optional<BlobSlice> slice = BlobSlice::deserialize(*io_string);
+      if (!slice) {
         return {};
       }
+      const int64_t size = slice->data_size();
       std::string str;
-      str.resize(*size);
-      if (!read_blob_raw_bytes(blob_reader, *io_string, *size, str.data())) {
+      str.resize(size);
+      if (!read_blob_raw_bytes(blob_reader, *io_string, size, str.data())) {
         return {};
       }
       return std::make_unique<StringBakeItem>(std::move(str));
@@ -1651,7 +1922,9 @@ std::optional<BakeState> deserialize_bake(std::istream &stream,
   if (!io_items) {
     return std::nullopt;
   }
-  BakeState bake_state;
+  Vector<int> ids;
+  Set<int> used_ids;
+  Vector<const io::serialize::DictionaryValue *> item_dicts;
   for (const auto &io_item_value : io_items->elements()) {
     const io::serialize::DictionaryValue *io_item = io_item_value.second->as_dictionary_value();
     if (!io_item) {
@@ -1664,15 +1937,27 @@ std::optional<BakeState> deserialize_bake(std::istream &stream,
     catch (...) {
       return std::nullopt;
     }
-    if (bake_state.items_by_id.contains(id)) {
+    if (!used_ids.add(id)) {
       return std::nullopt;
     }
-    std::unique_ptr<BakeItem> bake_item = deserialize_bake_item(
-        *io_item, blob_reader, blob_sharing);
-    if (!bake_item) {
+    ids.append(id);
+    item_dicts.append(io_item);
+  }
+
+  /* Items are independent of each other, loading them is mostly bound by reading blobs. */
+  Array<std::unique_ptr<BakeItem>> bake_items(ids.size());
+  threading::parallel_for(ids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      bake_items[i] = deserialize_bake_item(*item_dicts[i], blob_reader, blob_sharing);
+    }
+  });
+
+  BakeState bake_state;
+  for (const int i : ids.index_range()) {
+    if (!bake_items[i]) {
       return std::nullopt;
     }
-    bake_state.items_by_id.add_new(id, std::move(bake_item));
+    bake_state.items_by_id.add_new(ids[i], std::move(bake_items[i]));
   }
   return bake_state;
 }
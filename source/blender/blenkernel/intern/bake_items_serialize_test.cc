@@ -0,0 +1,90 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_path_utils.hh"
+#include "BLI_tempfile.h"
+
+#include "BKE_bake_items_serialize.hh"
+
+namespace blender::bke::bake::tests {
+
+static Array<float> test_values(const int size)
+{
+  Array<float> values(size);
+  for (const int i : values.index_range()) {
+    values[i] = float(i % 100) * 0.5f;
+  }
+  return values;
+}
+
+TEST(bake_items_serialize, CompressedMemoryBlob)
+{
+  const Array<float> values = test_values(10000);
+  MemoryBlobWriter writer{"frame"};
+  writer.set_compression(BlobCompression::Zstd);
+  BlobWriteSharing write_sharing;
+  const auto io_data = write_sharing.write_deduplicated(
+      writer, values.data(), values.as_span().size_in_bytes());
+
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(*io_data);
+  ASSERT_TRUE(slice.has_value());
+  EXPECT_EQ(slice->compression, BlobCompression::Zstd);
+  EXPECT_EQ(slice->data_size(), values.as_span().size_in_bytes());
+  EXPECT_LT(slice->range.size(), values.as_span().size_in_bytes());
+
+  const std::string blob = writer.get_stream_by_name().lookup(slice->name).stream->str();
+  MemoryBlobReader reader;
+  reader.add(slice->name, Span(reinterpret_cast<const std::byte *>(blob.data()), blob.size()));
+
+  Array<float> result(values.size());
+  ASSERT_TRUE(reader.read(*slice, result.data()));
+  EXPECT_EQ_ARRAY(values.data(), result.data(), values.size());
+  EXPECT_FALSE(reader.read_without_copy(*slice).has_value());
+}
+
+TEST(bake_items_serialize, DiskBlobAlignedSlices)
+{
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  char blobs_dir[FILE_MAX];
+  BLI_path_join(blobs_dir, sizeof(blobs_dir), temp_dir, "blender_bake_items_serialize_test");
+
+  const Array<float> values = test_values(1001);
+  const char bytes[3] = {1, 2, 3};
+  BlobSlice bytes_slice;
+  BlobSlice values_slice;
+  {
+    DiskBlobWriter writer{blobs_dir, "frame"};
+    bytes_slice = writer.write(bytes, sizeof(bytes));
+    values_slice = writer.write(values.data(), values.as_span().size_in_bytes());
+  }
+  EXPECT_EQ(values_slice.range.start() % 16, 0);
+
+  {
+    DiskBlobReader reader{blobs_dir};
+    char bytes_result[3];
+    ASSERT_TRUE(reader.read(bytes_slice, bytes_result));
+    EXPECT_EQ_ARRAY(bytes, bytes_result, 3);
+
+    Array<float> result(values.size());
+    ASSERT_TRUE(reader.read(values_slice, result.data()));
+    EXPECT_EQ_ARRAY(values.data(), result.data(), values.size());
+
+#ifndef WIN32
+    const std::optional<ImplicitSharingInfoAndData> stored_data = reader.read_without_copy(
+        values_slice);
+    ASSERT_TRUE(stored_data.has_value());
+    EXPECT_EQ_ARRAY(values.data(), static_cast<const float *>(stored_data->data), values.size());
+    stored_data->sharing_info->remove_user_and_delete_if_last();
+#endif
+  }
+
+  BLI_delete(blobs_dir, true, true);
+}
+
+}  // namespace blender::bke::bake::tests
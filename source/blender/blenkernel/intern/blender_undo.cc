@@ -130,6 +130,9 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
       BLO_memfile_clear_future(prevfile);
     }
     /* success = */ /* UNUSED */ BLO_write_file_mem(bmain, prevfile, &mfu->memfile, fileflags);
+    /* Chunks shared with the previous step or found elsewhere in the undo stack by their content
+     * (see #MemFile::size_deduplicated) use no additional memory, only count the rest towards the
+     * undo memory limit. */
     mfu->undo_size = mfu->memfile.size;
   }
 
@@ -6,18 +6,30 @@
  * \ingroup bke
  */
 
+#include <atomic>
 #include <cstring>
+#include <mutex>
 #include <optional>
+#include <string>
 
 #include "DNA_cachefile_types.h"
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
 
 #include "BLI_fileops.h"
+#include "BLI_generic_key.hh"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_memory_cache.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_struct_equality_utils.hh"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -25,11 +37,14 @@
 
 #include "BKE_bpath.hh"
 #include "BKE_cachefile.hh"
+#include "BKE_geometry_set.hh"
 #include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_main.hh"
+#include "BKE_playback_prefetch.hh"
 #include "BKE_scene.hh"
 
+#include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "RE_engine.h"
@@ -46,7 +61,32 @@
 #  include "usd.hh"
 #endif
 
+namespace blender::bke {
+
+struct CacheReaderPlaybackState {
+  /** Readers store data of the last read sample, so they can only be used by one thread. */
+  std::mutex read_mutex;
+  /** Last scene frame for which decoding in the background was scheduled. */
+  std::optional<double> prefetched_until;
+};
+
+struct CacheFileRuntime {
+  /** Protects #prefetch_pool and #CacheReaderPlaybackState::prefetched_until. */
+  std::mutex prefetch_mutex;
+  /** Decodes the frames following the one that is played back. */
+  TaskPool *prefetch_pool = nullptr;
+
+  std::mutex reader_states_mutex;
+  Map<const CacheReader *, std::unique_ptr<CacheReaderPlaybackState>> reader_states;
+
+  std::atomic<int64_t> playback_hits = 0;
+  std::atomic<int64_t> playback_misses = 0;
+};
+
+}  // namespace blender::bke
+
 static void cachefile_handle_free(CacheFile *cache_file);
+static void cachefile_prefetch_cancel(CacheFile *cache_file);
 
 static void cache_file_init_data(ID *id)
 {
@@ -70,6 +110,7 @@ static void cache_file_copy_data(Main * /*bmain*/,
 
   cache_file_dst->handle = nullptr;
   cache_file_dst->handle_readers = nullptr;
+  cache_file_dst->runtime = nullptr;
   BLI_duplicatelist(&cache_file_dst->object_paths, &cache_file_src->object_paths);
   BLI_duplicatelist(&cache_file_dst->layers, &cache_file_src->layers);
 }
@@ -80,6 +121,7 @@ static void cache_file_free_data(ID *id)
   cachefile_handle_free(cache_file);
   BLI_freelistN(&cache_file->object_paths);
   BLI_freelistN(&cache_file->layers);
+  MEM_delete(cache_file->runtime);
 }
 
 static void cache_file_foreach_path(ID *id, BPathForeachPathData *bpath_data)
@@ -115,6 +157,7 @@ static void cache_file_blend_read_data(BlendDataReader *reader, ID *id)
   cache_file->handle = nullptr;
   cache_file->handle_filepath[0] = '\0';
   cache_file->handle_readers = nullptr;
+  cache_file->runtime = nullptr;
 
   /* relink layers */
   BLO_read_struct_list(reader, CacheFileLayer, &cache_file->layers);
@@ -163,6 +206,322 @@ void BKE_cachefiles_exit()
   BLI_spin_end(&spin);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Decoded Frame Cache
+ *
+ * Geometry read by the Mesh Sequence Cache modifier is stored in the global #memory_cache, and
+ * the frames following the one that is played back are decoded on a background thread.
+ * \{ */
+
+namespace blender::bke {
+
+/** Everything besides the template geometry that determines the result of reading a sample. */
+struct SampleReadParams {
+  double time;
+  double fps;
+  int read_flag;
+  float velocity_scale;
+  std::string velocity_name;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_5(
+      SampleReadParams, time, fps, read_flag, velocity_scale, velocity_name)
+};
+
+class PlaybackFrameKey : public GenericKey {
+ public:
+  uint32_t cache_file_session_uid;
+  /** File path of the archive and its layers. */
+  std::string archive;
+  std::string object_path;
+  SampleReadParams sample;
+  /** See #template_geometry_data. */
+  Vector<uint64_t> template_data;
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(get_default_hash(cache_file_session_uid, archive, object_path),
+                            get_default_hash(sample.time, sample.read_flag),
+                            template_data.as_span());
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_5(
+      PlaybackFrameKey, cache_file_session_uid, archive, object_path, sample, template_data)
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const PlaybackFrameKey *>(&other)) {
+      return *this == *other_typed;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<PlaybackFrameKey>(*this);
+  }
+};
+
+class PlaybackFrameValue : public memory_cache::CachedValue {
+ public:
+  /** Keeps the arrays referenced by #PlaybackFrameKey::template_data alive. */
+  GeometrySet template_geometry;
+  GeometrySet geometry;
+  const char *error = nullptr;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    this->template_geometry.count_memory(memory);
+    this->geometry.count_memory(memory);
+  }
+};
+
+struct PlaybackFrameRead {
+  CacheReaderPlaybackState *state;
+  CacheReader *reader;
+  Object *object;
+  char type;
+};
+
+struct PrefetchTask {
+  PlaybackFrameRead read;
+  PlaybackFrameKey key;
+  GeometrySet template_geometry;
+};
+
+static void gather_custom_data(const CustomData &data, Vector<uint64_t> &r_data)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    r_data.append(uint64_t(layer.type));
+    r_data.append(get_default_hash(StringRef(layer.name)));
+    r_data.append(uint64_t(uintptr_t(layer.data)));
+  }
+}
+
+static void gather_materials(Material **materials, const short materials_num, Vector<uint64_t> &r_data)
+{
+  r_data.append(uint64_t(materials_num));
+  for (const int i : IndexRange(materials_num)) {
+    r_data.append(uint64_t(uintptr_t(materials[i])));
+  }
+}
+
+/**
+ * Identify the geometry that readers use as template by the addresses of its arrays. The cached
+ * value keeps a reference to that geometry, so the arrays can't be freed or changed while the key
+ * exists, and equal addresses mean equal data. The geometry at the start of the modifier stack
+ * shares its arrays with the original data-block, so it is identified the same way on every frame.
+ */
+static std::optional<Vector<uint64_t>> template_geometry_data(const GeometrySet &geometry)
+{
+  Vector<uint64_t> data;
+  for (const GeometryComponent::Type type : geometry.gather_component_types(true, false)) {
+    data.append(uint64_t(type));
+    switch (type) {
+      case GeometryComponent::Type::Mesh: {
+        const Mesh &mesh = *geometry.get_mesh();
+        data.extend({uint64_t(mesh.verts_num),
+                     uint64_t(mesh.edges_num),
+                     uint64_t(mesh.faces_num),
+                     uint64_t(mesh.corners_num),
+                     uint64_t(uintptr_t(mesh.face_offset_indices))});
+        gather_custom_data(mesh.vert_data, data);
+        gather_custom_data(mesh.edge_data, data);
+        gather_custom_data(mesh.face_data, data);
+        gather_custom_data(mesh.corner_data, data);
+        gather_materials(mesh.mat, mesh.totcol, data);
+        break;
+      }
+      case GeometryComponent::Type::PointCloud: {
+        const PointCloud &pointcloud = *geometry.get_pointcloud();
+        data.append(uint64_t(pointcloud.totpoint));
+        gather_custom_data(pointcloud.pdata, data);
+        gather_materials(pointcloud.mat, pointcloud.totcol, data);
+        break;
+      }
+      case GeometryComponent::Type::Curve: {
+        const Curves &curves = *geometry.get_curves();
+        data.extend({uint64_t(curves.geometry.point_num),
+                     uint64_t(curves.geometry.curve_num),
+                     uint64_t(uintptr_t(curves.geometry.curve_offsets))});
+        gather_custom_data(curves.geometry.point_data, data);
+        gather_custom_data(curves.geometry.curve_data, data);
+        gather_materials(curves.mat, curves.totcol, data);
+        break;
+      }
+      default:
+        /* Readers don't create other geometry types, don't cache results when they are passed
+         * through. */
+        return std::nullopt;
+    }
+  }
+  return data;
+}
+
+static std::string archive_identifier(const CacheFile &cache_file)
+{
+  std::string identifier = cache_file.handle_filepath;
+  LISTBASE_FOREACH (const CacheFileLayer *, layer, &cache_file.layers) {
+    if ((layer->flag & CACHEFILE_LAYER_HIDDEN) == 0) {
+      identifier += '\n';
+      identifier += layer->filepath;
+    }
+  }
+  return identifier;
+}
+
+static void read_geometry(const PlaybackFrameRead &read,
+                          const SampleReadParams &sample,
+                          GeometrySet &geometry_set,
+                          const char **r_err_str)
+{
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
+  switch (read.type) {
+    case CACHEFILE_TYPE_ALEMBIC: {
+#ifdef WITH_ALEMBIC
+      ABCReadParams params;
+      params.time = sample.time;
+      params.read_flags = sample.read_flag;
+      params.velocity_name = sample.velocity_name.c_str();
+      params.velocity_scale = sample.velocity_scale;
+      ABC_read_geometry(read.reader, read.object, geometry_set, &params, r_err_str);
+#endif
+      break;
+    }
+    case CACHEFILE_TYPE_USD: {
+#ifdef WITH_USD
+      const io::usd::USDMeshReadParams params = io::usd::create_mesh_read_params(
+          sample.time * sample.fps, sample.read_flag);
+      io::usd::USD_read_geometry(read.reader, read.object, geometry_set, params, r_err_str);
+#endif
+      break;
+    }
+    case CACHE_FILE_TYPE_INVALID:
+      break;
+  }
+#else
+  UNUSED_VARS(read, sample, geometry_set, r_err_str);
+#endif
+}
+
+static std::shared_ptr<const PlaybackFrameValue> read_frame_cached(
+    const PlaybackFrameRead &read,
+    const PlaybackFrameKey &key,
+    const GeometrySet &template_geometry,
+    bool *r_is_miss)
+{
+  return memory_cache::get<PlaybackFrameValue>(key, [&]() {
+    if (r_is_miss) {
+      *r_is_miss = true;
+    }
+    auto value = std::make_unique<PlaybackFrameValue>();
+    value->template_geometry = template_geometry;
+    value->geometry = template_geometry;
+    std::lock_guard lock{read.state->read_mutex};
+    /* Isolate because reading may use multi-threading while the mutex is locked. */
+    threading::isolate_task(
+        [&]() { read_geometry(read, key.sample, value->geometry, &value->error); });
+    return value;
+  });
+}
+
+static void prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  if (BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+  const PrefetchTask &task = *static_cast<const PrefetchTask *>(taskdata);
+  read_frame_cached(task.read, task.key, task.template_geometry, nullptr);
+}
+
+static void prefetch_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MEM_delete(static_cast<PrefetchTask *>(taskdata));
+}
+
+static void prefetch_schedule(const CacheFile &cache_file,
+                              CacheFileRuntime &runtime,
+                              const PlaybackFrameRead &read,
+                              const PlaybackFrameKey &key,
+                              const GeometrySet &template_geometry,
+                              const double frame)
+{
+  const double last_frame = frame + cache_file.playback_prefetch_frames;
+
+  std::lock_guard lock{runtime.prefetch_mutex};
+  const double first_frame = playback_prefetch_first_frame(
+      read.state->prefetched_until, frame, last_frame);
+  if (first_frame > last_frame) {
+    return;
+  }
+
+  if (runtime.prefetch_pool == nullptr) {
+    runtime.prefetch_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  }
+  for (double prefetch_frame = first_frame; prefetch_frame <= last_frame; prefetch_frame += 1.0) {
+    PrefetchTask *task = MEM_new<PrefetchTask>(__func__);
+    task->read = read;
+    task->key = key;
+    task->key.sample.time = BKE_cachefile_time_offset(&cache_file, prefetch_frame, key.sample.fps);
+    task->template_geometry = template_geometry;
+    BLI_task_pool_push(runtime.prefetch_pool, prefetch_task_run, task, true, prefetch_task_free);
+  }
+}
+
+}  // namespace blender::bke
+
+static blender::bke::CacheFileRuntime &cachefile_runtime_ensure(CacheFile *cache_file)
+{
+  /* Multiple modifiers can read from the same cache file concurrently. */
+  BLI_spin_lock(&spin);
+  if (cache_file->runtime == nullptr) {
+    cache_file->runtime = MEM_new<blender::bke::CacheFileRuntime>(__func__);
+  }
+  BLI_spin_unlock(&spin);
+  return *cache_file->runtime;
+}
+
+static blender::bke::CacheReaderPlaybackState &cachefile_reader_state_ensure(
+    blender::bke::CacheFileRuntime &runtime, const CacheReader *reader)
+{
+  std::lock_guard lock{runtime.reader_states_mutex};
+  return *runtime.reader_states.lookup_or_add_cb(
+      reader, []() { return std::make_unique<blender::bke::CacheReaderPlaybackState>(); });
+}
+
+static void cachefile_reader_state_remove(CacheFile *cache_file, const CacheReader *reader)
+{
+  if (cache_file->runtime == nullptr) {
+    return;
+  }
+  std::lock_guard lock{cache_file->runtime->reader_states_mutex};
+  cache_file->runtime->reader_states.remove(reader);
+}
+
+/** Stop decoding frames in the background, which has to happen before readers are freed. */
+static void cachefile_prefetch_cancel(CacheFile *cache_file)
+{
+  blender::bke::CacheFileRuntime *runtime = cache_file->runtime;
+  if (runtime == nullptr) {
+    return;
+  }
+  std::lock_guard lock{runtime->prefetch_mutex};
+  if (runtime->prefetch_pool == nullptr) {
+    return;
+  }
+  blender::threading::isolate_task([&]() {
+    BLI_task_pool_cancel(runtime->prefetch_pool);
+    BLI_task_pool_free(runtime->prefetch_pool);
+  });
+  runtime->prefetch_pool = nullptr;
+  for (std::unique_ptr<blender::bke::CacheReaderPlaybackState> &state :
+       runtime->reader_states.values())
+  {
+    state->prefetched_until.reset();
+  }
+}
+
+/** \} */
+
 void BKE_cachefile_reader_open(CacheFile *cache_file,
                                CacheReader **reader,
                                Object *object,
@@ -176,6 +535,12 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
     return;
   }
 
+  if (*reader) {
+    /* The existing reader is freed when opening the new one. */
+    cachefile_prefetch_cancel(cache_file);
+    cachefile_reader_state_remove(cache_file, *reader);
+  }
+
   switch (cache_file->type) {
     case CACHEFILE_TYPE_ALEMBIC:
 #  ifdef WITH_ALEMBIC
@@ -217,6 +582,11 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
 void BKE_cachefile_reader_free(CacheFile *cache_file, CacheReader **reader)
 {
 #if defined(WITH_ALEMBIC) || defined(WITH_USD)
+  if (cache_file && *reader != nullptr) {
+    cachefile_prefetch_cancel(cache_file);
+    cachefile_reader_state_remove(cache_file, *reader);
+  }
+
   /* Multiple modifiers and constraints can call this function concurrently, and
    * cachefile_handle_free() can also be called at the same time. */
   BLI_spin_lock(&spin);
@@ -258,6 +628,11 @@ static void cachefile_handle_free(CacheFile *cache_file)
 
   /* Free readers in all modifiers and constraints that use the handle, before
    * we free the handle itself. */
+  cachefile_prefetch_cancel(cache_file);
+  if (cache_file->runtime) {
+    std::lock_guard lock{cache_file->runtime->reader_states_mutex};
+    cache_file->runtime->reader_states.clear();
+  }
   BLI_spin_lock(&spin);
   if (cache_file->handle_readers) {
     GSetIterator gs_iter;
@@ -330,6 +705,13 @@ void BKE_cachefile_reload(Depsgraph *depsgraph, CacheFile *cache_file)
     cachefile_handle_free(cache_file_eval);
   }
 
+  /* The file may have changed on disk, so previously decoded frames can't be used anymore. */
+  const uint32_t session_uid = cache_file->id.session_uid;
+  blender::memory_cache::remove_if([&](const blender::GenericKey &key) {
+    const auto *frame_key = dynamic_cast<const blender::bke::PlaybackFrameKey *>(&key);
+    return frame_key && frame_key->cache_file_session_uid == session_uid;
+  });
+
   DEG_id_tag_update(&cache_file->id, ID_RECALC_SYNC_TO_EVAL);
 }
 
@@ -408,6 +790,92 @@ bool BKE_cachefile_filepath_get(const Main *bmain,
   return true;
 }
 
+void BKE_cachefile_reader_read_geometry(CacheFile *cache_file,
+                                        CacheReader *reader,
+                                        Object *object,
+                                        const Depsgraph *depsgraph,
+                                        blender::bke::GeometrySet &geometry_set,
+                                        const CacheFileReadGeometryParams &params,
+                                        const char **r_err_str)
+{
+  using namespace blender;
+  using namespace blender::bke;
+
+  SampleReadParams sample;
+  sample.time = BKE_cachefile_time_offset(cache_file, params.frame, params.fps);
+  sample.fps = params.fps;
+  sample.read_flag = params.read_flag;
+  sample.velocity_scale = params.velocity_scale;
+  sample.velocity_name = cache_file->velocity_name;
+
+  std::optional<Vector<uint64_t>> template_data;
+  if (cache_file->playback_prefetch_frames > 0) {
+    template_data = template_geometry_data(geometry_set);
+  }
+
+  if (!template_data) {
+    CacheReaderPlaybackState *state = nullptr;
+    if (cache_file->runtime) {
+      /* Background threads may still decode frames using this reader. */
+      state = &cachefile_reader_state_ensure(*cache_file->runtime, reader);
+    }
+    const PlaybackFrameRead read{state, reader, object, cache_file->type};
+    if (state) {
+      std::lock_guard lock{state->read_mutex};
+      threading::isolate_task([&]() { read_geometry(read, sample, geometry_set, r_err_str); });
+    }
+    else {
+      read_geometry(read, sample, geometry_set, r_err_str);
+    }
+    return;
+  }
+
+  CacheFileRuntime &runtime = cachefile_runtime_ensure(cache_file);
+  const PlaybackFrameRead read{
+      &cachefile_reader_state_ensure(runtime, reader), reader, object, cache_file->type};
+
+  PlaybackFrameKey key;
+  key.cache_file_session_uid = cache_file->id.session_uid;
+  key.archive = archive_identifier(*cache_file);
+  key.object_path = params.object_path;
+  key.sample = std::move(sample);
+  key.template_data = std::move(*template_data);
+
+  bool is_miss = false;
+  const std::shared_ptr<const PlaybackFrameValue> value = read_frame_cached(
+      read, key, geometry_set, &is_miss);
+  geometry_set = value->geometry;
+  if (value->error) {
+    *r_err_str = value->error;
+  }
+
+  if (DEG_is_active(depsgraph)) {
+    /* Gather statistics on the original data-block so that they can be displayed. */
+    CacheFile *cache_file_orig = reinterpret_cast<CacheFile *>(
+        DEG_get_original_id(&cache_file->id));
+    CacheFileRuntime &runtime_orig = cachefile_runtime_ensure(cache_file_orig);
+    std::atomic<int64_t> &counter = is_miss ? runtime_orig.playback_misses :
+                                              runtime_orig.playback_hits;
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /* The time doesn't change when the frame is overridden, and the reader only reads a single
+   * file of a sequence. */
+  if (!cache_file->is_sequence && !cache_file->override_frame) {
+    prefetch_schedule(*cache_file, runtime, read, key, value->template_geometry, params.frame);
+  }
+}
+
+CacheFilePlaybackStats BKE_cachefile_playback_stats(const CacheFile *cache_file)
+{
+  CacheFilePlaybackStats stats{};
+  if (const blender::bke::CacheFileRuntime *runtime = cache_file->runtime) {
+    stats.hits = runtime->playback_hits.load(std::memory_order_relaxed);
+    stats.misses = runtime->playback_misses.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
 double BKE_cachefile_time_offset(const CacheFile *cache_file, const double time, const double fps)
 {
   const double time_offset = double(cache_file->frame_offset) / fps;
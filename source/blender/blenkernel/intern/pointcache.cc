@@ -7,12 +7,19 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <zstd.h>
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -36,12 +43,22 @@
 #include "DNA_space_types.h"
 
 #include "BLI_fileops.h"
+#include "BLI_function_ref.hh"
+#include "BLI_generic_key.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_string_ref.hh"
+#include "BLI_struct_equality_utils.hh"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -57,6 +74,7 @@
 #include "BKE_modifier.hh"
 #include "BKE_object.hh"
 #include "BKE_particle.h"
+#include "BKE_playback_prefetch.hh"
 #include "BKE_pointcache.h"
 #include "BKE_scene.hh"
 #include "BKE_softbody.h"
@@ -83,6 +101,8 @@
 
 #define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
 
+#define PTCACHE_ZSTD_LEVEL 3
+
 #ifdef WITH_LZMA
 #  include "LzmaLib.h"
 #endif
@@ -126,9 +146,10 @@ static int ptcache_extra_datasize[] = {
 /* forward declarations */
 static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len);
 static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode);
+    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, size_t out_capacity, int mode);
 static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint size);
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size);
+static void ptcache_file_close(PTCacheFile *pf);
 
 /* Common functions */
 static int ptcache_basic_header_read(PTCacheFile *pf)
@@ -136,11 +157,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
   int error = 0;
 
   /* Custom functions should read these basic elements too! */
-  if (!error && !fread(&pf->totpoint, sizeof(uint), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->totpoint, 1, sizeof(uint))) {
     error = 1;
   }
 
-  if (!error && !fread(&pf->data_types, sizeof(uint), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->data_types, 1, sizeof(uint))) {
     error = 1;
   }
 
@@ -149,11 +170,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
 static int ptcache_basic_header_write(PTCacheFile *pf)
 {
   /* Custom functions should write these basic elements too! */
-  if (!fwrite(&pf->totpoint, sizeof(uint), 1, pf->fp)) {
+  if (!ptcache_file_write(pf, &pf->totpoint, 1, sizeof(uint))) {
     return 0;
   }
 
-  if (!fwrite(&pf->data_types, sizeof(uint), 1, pf->fp)) {
+  if (!ptcache_file_write(pf, &pf->data_types, 1, sizeof(uint))) {
     return 0;
   }
 
@@ -705,10 +726,11 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
       return 0;
     }
 
-    out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
+    const size_t out_capacity = LZO_OUT_LEN(in_len);
+    out = (uchar *)MEM_callocN(out_capacity, "pointcache_lzo_buffer");
 
     ptcache_file_compressed_write(
-        pf, (uchar *)surface->data->type_data, in_len, out, cache_compress);
+        pf, (uchar *)surface->data->type_data, in_len, out, out_capacity, cache_compress);
     MEM_freeN(out);
   }
   return 1;
@@ -1447,29 +1469,44 @@ static int ptcache_filepath(PTCacheID *pid,
   return len; /* make sure the above string is always 16 chars */
 }
 
+static bool ptcache_use_container(const PTCacheID *pid)
+{
+  const int flag = pid->cache->flag;
+  return (flag & PTCACHE_DISK_CACHE) && (flag & PTCACHE_DISK_CONTAINER) &&
+         (flag & PTCACHE_EXTERNAL) == 0;
+}
+
+/** Path of the container file that stores all frames of the cache. */
+static int ptcache_container_filepath(PTCacheID *pid, char filepath[MAX_PTCACHE_FILE])
+{
+  int len = ptcache_filepath(pid, filepath, 0, true, false);
+  if (len == 0) {
+    return 0;
+  }
+
+  /* PointCaches are inserted in object's list on demand, we need a valid index now. */
+  if (pid->cache->index < 0) {
+    BLI_assert(GS(pid->owner_id->name) == ID_OB);
+    pid->cache->index = pid->stack_index = BKE_object_insert_ptcache((Object *)pid->owner_id);
+  }
+
+  len += BLI_snprintf_rlen(filepath + len,
+                           MAX_PTCACHE_FILE - len,
+                           "_%02u" PTCACHE_CONTAINER_EXT,
+                           pid->stack_index);
+  return len;
+}
+
+/** Memory mapping files isn't thread-safe, but frames are read on multiple threads. */
+static std::mutex ptcache_mmap_mutex;
+
 /**
  * Caller must close after!
  */
-static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
+static PTCacheFile *ptcache_file_open_path(const char *filepath, int mode, int cfra)
 {
   PTCacheFile *pf;
   FILE *fp = nullptr;
-  char filepath[MAX_PTCACHE_FILE];
-
-#ifndef DURIAN_POINTCACHE_LIB_OK
-  /* don't allow writing for linked objects */
-  if (pid->owner_id->lib && mode == PTCACHE_FILE_WRITE) {
-    return nullptr;
-  }
-#endif
-  if ((pid->cache->flag & PTCACHE_EXTERNAL) == 0) {
-    const char *blendfile_path = BKE_main_blendfile_path_from_global();
-    if (blendfile_path[0] == '\0') {
-      return nullptr; /* save blend file before using disk pointcache */
-    }
-  }
-
-  ptcache_filepath(pid, filepath, cfra, true, true);
 
   if (mode == PTCACHE_FILE_READ) {
     fp = BLI_fopen(filepath, "rb");
@@ -1489,14 +1526,346 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 
   pf = static_cast<PTCacheFile *>(MEM_mallocN(sizeof(PTCacheFile), "PTCacheFile"));
   pf->fp = fp;
+  pf->mmap_file = nullptr;
+  pf->mmap_offset = 0;
+  pf->frame_offset = 0;
+  pf->container_write = nullptr;
   pf->old_format = 0;
   pf->frame = cfra;
 
+  if (mode == PTCACHE_FILE_READ) {
+    /* Avoid a system call for every value that is read, fall back to the file if mapping fails. */
+    std::lock_guard lock{ptcache_mmap_mutex};
+    pf->mmap_file = BLI_mmap_open(fileno(fp));
+  }
+
   return pf;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Container Files
+ *
+ * With #PTCACHE_DISK_CONTAINER all frames of a disk cache are stored in one file. Every frame is
+ * a chunk with the same contents as the file of that frame would have, so that frames are read and
+ * written with the same code. The header at the start of the file points to an index of the
+ * chunks sorted by frame, which is stored after the last chunk.
+ *
+ * A new frame is written over the index, which is then written again after the new chunk. Chunks
+ * of frames that are removed or written again are only reused when they are at the end of the
+ * file, the file is deleted when the whole cache is cleared.
+ * \{ */
+
+#define PTCACHE_CONTAINER_ID "BPHYSCON"
+#define PTCACHE_CONTAINER_VERSION 1
+
+struct PTCacheContainerHeader {
+  char id[8];
+  uint32_t version;
+  uint32_t frames_num;
+  /** Position of the #PTCacheContainerEntry array. */
+  uint64_t index_offset;
+};
+
+struct PTCacheContainerEntry {
+  int32_t frame;
+  uint32_t _pad;
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct PTCacheContainerWrite {
+  PTCacheContainerHeader header;
+  blender::Vector<PTCacheContainerEntry> index;
+};
+
+static PTCacheContainerHeader ptcache_container_header_init()
+{
+  PTCacheContainerHeader header = {};
+  memcpy(header.id, PTCACHE_CONTAINER_ID, sizeof(header.id));
+  header.version = PTCACHE_CONTAINER_VERSION;
+  header.index_offset = sizeof(PTCacheContainerHeader);
+  return header;
+}
+
+static bool ptcache_container_header_is_valid(const PTCacheContainerHeader &header)
+{
+  return STREQLEN(header.id, PTCACHE_CONTAINER_ID, sizeof(header.id)) &&
+         header.version == PTCACHE_CONTAINER_VERSION;
+}
+
+static bool ptcache_container_index_read(FILE *fp,
+                                         PTCacheContainerHeader &r_header,
+                                         blender::Vector<PTCacheContainerEntry> &r_index)
+{
+  if (BLI_fseek(fp, 0, SEEK_SET) != 0 || fread(&r_header, sizeof(r_header), 1, fp) != 1 ||
+      !ptcache_container_header_is_valid(r_header))
+  {
+    return false;
+  }
+  r_index.resize(r_header.frames_num);
+  if (r_index.is_empty()) {
+    return true;
+  }
+  return BLI_fseek(fp, int64_t(r_header.index_offset), SEEK_SET) == 0 &&
+         fread(r_index.data(), sizeof(PTCacheContainerEntry), r_index.size(), fp) ==
+             size_t(r_index.size());
+}
+
+/** Write \a index at \a index_offset, after the last chunk, then the header that points to it. */
+static bool ptcache_container_index_write(FILE *fp,
+                                          PTCacheContainerHeader &header,
+                                          const blender::Span<PTCacheContainerEntry> index,
+                                          const uint64_t index_offset)
+{
+  header.frames_num = uint32_t(index.size());
+  header.index_offset = index_offset;
+
+  if (BLI_fseek(fp, int64_t(index_offset), SEEK_SET) != 0) {
+    return false;
+  }
+  const size_t index_num = size_t(index.size());
+  if (index_num > 0 &&
+      fwrite(index.data(), sizeof(PTCacheContainerEntry), index_num, fp) != index_num)
+  {
+    return false;
+  }
+  return BLI_fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, fp) == 1 &&
+         fflush(fp) == 0;
+}
+
+/** Read the index of a container file, empty when the file doesn't exist or is invalid. */
+static blender::Vector<PTCacheContainerEntry> ptcache_container_index_get(const char *filepath)
+{
+  blender::Vector<PTCacheContainerEntry> index;
+  if (FILE *fp = BLI_fopen(filepath, "rb")) {
+    PTCacheContainerHeader header;
+    if (!ptcache_container_index_read(fp, header, index)) {
+      index.clear();
+    }
+    fclose(fp);
+  }
+  return index;
+}
+
+static bool ptcache_file_read_at(PTCacheFile *pf, const uint64_t offset, void *data, size_t size)
+{
+  if (pf->mmap_file) {
+    return BLI_mmap_read(pf->mmap_file, data, size_t(offset), size);
+  }
+  return BLI_fseek(pf->fp, int64_t(offset), SEEK_SET) == 0 && fread(data, size, 1, pf->fp) == 1;
+}
+
+/**
+ * Open a container file for reading the chunk of \a cfra, returns null when the frame isn't
+ * stored. Only the header and the index entries visited by a binary search are read.
+ */
+static PTCacheFile *ptcache_container_frame_open(const char *filepath, const int cfra)
+{
+  PTCacheFile *pf = ptcache_file_open_path(filepath, PTCACHE_FILE_READ, cfra);
+  if (pf == nullptr) {
+    return nullptr;
+  }
+
+  PTCacheContainerHeader header;
+  if (!ptcache_file_read_at(pf, 0, &header, sizeof(header)) ||
+      !ptcache_container_header_is_valid(header))
+  {
+    ptcache_file_close(pf);
+    return nullptr;
+  }
+
+  int64_t low = 0;
+  int64_t high = int64_t(header.frames_num) - 1;
+  while (low <= high) {
+    const int64_t mid = (low + high) / 2;
+    PTCacheContainerEntry entry;
+    if (!ptcache_file_read_at(pf,
+                              header.index_offset + uint64_t(mid) * sizeof(PTCacheContainerEntry),
+                              &entry,
+                              sizeof(entry)))
+    {
+      break;
+    }
+    if (entry.frame == cfra) {
+      pf->frame_offset = size_t(entry.offset);
+      pf->mmap_offset = pf->frame_offset;
+      BLI_fseek(pf->fp, int64_t(entry.offset), SEEK_SET);
+      return pf;
+    }
+    if (entry.frame < cfra) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+
+  ptcache_file_close(pf);
+  return nullptr;
+}
+
+static bool ptcache_container_frame_exists(const char *filepath, const int cfra)
+{
+  PTCacheFile *pf = ptcache_container_frame_open(filepath, cfra);
+  if (pf == nullptr) {
+    return false;
+  }
+  ptcache_file_close(pf);
+  return true;
+}
+
+/**
+ * Open a container file for writing the chunk of \a cfra after the last chunk. Closing the file
+ * with #ptcache_file_close adds the chunk to the index.
+ */
+static PTCacheFile *ptcache_container_frame_append(const char *filepath, const int cfra)
+{
+  PTCacheContainerWrite *container_write = MEM_new<PTCacheContainerWrite>(__func__);
+
+  PTCacheFile *pf = ptcache_file_open_path(filepath, PTCACHE_FILE_UPDATE, cfra);
+  if (pf == nullptr ||
+      !ptcache_container_index_read(pf->fp, container_write->header, container_write->index))
+  {
+    /* Start a new container, also when an invalid file is in the way. */
+    ptcache_file_close(pf);
+    container_write->header = ptcache_container_header_init();
+    container_write->index.clear();
+    pf = ptcache_file_open_path(filepath, PTCACHE_FILE_WRITE, cfra);
+  }
+
+  if (pf == nullptr ||
+      BLI_fseek(pf->fp, int64_t(container_write->header.index_offset), SEEK_SET) != 0)
+  {
+    ptcache_file_close(pf);
+    MEM_delete(container_write);
+    return nullptr;
+  }
+
+  pf->frame_offset = size_t(container_write->header.index_offset);
+  pf->container_write = container_write;
+  return pf;
+}
+
+/** Add the chunk written since #ptcache_container_frame_append to the index. */
+static bool ptcache_container_frame_append_end(PTCacheFile *pf)
+{
+  PTCacheContainerWrite &container_write = *pf->container_write;
+  blender::Vector<PTCacheContainerEntry> &index = container_write.index;
+
+  const int64_t chunk_end = BLI_ftell(pf->fp);
+  if (chunk_end < int64_t(pf->frame_offset)) {
+    return false;
+  }
+
+  PTCacheContainerEntry entry = {};
+  entry.frame = pf->frame;
+  entry.offset = uint64_t(pf->frame_offset);
+  entry.size = uint64_t(chunk_end) - entry.offset;
+
+  /* Keep the index sorted by frame, a frame that is written again replaces the old chunk. */
+  PTCacheContainerEntry *it = std::lower_bound(
+      index.begin(), index.end(), entry.frame, [](const PTCacheContainerEntry &a, const int b) {
+        return a.frame < b;
+      });
+  if (it != index.end() && it->frame == entry.frame) {
+    *it = entry;
+  }
+  else {
+    index.insert(it - index.begin(), entry);
+  }
+
+  return ptcache_container_index_write(
+      pf->fp, container_write.header, index, uint64_t(chunk_end));
+}
+
+/**
+ * Remove the frames for which \a remove_fn returns true from a container file, the file is
+ * deleted when no frame is left.
+ */
+static void ptcache_container_frames_remove(const char *filepath,
+                                            const blender::FunctionRef<bool(int frame)> remove_fn)
+{
+  FILE *fp = BLI_fopen(filepath, "rb+");
+  if (fp == nullptr) {
+    return;
+  }
+
+  PTCacheContainerHeader header;
+  blender::Vector<PTCacheContainerEntry> index;
+  if (!ptcache_container_index_read(fp, header, index) ||
+      index.remove_if([&](const PTCacheContainerEntry &entry) {
+        return remove_fn(entry.frame);
+      }) == 0)
+  {
+    fclose(fp);
+    return;
+  }
+
+  if (index.is_empty()) {
+    fclose(fp);
+    BLI_delete(filepath, false, false);
+    return;
+  }
+
+  /* Reuse the space of removed chunks at the end of the file (e.g. when clearing the frames after
+   * the current one). */
+  uint64_t chunks_end = sizeof(PTCacheContainerHeader);
+  for (const PTCacheContainerEntry &entry : index) {
+    chunks_end = std::max(chunks_end, entry.offset + entry.size);
+  }
+  if (!ptcache_container_index_write(fp, header, index, chunks_end)) {
+    CLOG_ERROR(&LOG, "Failed to update the frame index of \"%s\"", filepath);
+  }
+  fclose(fp);
+}
+
+/** \} */
+
+/**
+ * Caller must close after!
+ */
+static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
+{
+  char filepath[MAX_PTCACHE_FILE];
+
+#ifndef DURIAN_POINTCACHE_LIB_OK
+  /* don't allow writing for linked objects */
+  if (pid->owner_id->lib && mode == PTCACHE_FILE_WRITE) {
+    return nullptr;
+  }
+#endif
+  if ((pid->cache->flag & PTCACHE_EXTERNAL) == 0) {
+    const char *blendfile_path = BKE_main_blendfile_path_from_global();
+    if (blendfile_path[0] == '\0') {
+      return nullptr; /* save blend file before using disk pointcache */
+    }
+  }
+
+  if (ptcache_use_container(pid)) {
+    ptcache_container_filepath(pid, filepath);
+    if (mode == PTCACHE_FILE_READ) {
+      return ptcache_container_frame_open(filepath, cfra);
+    }
+    return ptcache_container_frame_append(filepath, cfra);
+  }
+
+  ptcache_filepath(pid, filepath, cfra, true, true);
+
+  return ptcache_file_open_path(filepath, mode, cfra);
+}
 static void ptcache_file_close(PTCacheFile *pf)
 {
   if (pf) {
+    if (pf->container_write) {
+      if (!ptcache_container_frame_append_end(pf)) {
+        CLOG_ERROR(&LOG, "Failed to update the frame index of a point cache container file");
+      }
+      MEM_delete(pf->container_write);
+    }
+    if (pf->mmap_file) {
+      std::lock_guard lock{ptcache_mmap_mutex};
+      BLI_mmap_free(pf->mmap_file);
+    }
     fclose(pf->fp);
     MEM_freeN(pf);
   }
@@ -1539,6 +1908,10 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        const size_t decompressed_len = ZSTD_decompress(result, len, in, in_len);
+        r = (ZSTD_isError(decompressed_len) || decompressed_len != len) ? 1 : 0;
+      }
       MEM_freeN(in);
     }
   }
@@ -1550,8 +1923,12 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
 
   return r;
 }
+/**
+ * \param out: Buffer for the compressed data of \a out_capacity bytes, at least
+ * `LZO_OUT_LEN(in_len)`. Data is written uncompressed when it doesn't fit.
+ */
 static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
+    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, size_t out_capacity, int mode)
 {
   int r = 0;
   uchar compressed = 0;
@@ -1600,6 +1977,15 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    out_len = ZSTD_compress(out, out_capacity, in, in_len, PTCACHE_ZSTD_LEVEL);
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = 3;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
@@ -1623,6 +2009,17 @@ static int ptcache_file_compressed_write(
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size)
 {
+  if (pf->mmap_file) {
+    const size_t len = size_t(tot) * size;
+    if (len == 0) {
+      return 1;
+    }
+    if (!BLI_mmap_read(pf->mmap_file, f, pf->mmap_offset, len)) {
+      return 0;
+    }
+    pf->mmap_offset += len;
+    return 1;
+  }
   return (fread(f, size, tot, pf->fp) == tot);
 }
 static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint size)
@@ -1664,7 +2061,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   pf->data_types = 0;
 
-  if (fread(bphysics, sizeof(char), 8, pf->fp) != 8) {
+  if (!ptcache_file_read(pf, bphysics, 8, sizeof(char))) {
     error = 1;
   }
 
@@ -1672,7 +2069,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
     error = 1;
   }
 
-  if (!error && !fread(&typeflag, sizeof(uint), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &typeflag, 1, sizeof(uint))) {
     error = 1;
   }
 
@@ -1681,7 +2078,8 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   /* if there was an error set file as it was */
   if (error) {
-    BLI_fseek(pf->fp, 0, SEEK_SET);
+    pf->mmap_offset = pf->frame_offset;
+    BLI_fseek(pf->fp, int64_t(pf->frame_offset), SEEK_SET);
   }
 
   return !error;
@@ -1932,21 +2330,22 @@ static void ptcache_find_frames_around(PTCacheID *pid, uint frame, int *r_fra1,
   }
 }
 
-static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
+/**
+ * Read a frame from an opened file, without access to the #PTCacheID so that it can be used
+ * from other threads. Closes the file.
+ */
+static PTCacheMem *ptcache_file_to_mem(PTCacheFile *pf,
+                                       const uint type,
+                                       int (*read_header)(PTCacheFile *pf))
 {
-  PTCacheFile *pf = ptcache_file_open(pid, PTCACHE_FILE_READ, cfra);
   PTCacheMem *pm = nullptr;
   uint i, error = 0;
 
-  if (pf == nullptr) {
-    return nullptr;
-  }
-
   if (!ptcache_file_header_begin_read(pf)) {
     error = 1;
   }
 
-  if (!error && (pf->type != pid->type || !pid->read_header(pf))) {
+  if (!error && (pf->type != type || !read_header(pf))) {
     error = 1;
   }
 
@@ -2023,6 +2422,363 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 
   return pm;
 }
+
+static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
+{
+  PTCacheFile *pf = ptcache_file_open(pid, PTCACHE_FILE_READ, cfra);
+
+  if (pf == nullptr) {
+    return nullptr;
+  }
+
+  return ptcache_file_to_mem(pf, pid->type, pid->read_header);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Decoded Frame Cache
+ *
+ * Frames of baked disk caches are stored in the global #memory_cache after decoding, and the
+ * frames following the one that is played back are read on a background thread.
+ * \{ */
+
+/** Number of cached frames after the current one that are read ahead during playback. */
+#define PTCACHE_PREFETCH_FRAMES 8
+
+namespace blender::bke {
+
+struct PointCacheRuntime {
+  /** Protects #prefetch_pool and #prefetched_until. */
+  std::mutex prefetch_mutex;
+  /** Reads the frames following the one that is played back. */
+  TaskPool *prefetch_pool = nullptr;
+  /** Last frame for which reading in the background was scheduled. */
+  std::optional<int> prefetched_until;
+};
+
+/** Identifies the contents of a cache file, so that a rewritten file is read again. */
+class PTCacheFrameKey : public GenericKey {
+ public:
+  std::string filepath;
+  /** Distinguishes the frames of a container file. */
+  int frame;
+  uint type;
+  int64_t size;
+  int64_t mtime;
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(get_default_hash(filepath, frame), type, size, mtime);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_5(PTCacheFrameKey, filepath, frame, type, size, mtime)
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const PTCacheFrameKey *>(&other)) {
+      return *this == *other_typed;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<PTCacheFrameKey>(*this);
+  }
+};
+
+class PTCacheFrameValue : public memory_cache::CachedValue {
+ public:
+  /** Null when the file could not be read. */
+  PTCacheMem *pm = nullptr;
+
+  ~PTCacheFrameValue() override
+  {
+    if (pm) {
+      ptcache_mem_clear(pm);
+      MEM_freeN(pm);
+    }
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    if (pm == nullptr) {
+      return;
+    }
+    for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+      if (pm->data[i]) {
+        memory.add(int64_t(pm->totpoint) * ptcache_data_size[i]);
+      }
+    }
+    LISTBASE_FOREACH (const PTCacheExtra *, extra, &pm->extradata) {
+      memory.add(int64_t(extra->totdata) * ptcache_extra_datasize[extra->type]);
+    }
+  }
+};
+
+struct PTCachePrefetchTask {
+  std::string filepath;
+  uint type;
+  int (*read_header)(PTCacheFile *pf);
+  int frame;
+  bool is_container;
+};
+
+static void ptcache_frame_read(PTCacheFrameValue &value,
+                               const char *filepath,
+                               const uint type,
+                               int (*read_header)(PTCacheFile *pf),
+                               const int frame,
+                               const bool is_container)
+{
+  PTCacheFile *pf = is_container ? ptcache_container_frame_open(filepath, frame) :
+                                   ptcache_file_open_path(filepath, PTCACHE_FILE_READ, frame);
+  if (pf) {
+    value.pm = ptcache_file_to_mem(pf, type, read_header);
+  }
+}
+
+static std::shared_ptr<const PTCacheFrameValue> ptcache_frame_read_cached(
+    const char *filepath,
+    const uint type,
+    int (*read_header)(PTCacheFile *pf),
+    const int frame,
+    const bool is_container)
+{
+  BLI_stat_t st;
+  if (BLI_stat(filepath, &st) != 0) {
+    return nullptr;
+  }
+
+  /* The modification time only has a resolution of a second, a file that is written again in the
+   * same second could not be told apart from the cached one. */
+  if (int64_t(st.st_mtime) >= int64_t(std::time(nullptr)) - 1) {
+    auto value = std::make_shared<PTCacheFrameValue>();
+    ptcache_frame_read(*value, filepath, type, read_header, frame, is_container);
+    return value->pm ? value : nullptr;
+  }
+
+  PTCacheFrameKey key;
+  key.filepath = filepath;
+  key.frame = frame;
+  key.type = type;
+  key.size = int64_t(st.st_size);
+  key.mtime = int64_t(st.st_mtime);
+
+  std::shared_ptr<const PTCacheFrameValue> cached = memory_cache::get<PTCacheFrameValue>(
+      key, [&]() {
+        auto value = std::make_unique<PTCacheFrameValue>();
+        ptcache_frame_read(*value, filepath, type, read_header, frame, is_container);
+        return value;
+      });
+  if (cached->pm == nullptr) {
+    /* Don't keep failed reads, the file may be complete when it is read again. */
+    memory_cache::remove_if([&](const GenericKey &other) { return key.equal_to(other); });
+    return nullptr;
+  }
+  return cached;
+}
+
+static void ptcache_prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  if (BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+  const PTCachePrefetchTask &task = *static_cast<const PTCachePrefetchTask *>(taskdata);
+  ptcache_frame_read_cached(
+      task.filepath.c_str(), task.type, task.read_header, task.frame, task.is_container);
+}
+
+static void ptcache_prefetch_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MEM_delete(static_cast<PTCachePrefetchTask *>(taskdata));
+}
+
+}  // namespace blender::bke
+
+/**
+ * Decoded frames are only kept for baked caches, other caches are mostly read right after the
+ * frame was simulated and written.
+ */
+static bool ptcache_use_frame_cache(const PTCacheID *pid)
+{
+  return (pid->cache->flag & PTCACHE_BAKED) && (pid->cache->flag & PTCACHE_DISK_CACHE);
+}
+
+static void ptcache_prefetch_schedule(PTCacheID *pid, const int cfra)
+{
+  using namespace blender::bke;
+  PointCache *cache = pid->cache;
+  const int step = std::max(int(cache->step), 1);
+  const int last_frame = std::min(cfra + step * PTCACHE_PREFETCH_FRAMES, cache->endframe);
+
+  static std::mutex runtime_mutex;
+  {
+    std::lock_guard lock{runtime_mutex};
+    if (cache->runtime == nullptr) {
+      cache->runtime = MEM_new<PointCacheRuntime>(__func__);
+    }
+  }
+  PointCacheRuntime &runtime = *cache->runtime;
+
+  std::lock_guard lock{runtime.prefetch_mutex};
+  const int first_frame = playback_prefetch_first_frame(
+      runtime.prefetched_until, cfra, last_frame);
+  if (first_frame > last_frame) {
+    return;
+  }
+
+  if (runtime.prefetch_pool == nullptr) {
+    runtime.prefetch_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  }
+  const bool is_container = ptcache_use_container(pid);
+  char filepath[MAX_PTCACHE_FILE];
+  if (is_container) {
+    ptcache_container_filepath(pid, filepath);
+  }
+  for (int frame = first_frame; frame <= last_frame; frame++) {
+    if (!BKE_ptcache_id_exist(pid, frame)) {
+      continue;
+    }
+    if (!is_container) {
+      ptcache_filepath(pid, filepath, frame, true, true);
+    }
+    PTCachePrefetchTask *task = MEM_new<PTCachePrefetchTask>(__func__);
+    task->filepath = filepath;
+    task->type = pid->type;
+    task->read_header = pid->read_header;
+    task->frame = frame;
+    task->is_container = is_container;
+    BLI_task_pool_push(
+        runtime.prefetch_pool, ptcache_prefetch_task_run, task, true, ptcache_prefetch_task_free);
+  }
+}
+
+/** Stop reading frames in the background, before the files are changed or the cache is freed. */
+static void ptcache_prefetch_cancel(PointCache *cache)
+{
+  blender::bke::PointCacheRuntime *runtime = cache->runtime;
+  if (runtime == nullptr) {
+    return;
+  }
+  std::lock_guard lock{runtime->prefetch_mutex};
+  runtime->prefetched_until.reset();
+  if (runtime->prefetch_pool == nullptr) {
+    return;
+  }
+  blender::threading::isolate_task([&]() {
+    BLI_task_pool_cancel(runtime->prefetch_pool);
+    BLI_task_pool_free(runtime->prefetch_pool);
+  });
+  runtime->prefetch_pool = nullptr;
+}
+
+/**
+ * Read a frame of a disk cache, from the decoded frame cache when possible.
+ * \param r_frame: Keeps the returned data alive when it is owned by the decoded frame cache,
+ * otherwise the caller has to free it.
+ */
+static PTCacheMem *ptcache_disk_frame_read(
+    PTCacheID *pid, int cfra, std::shared_ptr<const blender::bke::PTCacheFrameValue> &r_frame)
+{
+  if (!ptcache_use_frame_cache(pid)) {
+    return ptcache_disk_frame_to_mem(pid, cfra);
+  }
+  const bool is_container = ptcache_use_container(pid);
+  char filepath[MAX_PTCACHE_FILE];
+  if (is_container) {
+    ptcache_container_filepath(pid, filepath);
+  }
+  else {
+    ptcache_filepath(pid, filepath, cfra, true, true);
+  }
+  r_frame = blender::bke::ptcache_frame_read_cached(
+      filepath, pid->type, pid->read_header, cfra, is_container);
+  ptcache_prefetch_schedule(pid, cfra);
+  return r_frame ? r_frame->pm : nullptr;
+}
+
+/** Remove decoded frames of files that are about to be deleted or overwritten. */
+static void ptcache_disk_frames_forget(PTCacheID *pid, int mode, uint cfra)
+{
+  using namespace blender;
+  ptcache_prefetch_cancel(pid->cache);
+
+  char filepath[MAX_PTCACHE_FILE];
+  if (ptcache_use_container(pid)) {
+    ptcache_container_filepath(pid, filepath);
+    const StringRef container_filepath = filepath;
+    memory_cache::remove_if([&](const GenericKey &key) {
+      const auto *frame_key = dynamic_cast<const bke::PTCacheFrameKey *>(&key);
+      return frame_key && frame_key->filepath == container_filepath &&
+             (mode != PTCACHE_CLEAR_FRAME || frame_key->frame == int(cfra));
+    });
+    return;
+  }
+  if (mode == PTCACHE_CLEAR_FRAME) {
+    ptcache_filepath(pid, filepath, cfra, true, true);
+    const StringRef frame_filepath = filepath;
+    memory_cache::remove_if([&](const GenericKey &key) {
+      const auto *frame_key = dynamic_cast<const bke::PTCacheFrameKey *>(&key);
+      return frame_key && frame_key->filepath == frame_filepath;
+    });
+    return;
+  }
+
+  /* Forget all frames, the underscore avoids matching caches whose name has the same prefix. */
+  const int len = ptcache_filepath(pid, filepath, 0, true, false);
+  const std::string prefix = std::string(filepath, len) + "_";
+  memory_cache::remove_if([&](const GenericKey &key) {
+    const auto *frame_key = dynamic_cast<const bke::PTCacheFrameKey *>(&key);
+    return frame_key && StringRef(frame_key->filepath).startswith(prefix);
+  });
+}
+
+/** \} */
+/**
+ * Compress all data streams of a frame on multiple threads, then write them in the same layout
+ * as #ptcache_file_compressed_write.
+ */
+static void ptcache_file_zstd_write_data(PTCacheFile *pf, const PTCacheMem *pm)
+{
+  using namespace blender;
+  std::array<Vector<uchar>, BPHYS_TOT_DATA> compressed_data;
+  threading::parallel_for(IndexRange(BPHYS_TOT_DATA), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (pm->data[i] == nullptr) {
+        continue;
+      }
+      const size_t in_len = size_t(pm->totpoint) * ptcache_data_size[i];
+      Vector<uchar> &out = compressed_data[i];
+      out.resize(ZSTD_compressBound(in_len));
+      const size_t out_len = ZSTD_compress(
+          out.data(), out.size(), pm->data[i], in_len, PTCACHE_ZSTD_LEVEL);
+      if (ZSTD_isError(out_len) || out_len >= in_len) {
+        out.clear();
+      }
+      else {
+        out.resize(out_len);
+      }
+    }
+  });
+
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (pm->data[i] == nullptr) {
+      continue;
+    }
+    const Vector<uchar> &out = compressed_data[i];
+    uchar compressed = out.is_empty() ? 0 : 3;
+    ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
+    if (compressed) {
+      uint size = uint(out.size());
+      ptcache_file_write(pf, &size, 1, sizeof(uint));
+      ptcache_file_write(pf, out.data(), size, sizeof(uchar));
+    }
+    else {
+      ptcache_file_write(pf, pm->data[i], pm->totpoint, ptcache_data_size[i]);
+    }
+  }
+}
+
 static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 {
   PTCacheFile *pf = nullptr;
@@ -2057,13 +2813,17 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
   }
 
   if (!error) {
-    if (pid->cache->compression) {
+    if (pid->cache->compression == PTCACHE_COMPRESS_ZSTD) {
+      ptcache_file_zstd_write_data(pf, pm);
+    }
+    else if (pid->cache->compression) {
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+          const size_t out_capacity = LZO_OUT_LEN(in_len) * 4;
+          uchar *out = (uchar *)MEM_callocN(out_capacity, "pointcache_lzo_buffer");
           ptcache_file_compressed_write(
-              pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
+              pf, (uchar *)(pm->data[i]), in_len, out, out_capacity, pid->cache->compression);
           MEM_freeN(out);
         }
       }
@@ -2097,9 +2857,10 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
       if (pid->cache->compression) {
         uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+        const size_t out_capacity = LZO_OUT_LEN(in_len) * 4;
+        uchar *out = (uchar *)MEM_callocN(out_capacity, "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
-            pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
+            pf, (uchar *)(extra->data), in_len, out, out_capacity, pid->cache->compression);
         MEM_freeN(out);
       }
       else {
@@ -2168,12 +2929,13 @@ static int ptcache_read_stream(PTCacheID *pid, int cfra)
 static int ptcache_read(PTCacheID *pid, int cfra)
 {
   PTCacheMem *pm = nullptr;
+  std::shared_ptr<const blender::bke::PTCacheFrameValue> cached_frame;
   int i;
   int *index = &i;
 
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
-    pm = ptcache_disk_frame_to_mem(pid, cfra);
+    pm = ptcache_disk_frame_read(pid, cfra, cached_frame);
   }
   else {
     pm = static_cast<PTCacheMem *>(pid->cache->mem_cache.first);
@@ -2214,7 +2976,7 @@ static int ptcache_read(PTCacheID *pid, int cfra)
     }
 
     /* clean up temporary memory cache */
-    if (pid->cache->flag & PTCACHE_DISK_CACHE) {
+    if ((pid->cache->flag & PTCACHE_DISK_CACHE) && !cached_frame) {
       ptcache_mem_clear(pm);
       MEM_freeN(pm);
     }
@@ -2225,12 +2987,13 @@ static int ptcache_read(PTCacheID *pid, int cfra)
 static int ptcache_interpolate(PTCacheID *pid, float cfra, int cfra1, int cfra2)
 {
   PTCacheMem *pm = nullptr;
+  std::shared_ptr<const blender::bke::PTCacheFrameValue> cached_frame;
   int i;
   int *index = &i;
 
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
-    pm = ptcache_disk_frame_to_mem(pid, cfra2);
+    pm = ptcache_disk_frame_read(pid, cfra2, cached_frame);
   }
   else {
     pm = static_cast<PTCacheMem *>(pid->cache->mem_cache.first);
@@ -2271,7 +3034,7 @@ static int ptcache_interpolate(PTCacheID *pid, float cfra, int cfra1, int cfra2)
     }
 
     /* clean up temporary memory cache */
-    if (pid->cache->flag & PTCACHE_DISK_CACHE) {
+    if ((pid->cache->flag & PTCACHE_DISK_CACHE) && !cached_frame) {
       ptcache_mem_clear(pm);
       MEM_freeN(pm);
     }
@@ -2623,6 +3386,39 @@ void BKE_ptcache_id_clear(PTCacheID *pid, int mode, uint cfra)
   }
 #endif
 
+  if (pid->cache->flag & PTCACHE_DISK_CACHE) {
+    ptcache_disk_frames_forget(pid, mode, cfra);
+  }
+
+  if (ptcache_use_container(pid)) {
+    ptcache_container_filepath(pid, filepath);
+    if (mode == PTCACHE_CLEAR_ALL) {
+      if (BLI_exists(filepath)) {
+        pid->cache->last_exact = std::min(pid->cache->startframe, 0);
+        BLI_delete(filepath, false, false);
+      }
+      if (pid->cache->cached_frames) {
+        memset(pid->cache->cached_frames, 0, MEM_allocN_len(pid->cache->cached_frames));
+      }
+    }
+    else {
+      ptcache_container_frames_remove(filepath, [&](const int frame) {
+        const bool remove = (mode == PTCACHE_CLEAR_FRAME && frame == int(cfra)) ||
+                            (mode == PTCACHE_CLEAR_BEFORE && frame < int(cfra)) ||
+                            (mode == PTCACHE_CLEAR_AFTER && frame > int(cfra));
+        if (remove && pid->cache->cached_frames && frame >= int(sta) && frame <= int(end)) {
+          pid->cache->cached_frames[frame - sta] = 0;
+        }
+        return remove;
+      });
+      if (mode == PTCACHE_CLEAR_FRAME && pid->cache->cached_frames && cfra >= sta && cfra <= end) {
+        pid->cache->cached_frames[cfra - sta] = 0;
+      }
+    }
+    pid->cache->flag |= PTCACHE_FLAG_INFO_DIRTY;
+    return;
+  }
+
   /* Clear all files in the temp dir with the prefix of the ID and the `.bphys` suffix. */
   switch (mode) {
     case PTCACHE_CLEAR_ALL:
@@ -2761,6 +3557,11 @@ bool BKE_ptcache_id_exist(PTCacheID *pid, int cfra)
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
     char filepath[MAX_PTCACHE_FILE];
 
+    if (ptcache_use_container(pid)) {
+      ptcache_container_filepath(pid, filepath);
+      return ptcache_container_frame_exists(filepath, cfra);
+    }
+
     ptcache_filepath(pid, filepath, cfra, true, true);
 
     return BLI_exists(filepath);
@@ -2826,7 +3627,16 @@ void BKE_ptcache_id_time(
     cache->cached_frames = static_cast<char *>(
         MEM_callocN(sizeof(char) * cache->cached_frames_len, "cached frames array"));
 
-    if (pid->cache->flag & PTCACHE_DISK_CACHE) {
+    if (ptcache_use_container(pid)) {
+      char filepath[MAX_PTCACHE_FILE];
+      ptcache_container_filepath(pid, filepath);
+      for (const PTCacheContainerEntry &entry : ptcache_container_index_get(filepath)) {
+        if (entry.frame >= int(sta) && entry.frame <= int(end)) {
+          cache->cached_frames[entry.frame - sta] = 1;
+        }
+      }
+    }
+    else if (pid->cache->flag & PTCACHE_DISK_CACHE) {
       /* mode is same as fopen's modes */
       DIR *dir;
       dirent *de;
@@ -3046,6 +3856,8 @@ void BKE_ptcache_free_mem(ListBase *mem_cache)
 }
 void BKE_ptcache_free(PointCache *cache)
 {
+  ptcache_prefetch_cancel(cache);
+  MEM_delete(cache->runtime);
   BKE_ptcache_free_mem(&cache->mem_cache);
   if (cache->edit && cache->free_edit) {
     cache->free_edit(cache->edit);
@@ -3069,13 +3881,14 @@ static PointCache *ptcache_copy(PointCache *cache, const bool copy_data)
   ncache = static_cast<PointCache *>(MEM_dupallocN(cache));
 
   BLI_listbase_clear(&ncache->mem_cache);
+  ncache->runtime = nullptr;
 
   if (copy_data == false) {
     ncache->cached_frames = nullptr;
     ncache->cached_frames_len = 0;
 
     /* flag is a mix of user settings and simulator/baking state */
-    ncache->flag = ncache->flag & (PTCACHE_DISK_CACHE | PTCACHE_EXTERNAL | PTCACHE_IGNORE_LIBPATH);
+    ncache->flag = ncache->flag & PTCACHE_FLAGS_COPY;
     ncache->simframe = 0;
   }
   else {
@@ -3525,6 +4338,85 @@ void BKE_ptcache_toggle_disk_cache(PTCacheID *pid)
   }
 }
 
+void BKE_ptcache_toggle_disk_container(PTCacheID *pid)
+{
+  PointCache *cache = pid->cache;
+  if ((cache->flag & PTCACHE_DISK_CACHE) == 0 || (cache->flag & PTCACHE_EXTERNAL)) {
+    return;
+  }
+  if (BKE_main_blendfile_path_from_global()[0] == '\0') {
+    return;
+  }
+
+  char container_filepath[MAX_PTCACHE_FILE];
+  ptcache_container_filepath(pid, container_filepath);
+  ptcache_disk_frames_forget(pid, PTCACHE_CLEAR_ALL, 0);
+
+  char filepath[MAX_PTCACHE_FILE];
+  if (cache->flag & PTCACHE_DISK_CONTAINER) {
+    /* Move the files of all frames into the container, the chunks are copied unchanged. */
+    for (int cfra = std::min(cache->startframe, 0); cfra <= cache->endframe; cfra++) {
+      ptcache_filepath(pid, filepath, cfra, true, true);
+      if (!BLI_exists(filepath)) {
+        continue;
+      }
+      size_t size = 0;
+      void *data = BLI_file_read_binary_as_mem(filepath, 0, &size);
+      bool ok = false;
+      if (data) {
+        if (PTCacheFile *pf = ptcache_container_frame_append(container_filepath, cfra)) {
+          ok = size == 0 || ptcache_file_write(pf, data, 1, uint(size));
+          ptcache_file_close(pf);
+        }
+        MEM_freeN(data);
+      }
+      if (!ok) {
+        CLOG_ERROR(&LOG, "Failed to move \"%s\" into \"%s\"", filepath, container_filepath);
+        break;
+      }
+      BLI_delete(filepath, false, false);
+    }
+  }
+  else {
+    /* Write every chunk of the container to the file of its frame. */
+    bool ok = true;
+    FILE *fp = BLI_fopen(container_filepath, "rb");
+    if (fp) {
+      blender::Vector<char> chunk;
+      for (const PTCacheContainerEntry &entry : ptcache_container_index_get(container_filepath)) {
+        chunk.resize(int64_t(entry.size));
+        ptcache_filepath(pid, filepath, entry.frame, true, true);
+        FILE *frame_fp = nullptr;
+        ok = BLI_fseek(fp, int64_t(entry.offset), SEEK_SET) == 0 &&
+             fread(chunk.data(), 1, chunk.size(), fp) == size_t(chunk.size()) &&
+             (frame_fp = BLI_fopen(filepath, "wb")) != nullptr &&
+             fwrite(chunk.data(), 1, chunk.size(), frame_fp) == size_t(chunk.size());
+        if (frame_fp) {
+          ok = (fclose(frame_fp) == 0) && ok;
+        }
+        if (!ok) {
+          CLOG_ERROR(
+              &LOG, "Failed to move frame %d out of \"%s\"", entry.frame, container_filepath);
+          break;
+        }
+      }
+      fclose(fp);
+      if (ok) {
+        BLI_delete(container_filepath, false, false);
+      }
+    }
+  }
+
+  if (cache->cached_frames) {
+    MEM_freeN(cache->cached_frames);
+    cache->cached_frames = nullptr;
+    cache->cached_frames_len = 0;
+  }
+  BKE_ptcache_id_time(pid, nullptr, 0.0f, nullptr, nullptr, nullptr);
+
+  cache->flag |= PTCACHE_FLAG_INFO_DIRTY;
+}
+
 void BKE_ptcache_disk_cache_rename(PTCacheID *pid, const char *name_src, const char *name_dst)
 {
   char old_name[80];
@@ -3551,6 +4443,17 @@ void BKE_ptcache_disk_cache_rename(PTCacheID *pid, const char *name_src, const c
 
   len = ptcache_filepath(pid, old_filepath, 0, false, false); /* no path */
 
+  if (ptcache_use_container(pid)) {
+    char new_container_filepath[MAX_PTCACHE_FILE];
+    ptcache_container_filepath(pid, old_path_full);
+    STRNCPY(pid->cache->name, name_dst);
+    ptcache_container_filepath(pid, new_container_filepath);
+    STRNCPY(pid->cache->name, name_src);
+    if (BLI_exists(old_path_full)) {
+      BLI_rename_overwrite(old_path_full, new_container_filepath);
+    }
+  }
+
   ptcache_path(pid, path);
   dir = opendir(path);
   if (dir == nullptr) {
@@ -3736,6 +4639,17 @@ void BKE_ptcache_update_info(PTCacheID *pid)
         SNPRINTF(mem_info, RPT_("%i cells cached"), totpoint);
       }
     }
+    else if (ptcache_use_container(pid)) {
+      char filepath[MAX_PTCACHE_FILE];
+      ptcache_container_filepath(pid, filepath);
+      for (const PTCacheContainerEntry &entry : ptcache_container_index_get(filepath)) {
+        if (entry.frame >= cache->startframe && entry.frame <= cache->endframe) {
+          totframes++;
+        }
+      }
+
+      SNPRINTF(mem_info, RPT_("%i frames on disk"), totframes);
+    }
     else {
       int cfra = cache->startframe;
 
@@ -3895,6 +4809,7 @@ static void direct_link_pointcache(BlendDataReader *reader, PointCache *cache)
   cache->free_edit = nullptr;
   cache->cached_frames = nullptr;
   cache->cached_frames_len = 0;
+  cache->runtime = nullptr;
 }
 
 void BKE_ptcache_blend_read_data(BlendDataReader *reader,
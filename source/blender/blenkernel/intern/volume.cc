@@ -464,6 +464,17 @@ bool BKE_volume_set_velocity_grid_by_name(Volume *volume, const char *base_name)
   return false;
 }
 
+#ifdef WITH_OPENVDB
+/** Bounds that limit which part of the grids is read from the file. */
+static std::optional<blender::Bounds<float3>> volume_load_bounds(const Volume *volume)
+{
+  if ((volume->flag & VO_USE_LOAD_BOUNDS) == 0) {
+    return std::nullopt;
+  }
+  return blender::Bounds<float3>(float3(volume->load_bounds_min), float3(volume->load_bounds_max));
+}
+#endif
+
 bool BKE_volume_load(const Volume *volume, const Main *bmain)
 {
 #ifdef WITH_OPENVDB
@@ -503,7 +514,8 @@ bool BKE_volume_load(const Volume *volume, const Main *bmain)
   }
 
   blender::bke::volume_grid::file_cache::GridsFromFile grids_from_file =
-      blender::bke::volume_grid::file_cache::get_all_grids_from_file(filepath, 0);
+      blender::bke::volume_grid::file_cache::get_all_grids_from_file(
+          filepath, 0, volume_load_bounds(volume));
 
   if (!grids_from_file.error_message.empty()) {
     grids.error_msg = grids_from_file.error_message;
@@ -541,6 +553,9 @@ void BKE_volume_unload(Volume *volume)
     const char *volume_name = volume->id.name + 2;
     CLOG_INFO(&LOG, 1, "Volume %s: unload", volume_name);
     grids.clear_all();
+    /* Free the cached meta-data of files that are not used anymore, e.g. for previous frames of
+     * sequences. */
+    blender::bke::volume_grid::file_cache::unload_unused();
   }
 #else
   UNUSED_VARS(volume);
@@ -674,10 +689,11 @@ static void volume_update_simplify_level(Main *bmain, Volume *volume, const Deps
   /* Replace grids with the new simplify level variants from the cache. */
   if (BKE_volume_load(volume, bmain)) {
     VolumeGridVector &grids = *volume->runtime->grids;
+    const std::optional<blender::Bounds<float3>> load_bounds = volume_load_bounds(volume);
     std::list<GVolumeGrid> new_grids;
     for (const GVolumeGrid &old_grid : grids) {
       GVolumeGrid simple_grid = blender::bke::volume_grid::file_cache::get_grid_from_file(
-          grids.filepath, old_grid->name(), simplify_level);
+          grids.filepath, old_grid->name(), simplify_level, load_bounds);
       BLI_assert(simple_grid);
       new_grids.push_back(std::move(simple_grid));
     }
@@ -10,11 +10,49 @@
 #  include "BLI_map.hh"
 #  include "BLI_memory_cache.hh"
 #  include "BLI_memory_counter.hh"
+#  include "BLI_struct_equality_utils.hh"
+
+#  include <atomic>
 
 #  include <openvdb/openvdb.h>
 
 namespace blender::bke::volume_grid::file_cache {
 
+/**
+ * Determines which variant of a grid is loaded.
+ */
+struct GridVariant {
+  int simplify_level = 0;
+  bool use_clip = false;
+  float3 clip_min = float3(0.0f);
+  float3 clip_max = float3(0.0f);
+
+  GridVariant() = default;
+  GridVariant(const int simplify_level, const std::optional<Bounds<float3>> &clip_bounds)
+      : simplify_level(simplify_level), use_clip(clip_bounds.has_value())
+  {
+    if (clip_bounds) {
+      this->clip_min = clip_bounds->min;
+      this->clip_max = clip_bounds->max;
+    }
+  }
+
+  std::optional<Bounds<float3>> clip_bounds() const
+  {
+    if (!this->use_clip) {
+      return std::nullopt;
+    }
+    return Bounds<float3>(this->clip_min, this->clip_max);
+  }
+
+  uint64_t hash() const
+  {
+    return get_default_hash(this->simplify_level, this->use_clip, this->clip_min, this->clip_max);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_4(GridVariant, simplify_level, use_clip, clip_min, clip_max)
+};
+
 /**
  * Cache for a single grid stored in a file.
  */
@@ -25,9 +63,9 @@ struct GridCache {
    */
   openvdb::GridBase::Ptr meta_data_grid;
   /**
-   * Cached simplify levels.
+   * Cached simplify levels and clipped variants.
    */
-  Map<int, GVolumeGrid> grid_by_simplify_level;
+  Map<GridVariant, GVolumeGrid> grid_by_variant;
 };
 
 /**
@@ -66,6 +104,19 @@ struct GlobalCache {
   Map<std::string, FileCache> file_map;
 };
 
+/**
+ * Counters for #CacheStatistics. These are not part of #GlobalCache, because trees can still be
+ * freed by the memory cache while static objects are destructed at exit. The counters are constant
+ * initialized and trivially destructible, so they are valid during that whole time.
+ */
+struct CacheCounters {
+  std::atomic<int64_t> trees_num = 0;
+  std::atomic<int64_t> trees_bytes = 0;
+  std::atomic<int64_t> hits_num = 0;
+  std::atomic<int64_t> misses_num = 0;
+};
+static CacheCounters cache_counters;
+
 /**
  * Uses the "construct on first use" idiom to get the cache.
  */
@@ -134,14 +185,14 @@ class GridReadKey : public GenericKey {
  public:
   std::string file_path;
   std::string grid_name;
-  int simplify_level;
+  GridVariant variant;
 
   uint64_t hash() const override
   {
-    return get_default_hash(this->file_path, this->grid_name, this->simplify_level);
+    return get_default_hash(this->file_path, this->grid_name, this->variant);
   }
 
-  BLI_STRUCT_EQUALITY_OPERATORS_3(GridReadKey, file_path, grid_name, simplify_level)
+  BLI_STRUCT_EQUALITY_OPERATORS_3(GridReadKey, file_path, grid_name, variant)
 
   bool equal_to(const GenericKey &other) const override
   {
@@ -159,28 +210,42 @@ class GridReadKey : public GenericKey {
 
 class GridReadValue : public memory_cache::CachedValue {
  private:
-  mutable std::atomic<int64_t> bytes_ = 0;
+  int64_t bytes_ = 0;
 
  public:
   ImplicitSharingPtr<> tree_sharing_info;
   openvdb::GridBase::Ptr grid;
 
-  void count_memory(MemoryCounter &memory) const override
+  GridReadValue(openvdb::GridBase::Ptr grid_) : grid(std::move(grid_))
   {
+    this->tree_sharing_info = OpenvdbTreeSharingInfo::make(this->grid->baseTreePtr());
     /* Avoid computing the amount of memory from scratch every time. */
-    if (bytes_ == 0) {
-      this->bytes_ = grid->baseTree().memUsage();
-    }
+    bytes_ = int64_t(this->grid->baseTree().memUsage());
+    cache_counters.trees_num.fetch_add(1, std::memory_order_relaxed);
+    cache_counters.trees_bytes.fetch_add(bytes_, std::memory_order_relaxed);
+  }
+
+  ~GridReadValue() override
+  {
+    cache_counters.trees_num.fetch_sub(1, std::memory_order_relaxed);
+    cache_counters.trees_bytes.fetch_sub(bytes_, std::memory_order_relaxed);
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
     memory.add(bytes_);
   }
 };
 
 /**
  * Load a single grid by name from a file. This loads the full grid including meta-data, transforms
- * and the tree.
+ * and the tree. With clip bounds, the topology of the tree is read completely, but only the
+ * buffers of leaf nodes that intersect the bounds are read, and the tree is clipped afterwards.
  */
-static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_path,
-                                                         const StringRef grid_name)
+static openvdb::GridBase::Ptr load_single_grid_from_disk(
+    const StringRef file_path,
+    const StringRef grid_name,
+    const std::optional<Bounds<float3>> &clip_bounds)
 {
   /* Disable delay loading and file copying, this has poor performance
    * on network drivers. */
@@ -191,6 +256,12 @@ static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_pa
   file.setCopyMaxBytes(0);
 #  endif
   file.open(delay_load);
+  if (clip_bounds) {
+    const openvdb::BBoxd bbox{
+        openvdb::Vec3d(clip_bounds->min.x, clip_bounds->min.y, clip_bounds->min.z),
+        openvdb::Vec3d(clip_bounds->max.x, clip_bounds->max.y, clip_bounds->max.z)};
+    return file.readGrid(grid_name, bbox);
+  }
   return file.readGrid(grid_name);
 }
 
@@ -200,32 +271,36 @@ static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_pa
  */
 static LazyLoadedGrid load_single_grid_from_disk_cached(const StringRef file_path,
                                                         const StringRef grid_name,
-                                                        const int simplify_level)
+                                                        const GridVariant &variant)
 {
   GridReadKey key;
   key.file_path = file_path;
   key.grid_name = grid_name;
-  key.simplify_level = simplify_level;
+  key.variant = variant;
 
-  std::shared_ptr<const GridReadValue> value = memory_cache::get<GridReadValue>(key, [&key]() {
+  bool is_miss = false;
+  std::shared_ptr<const GridReadValue> value = memory_cache::get<GridReadValue>(key, [&]() {
+    is_miss = true;
     openvdb::GridBase::Ptr grid;
-    if (key.simplify_level == 0) {
-      grid = load_single_grid_from_disk(key.file_path, key.grid_name);
+    if (key.variant.simplify_level == 0) {
+      grid = load_single_grid_from_disk(key.file_path, key.grid_name, key.variant.clip_bounds());
     }
     else {
-      /* Build the simplified grid from the main grid. */
-      const GVolumeGrid main_grid = get_grid_from_file(key.file_path, key.grid_name, 0);
+      /* VDB files only store the full resolution, so the simplified grid is built from the main
+       * grid, which is clipped in the same way. The full resolution tree is read and cached for
+       * that, even if only the simplified grid is used. */
+      const GVolumeGrid main_grid = get_grid_from_file(
+          key.file_path, key.grid_name, 0, key.variant.clip_bounds());
       const VolumeGridType grid_type = main_grid->grid_type();
-      const float resolution_factor = 1.0f / (1 << key.simplify_level);
+      const float resolution_factor = 1.0f / (1 << key.variant.simplify_level);
       VolumeTreeAccessToken tree_token;
       grid = BKE_volume_grid_create_with_changed_resolution(
           grid_type, main_grid->grid(tree_token), resolution_factor);
     }
-    auto value = std::make_unique<GridReadValue>();
-    value->grid = std::move(grid);
-    value->tree_sharing_info = OpenvdbTreeSharingInfo::make(value->grid->baseTreePtr());
-    return value;
+    return std::make_unique<GridReadValue>(std::move(grid));
   });
+  (is_miss ? cache_counters.misses_num : cache_counters.hits_num)
+      .fetch_add(1, std::memory_order_relaxed);
   if (!value) {
     return {};
   }
@@ -242,21 +317,21 @@ static LazyLoadedGrid load_single_grid_from_disk_cached(const StringRef file_pat
  */
 static GVolumeGrid get_cached_grid(const StringRef file_path,
                                    GridCache &grid_cache,
-                                   const int simplify_level)
+                                   const GridVariant &variant)
 {
-  if (GVolumeGrid *grid = grid_cache.grid_by_simplify_level.lookup_ptr(simplify_level)) {
+  if (GVolumeGrid *grid = grid_cache.grid_by_variant.lookup_ptr(variant)) {
     return *grid;
   }
   /* A callback that actually loads the full grid including the tree when it's accessed. */
   auto load_grid_fn = [file_path = std::string(file_path),
                        grid_name = std::string(grid_cache.meta_data_grid->getName()),
-                       simplify_level]() -> LazyLoadedGrid {
-    return load_single_grid_from_disk_cached(file_path, grid_name, simplify_level);
+                       variant]() -> LazyLoadedGrid {
+    return load_single_grid_from_disk_cached(file_path, grid_name, variant);
   };
   /* This allows the returned grid to already contain meta-data and transforms, even if the tree is
    * not loaded yet. */
   openvdb::GridBase::Ptr meta_data_and_transform_grid;
-  if (simplify_level == 0) {
+  if (variant.simplify_level == 0) {
     /* Only pass the meta-data grid when there is no simplification for now. For simplified grids,
      * the transform would have to be updated here already. */
     meta_data_and_transform_grid = grid_cache.meta_data_grid->copyGrid();
@@ -264,24 +339,27 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
   VolumeGridData *grid_data = MEM_new<VolumeGridData>(
       __func__, load_grid_fn, meta_data_and_transform_grid);
   GVolumeGrid grid{grid_data};
-  grid_cache.grid_by_simplify_level.add(simplify_level, grid);
+  grid_cache.grid_by_variant.add(variant, grid);
   return grid;
 }
 
 GVolumeGrid get_grid_from_file(const StringRef file_path,
                                const StringRef grid_name,
-                               const int simplify_level)
+                               const int simplify_level,
+                               const std::optional<Bounds<float3>> &clip_bounds)
 {
   GlobalCache &global_cache = get_global_cache();
   std::lock_guard lock{global_cache.mutex};
   FileCache &file_cache = get_file_cache(file_path);
   if (GridCache *grid_cache = file_cache.grid_cache_by_name(grid_name)) {
-    return get_cached_grid(file_path, *grid_cache, simplify_level);
+    return get_cached_grid(file_path, *grid_cache, GridVariant(simplify_level, clip_bounds));
   }
   return {};
 }
 
-GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simplify_level)
+GridsFromFile get_all_grids_from_file(const StringRef file_path,
+                                      const int simplify_level,
+                                      const std::optional<Bounds<float3>> &clip_bounds)
 {
   GridsFromFile result;
   GlobalCache &global_cache = get_global_cache();
@@ -293,8 +371,9 @@ GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simpl
     return result;
   }
   result.file_meta_data = std::make_shared<openvdb::MetaMap>(file_cache.meta_data);
+  const GridVariant variant(simplify_level, clip_bounds);
   for (GridCache &grid_cache : file_cache.grids) {
-    result.grids.append(get_cached_grid(file_path, grid_cache, simplify_level));
+    result.grids.append(get_cached_grid(file_path, grid_cache, variant));
   }
   return result;
 }
@@ -303,12 +382,33 @@ void unload_unused()
 {
   GlobalCache &global_cache = get_global_cache();
   std::lock_guard lock{global_cache.mutex};
-  for (FileCache &file_cache : global_cache.file_map.values()) {
-    for (GridCache &grid_cache : file_cache.grids) {
-      grid_cache.grid_by_simplify_level.remove_if(
+  /* Files of volume sequences are only used for a single frame, so their meta-data is freed too.
+   * The trees stay in the memory cache and don't have to be read again when the file is used
+   * again later. */
+  global_cache.file_map.remove_if([&](auto file_item) {
+    bool is_used = false;
+    for (GridCache &grid_cache : file_item.value.grids) {
+      grid_cache.grid_by_variant.remove_if(
           [&](const auto &item) { return item.value->is_mutable(); });
+      is_used |= !grid_cache.grid_by_variant.is_empty();
     }
+    return !is_used;
+  });
+}
+
+CacheStatistics get_statistics()
+{
+  GlobalCache &global_cache = get_global_cache();
+  CacheStatistics statistics;
+  {
+    std::lock_guard lock{global_cache.mutex};
+    statistics.files_num = global_cache.file_map.size();
   }
+  statistics.trees_num = cache_counters.trees_num.load(std::memory_order_relaxed);
+  statistics.trees_bytes = cache_counters.trees_bytes.load(std::memory_order_relaxed);
+  statistics.hits_num = cache_counters.hits_num.load(std::memory_order_relaxed);
+  statistics.misses_num = cache_counters.misses_num.load(std::memory_order_relaxed);
+  return statistics;
 }
 
 }  // namespace blender::bke::volume_grid::file_cache
@@ -59,6 +59,14 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len) ATTR_WARN_UN
     ATTR_NONNULL();
 /** Create #FileReader from applying `Zstd` decompression on an underlying file. */
 FileReader *BLI_filereader_new_zstd(FileReader *base) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+/**
+ * Same as #BLI_filereader_new_zstd, but when the file has a seek table, the frames following the
+ * read position are decompressed ahead of time on the task scheduler. At most `readahead_frames`
+ * decompressed frames are kept in memory. Files without a seek table are read as a stream.
+ */
+FileReader *BLI_filereader_new_zstd_parallel(FileReader *base,
+                                             int readahead_frames) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL();
 /** Create #FileReader from applying `Gzip` decompression on an underlying file. */
 FileReader *BLI_filereader_new_gzip(FileReader *base) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 
@@ -25,6 +25,10 @@ typedef struct BLI_mmap_file BLI_mmap_file;
  * May return NULL if the operation fails.
  * Note that this seeks to the end of the file to determine its length. */
 BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+/* Same as #BLI_mmap_open, but optionally maps the file copy-on-write. Writing to the memory
+ * returned by #BLI_mmap_get_pointer then creates private copies of the touched pages and never
+ * modifies the file. */
+BLI_mmap_file *BLI_mmap_open_ex(int fd, bool copy_on_write) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 
 /* Reads length bytes from file at the given offset into dest.
  * Returns whether the operation was successful (may fail when reading beyond the file
@@ -11,6 +11,8 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
@@ -18,6 +20,23 @@
 
 #include "MEM_guardedalloc.h"
 
+typedef enum eZstdFrameSlotState {
+  ZSTD_SLOT_EMPTY = 0,
+  /** A task to decompress the frame has been pushed, but did not start yet. */
+  ZSTD_SLOT_QUEUED,
+  /** The frame is being decompressed, either by a worker or by the reading thread. */
+  ZSTD_SLOT_RUNNING,
+  /** Decompression finished, `data` is NULL if it failed. */
+  ZSTD_SLOT_DONE,
+} eZstdFrameSlotState;
+
+/** One entry of the read-ahead window, frame `i` always uses slot `i % window`. */
+typedef struct ZstdFrameSlot {
+  int frame;
+  eZstdFrameSlotState state;
+  char *data;
+} ZstdFrameSlot;
+
 typedef struct {
   FileReader reader;
 
@@ -35,8 +54,28 @@ typedef struct {
     char *cached_content;
     int cached_frame;
   } seek;
+
+  /**
+   * Decompression of the frames following the current read position on the task scheduler.
+   * Only used for seekable files, disabled when `window` is zero.
+   */
+  struct {
+    int window;
+    ZstdFrameSlot *slots;
+    TaskPool *pool;
+    /** Protects the slots. */
+    ThreadMutex mutex;
+    /** Signaled whenever a slot leaves the #ZSTD_SLOT_RUNNING state. */
+    ThreadCondition cond;
+    /** The base #FileReader is not thread-safe, serialize its seek & read calls. */
+    ThreadMutex base_mutex;
+  } readahead;
 } ZstdReader;
 
+typedef struct ZstdReadAheadTask {
+  int frame;
+} ZstdReadAheadTask;
+
 static bool zstd_read_u32(FileReader *base, uint32_t *val)
 {
   if (base->read(base, val, sizeof(uint32_t)) != sizeof(uint32_t)) {
@@ -157,16 +196,11 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+/* Read and decompress a single frame, returns NULL on failure.
+ * The context is passed in so that worker threads can use their own one. */
+static char *zstd_decompress_frame(ZstdReader *zstd, ZSTD_DCtx *ctx, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
-  }
-
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  const bool use_lock = zstd->readahead.window > 0;
 
   size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
   size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
@@ -174,22 +208,152 @@ static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
-  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
-      zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
-  {
+
+  if (use_lock) {
+    BLI_mutex_lock(&zstd->readahead.base_mutex);
+  }
+  const bool read_ok =
+      zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) >= 0 &&
+      zstd->base->read(zstd->base, compressed_data, compressed_size) >= compressed_size;
+  if (use_lock) {
+    BLI_mutex_unlock(&zstd->readahead.base_mutex);
+  }
+
+  if (!read_ok) {
     MEM_freeN(compressed_data);
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
   size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+      ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
   MEM_freeN(compressed_data);
   if (ZSTD_isError(res) || res < uncompressed_size) {
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
+  return uncompressed_data;
+}
+
+static void zstd_readahead_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  ZstdReader *zstd = BLI_task_pool_user_data(pool);
+  const ZstdReadAheadTask *task = taskdata;
+  ZstdFrameSlot *slot = &zstd->readahead.slots[task->frame % zstd->readahead.window];
+
+  BLI_mutex_lock(&zstd->readahead.mutex);
+  if (slot->frame != task->frame || slot->state != ZSTD_SLOT_QUEUED) {
+    /* The frame was either claimed by the reading thread already,
+     * or it went out of the window before this task started. */
+    BLI_mutex_unlock(&zstd->readahead.mutex);
+    return;
+  }
+  slot->state = ZSTD_SLOT_RUNNING;
+  BLI_mutex_unlock(&zstd->readahead.mutex);
+
+  ZSTD_DCtx *ctx = ZSTD_createDCtx();
+  char *data = zstd_decompress_frame(zstd, ctx, task->frame);
+  ZSTD_freeDCtx(ctx);
+
+  BLI_mutex_lock(&zstd->readahead.mutex);
+  slot->data = data;
+  slot->state = ZSTD_SLOT_DONE;
+  BLI_condition_notify_all(&zstd->readahead.cond);
+  BLI_mutex_unlock(&zstd->readahead.mutex);
+}
+
+/* Make sure that all frames in the window starting at `frame` are either decompressed or queued.
+ * Must be called with the read-ahead mutex locked, returns the number of frames that still
+ * need a task in `r_frames`. Pushing is left to the caller, since tasks may run immediately. */
+static int zstd_readahead_schedule(ZstdReader *zstd, int frame, int *r_frames)
+{
+  const int window = zstd->readahead.window;
+  const int end_frame = min_ii(frame + window, zstd->seek.frames_num);
+  int frames_num = 0;
+
+  for (int i = frame; i < end_frame; i++) {
+    ZstdFrameSlot *slot = &zstd->readahead.slots[i % window];
+    if (slot->frame == i) {
+      continue;
+    }
+    /* The slot holds a frame from outside the window. A running task still writes into it,
+     * so wait for it to finish before reusing the slot. */
+    while (slot->state == ZSTD_SLOT_RUNNING) {
+      BLI_condition_wait(&zstd->readahead.cond, &zstd->readahead.mutex);
+    }
+    MEM_SAFE_FREE(slot->data);
+    slot->frame = i;
+    slot->state = ZSTD_SLOT_QUEUED;
+    r_frames[frames_num++] = i;
+  }
+
+  return frames_num;
+}
+
+static char *zstd_readahead_take_frame(ZstdReader *zstd, int frame)
+{
+  int *frames_to_push = MEM_malloc_arrayN(zstd->readahead.window, sizeof(int), __func__);
+
+  BLI_mutex_lock(&zstd->readahead.mutex);
+  const int frames_to_push_num = zstd_readahead_schedule(zstd, frame, frames_to_push);
+
+  ZstdFrameSlot *slot = &zstd->readahead.slots[frame % zstd->readahead.window];
+  BLI_assert(slot->frame == frame);
+
+  char *data = NULL;
+  if (slot->state == ZSTD_SLOT_QUEUED) {
+    /* No worker picked up the frame we need right now, decompress it on this thread rather
+     * than waiting. This also avoids a dead-lock when there are no worker threads. */
+    slot->state = ZSTD_SLOT_RUNNING;
+    BLI_mutex_unlock(&zstd->readahead.mutex);
+    data = zstd_decompress_frame(zstd, zstd->ctx, frame);
+    BLI_mutex_lock(&zstd->readahead.mutex);
+  }
+  else {
+    while (slot->state == ZSTD_SLOT_RUNNING) {
+      BLI_condition_wait(&zstd->readahead.cond, &zstd->readahead.mutex);
+    }
+    data = slot->data;
+  }
+  /* Ownership of the data moves to the frame cache, the slot can be reused. */
+  slot->frame = -1;
+  slot->data = NULL;
+  slot->state = ZSTD_SLOT_EMPTY;
+  BLI_mutex_unlock(&zstd->readahead.mutex);
+
+  for (int i = 0; i < frames_to_push_num; i++) {
+    if (frames_to_push[i] == frame) {
+      continue;
+    }
+    ZstdReadAheadTask *task = MEM_mallocN(sizeof(ZstdReadAheadTask), __func__);
+    task->frame = frames_to_push[i];
+    BLI_task_pool_push(zstd->readahead.pool, zstd_readahead_task_run, task, true, NULL);
+  }
+  MEM_freeN(frames_to_push);
+
+  return data;
+}
+
+/* Ensure that the currently loaded frame is the correct one. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  if (zstd->seek.cached_frame == frame) {
+    /* Cached frame matches, so just return it. */
+    return zstd->seek.cached_content;
+  }
+
+  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
+  MEM_SAFE_FREE(zstd->seek.cached_content);
+  zstd->seek.cached_frame = -1;
+
+  char *uncompressed_data = (zstd->readahead.window > 0) ?
+                                zstd_readahead_take_frame(zstd, frame) :
+                                zstd_decompress_frame(zstd, zstd->ctx, frame);
+  if (uncompressed_data == NULL) {
+    return NULL;
+  }
+
   zstd->seek.cached_frame = frame;
   zstd->seek.cached_content = uncompressed_data;
   return uncompressed_data;
@@ -277,10 +441,55 @@ static int64_t zstd_read(FileReader *reader, void *buffer, size_t size)
   return output.pos;
 }
 
+static void zstd_readahead_init(ZstdReader *zstd, int window)
+{
+  zstd->readahead.window = window;
+  zstd->readahead.slots = MEM_malloc_arrayN(window, sizeof(ZstdFrameSlot), __func__);
+  for (int i = 0; i < window; i++) {
+    zstd->readahead.slots[i].frame = -1;
+    zstd->readahead.slots[i].state = ZSTD_SLOT_EMPTY;
+    zstd->readahead.slots[i].data = NULL;
+  }
+  zstd->readahead.pool = BLI_task_pool_create(zstd, TASK_PRIORITY_HIGH);
+  BLI_mutex_init(&zstd->readahead.mutex);
+  BLI_condition_init(&zstd->readahead.cond);
+  BLI_mutex_init(&zstd->readahead.base_mutex);
+}
+
+static void zstd_readahead_free(ZstdReader *zstd)
+{
+  /* Drop frames that did not start yet, their tasks will return immediately. */
+  BLI_mutex_lock(&zstd->readahead.mutex);
+  for (int i = 0; i < zstd->readahead.window; i++) {
+    ZstdFrameSlot *slot = &zstd->readahead.slots[i];
+    if (slot->state == ZSTD_SLOT_QUEUED) {
+      slot->frame = -1;
+      slot->state = ZSTD_SLOT_EMPTY;
+    }
+  }
+  BLI_mutex_unlock(&zstd->readahead.mutex);
+
+  BLI_task_pool_work_and_wait(zstd->readahead.pool);
+  BLI_task_pool_free(zstd->readahead.pool);
+
+  for (int i = 0; i < zstd->readahead.window; i++) {
+    MEM_SAFE_FREE(zstd->readahead.slots[i].data);
+  }
+  MEM_freeN(zstd->readahead.slots);
+
+  BLI_mutex_end(&zstd->readahead.mutex);
+  BLI_condition_end(&zstd->readahead.cond);
+  BLI_mutex_end(&zstd->readahead.base_mutex);
+}
+
 static void zstd_close(FileReader *reader)
 {
   ZstdReader *zstd = (ZstdReader *)reader;
 
+  if (zstd->readahead.window > 0) {
+    zstd_readahead_free(zstd);
+  }
+
   ZSTD_freeDCtx(zstd->ctx);
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
@@ -299,6 +508,11 @@ static void zstd_close(FileReader *reader)
 }
 
 FileReader *BLI_filereader_new_zstd(FileReader *base)
+{
+  return BLI_filereader_new_zstd_parallel(base, 0);
+}
+
+FileReader *BLI_filereader_new_zstd_parallel(FileReader *base, int readahead_frames)
 {
   ZstdReader *zstd = MEM_callocN(sizeof(ZstdReader), __func__);
 
@@ -308,6 +522,12 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
   if (zstd_read_seek_table(zstd)) {
     zstd->reader.read = zstd_read_seekable;
     zstd->reader.seek = zstd_seek;
+
+    /* Reading ahead only pays off when there is more than one frame. */
+    const int window = min_ii(readahead_frames, zstd->seek.frames_num);
+    if (window > 1) {
+      zstd_readahead_init(zstd, window);
+    }
   }
   else {
     zstd->reader.read = zstd_read;
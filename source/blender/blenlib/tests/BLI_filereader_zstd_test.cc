@@ -0,0 +1,119 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <zstd.h>
+
+#include "BLI_filereader.h"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+static void append_u32_le(Vector<char> &data, const uint32_t value)
+{
+  for (int i = 0; i < 4; i++) {
+    data.append(char((value >> (i * 8)) & 0xff));
+  }
+}
+
+/**
+ * Compress `uncompressed` into independent frames of `frame_size` bytes, followed by a seek table
+ * in the same layout as written by `writefile.cc`.
+ */
+static Vector<char> compress_seekable(const Span<char> uncompressed, const int64_t frame_size)
+{
+  Vector<char> result;
+  Vector<std::pair<uint32_t, uint32_t>> frames;
+
+  for (int64_t start = 0; start < uncompressed.size(); start += frame_size) {
+    const Span<char> frame = uncompressed.slice(
+        start, std::min(frame_size, uncompressed.size() - start));
+    Vector<char> compressed(ZSTD_compressBound(frame.size()));
+    const size_t compressed_size = ZSTD_compress(
+        compressed.data(), compressed.size(), frame.data(), frame.size(), 3);
+    EXPECT_FALSE(ZSTD_isError(compressed_size));
+    result.extend(compressed.as_span().take_front(compressed_size));
+    frames.append({uint32_t(compressed_size), uint32_t(frame.size())});
+  }
+
+  append_u32_le(result, 0x184D2A5E);
+  append_u32_le(result, frames.size() * 8 + 9);
+  for (const std::pair<uint32_t, uint32_t> &frame : frames) {
+    append_u32_le(result, frame.first);
+    append_u32_le(result, frame.second);
+  }
+  append_u32_le(result, frames.size());
+  result.append(0);
+  append_u32_le(result, 0x8F92EAB1);
+
+  return result;
+}
+
+static Vector<char> test_data(const int64_t size)
+{
+  Vector<char> data(size);
+  uint32_t state = 1;
+  for (const int64_t i : data.index_range()) {
+    /* Mix of repeating and pseudo-random content, so that frames compress differently. */
+    state = state * 1664525u + 1013904223u;
+    data[i] = (i % 3 == 0) ? char(state >> 24) : char(i / 7);
+  }
+  return data;
+}
+
+TEST(filereader_zstd, ParallelSequentialRead)
+{
+  const Vector<char> uncompressed = test_data(1000000);
+  const Vector<char> compressed = compress_seekable(uncompressed, 4096);
+
+  FileReader *reader = BLI_filereader_new_zstd_parallel(
+      BLI_filereader_new_memory(compressed.data(), compressed.size()), 8);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_NE(reader->seek, nullptr);
+
+  Vector<char> result(uncompressed.size());
+  /* Read in pieces that don't line up with the frames. */
+  int64_t offset = 0;
+  while (offset < result.size()) {
+    const int64_t size = std::min<int64_t>(1000, result.size() - offset);
+    ASSERT_EQ(reader->read(reader, result.data() + offset, size), size);
+    offset += size;
+  }
+  char extra;
+  EXPECT_EQ(reader->read(reader, &extra, 1), 0);
+  EXPECT_EQ_ARRAY(uncompressed.data(), result.data(), result.size());
+
+  reader->close(reader);
+}
+
+TEST(filereader_zstd, ParallelRandomRead)
+{
+  const Vector<char> uncompressed = test_data(300000);
+  const Vector<char> compressed = compress_seekable(uncompressed, 1000);
+
+  FileReader *serial = BLI_filereader_new_zstd(
+      BLI_filereader_new_memory(compressed.data(), compressed.size()));
+  FileReader *parallel = BLI_filereader_new_zstd_parallel(
+      BLI_filereader_new_memory(compressed.data(), compressed.size()), 4);
+  ASSERT_NE(serial, nullptr);
+  ASSERT_NE(parallel, nullptr);
+
+  /* Jump back and forth, both inside and outside the read-ahead window. */
+  const int64_t offsets[] = {0, 150000, 152500, 1000, 299000, 4999, 5001, 200000, 199999, 0};
+  for (const int64_t offset : offsets) {
+    char expected[2500];
+    char actual[2500];
+    ASSERT_EQ(serial->seek(serial, offset, SEEK_SET), offset);
+    ASSERT_EQ(parallel->seek(parallel, offset, SEEK_SET), offset);
+    const int64_t expected_size = serial->read(serial, expected, sizeof(expected));
+    EXPECT_EQ(parallel->read(parallel, actual, sizeof(actual)), expected_size);
+    EXPECT_EQ(memcmp(expected, actual, expected_size), 0);
+  }
+
+  serial->close(serial);
+  parallel->close(parallel);
+}
+
+}  // namespace blender::tests
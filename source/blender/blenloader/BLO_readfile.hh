@@ -3,7 +3,10 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 #pragma once
 
+#include <string>
+
 #include "BLI_listbase.h"
+#include "BLI_span.hh"
 #include "BLI_sys_types.h"
 #include "BLI_utility_mixins.hh"
 
@@ -166,6 +169,23 @@ ENUM_OPERATORS(eBLOReadSkip, BLO_READ_SKIP_UNDO_OLD_MAIN)
 BlendFileData *BLO_read_from_file(const char *filepath,
                                   eBLOReadSkip skip_flags,
                                   BlendFileReadReport *reports);
+/**
+ * Same as #BLO_read_from_file, but opening the file only builds the index of its blocks. The
+ * local data-blocks are decoded when they are first needed: only the \a root_idnames ones and
+ * those they depend on (recursively) end up being read, everything else in the file is skipped.
+ * Linked data is handled as in a regular read.
+ *
+ * This is much faster than a full read when only a small part of a large file is needed, e.g.
+ * rendering a single scene out of a file containing many of them. Combined with memory-mapped IO,
+ * the data of unused data-blocks is never even read from disk.
+ *
+ * \param root_idnames: Full names of the data-blocks to read, including the two ID code
+ * characters (e.g. `SCScene`). When empty, the active scene of the file is used.
+ */
+BlendFileData *BLO_read_from_file_lazy(const char *filepath,
+                                       eBLOReadSkip skip_flags,
+                                       blender::Span<std::string> root_idnames,
+                                       BlendFileReadReport *reports);
 /**
  * Open a blender file from memory. The function returns NULL
  * and sets a report in the list if it cannot open the file.
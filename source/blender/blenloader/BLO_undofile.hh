@@ -39,6 +39,11 @@ struct MemFileChunk {
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
   bool is_identical_future;
+  /**
+   * When true, the memory is owned by the content-deduplicated storage shared by all undo steps
+   * (and reference counted there), instead of by this chunk or a previous one.
+   */
+  bool is_stored;
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
@@ -46,7 +51,13 @@ struct MemFileChunk {
 
 struct MemFile {
   ListBase chunks;
+  /** Size of the memory added by this step (not shared with any previous step). */
   size_t size;
+  /**
+   * Size of the chunks that were not identical to the matching chunk of the previous step, but
+   * found elsewhere in the undo stack by their content (not included in #size).
+   */
+  size_t size_deduplicated;
   /**
    * Some data is not serialized into a new buffer because the undo-step can take ownership of it
    * without making a copy. This is faster and requires less memory.
@@ -63,6 +74,12 @@ struct MemFileWriteData {
 
   /** Maps an ID session uid to its first reference MemFileChunk, if existing. */
   blender::Map<uint, MemFileChunk *> id_session_uid_mapping;
+
+  /**
+   * Look for chunks with the same content in the storage shared by all undo steps. Disabled for
+   * memfiles that are not part of the undo stack.
+   */
+  bool use_deduplication = true;
 };
 
 struct MemFileUndoData {
@@ -89,6 +106,13 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add the chunks written for the ID with the given session UID in the reference memfile, without
+ * serializing the ID again.
+ *
+ * \return false when the reference memfile has no chunks for this ID, it needs to be written.
+ */
+bool BLO_memfile_chunk_add_from_reference(MemFileWriteData *mem_data, uint id_session_uid);
 
 /* exports */
 
@@ -56,6 +56,38 @@ extern bool BLO_write_file(Main *mainvar,
                            const BlendFileWriteParams *params,
                            ReportList *reports);
 
+/**
+ * Write \a mainvar as it would be saved to \a filepath, but into \a r_memfile instead of the
+ * file system. Unlike undo memfiles the result is a complete file, that can be written to disk
+ * later with #BLO_memfile_write_file without accessing \a mainvar anymore (e.g. from a thread).
+ *
+ * The #BlendFileWriteParams.use_save_versions option is ignored,
+ * it has to be passed to #BLO_memfile_write_file.
+ *
+ * \return Success.
+ */
+extern bool BLO_write_file_snapshot(Main *mainvar,
+                                    const char *filepath,
+                                    int write_flags,
+                                    const BlendFileWriteParams *params,
+                                    ReportList *reports,
+                                    MemFile *r_memfile);
+
+/**
+ * Write a memfile created by #BLO_write_file_snapshot to \a filepath.
+ * Only accesses \a memfile, so this is safe to call from a thread other than the main one.
+ *
+ * \param write_flags: Only #G_FILE_COMPRESS is used.
+ * \param progress: Optional, set to the fraction of the file that was written.
+ * \return Success.
+ */
+extern bool BLO_memfile_write_file(MemFile *memfile,
+                                   const char *filepath,
+                                   int write_flags,
+                                   bool use_save_versions,
+                                   float *progress,
+                                   ReportList *reports);
+
 /**
  * \return Success.
  */
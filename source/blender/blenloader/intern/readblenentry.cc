@@ -317,6 +317,28 @@ BlendFileData *BLO_read_from_file(const char *filepath,
   return bfd;
 }
 
+BlendFileData *BLO_read_from_file_lazy(const char *filepath,
+                                       eBLOReadSkip skip_flags,
+                                       blender::Span<std::string> root_idnames,
+                                       BlendFileReadReport *reports)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  BlendFileData *bfd = nullptr;
+  FileData *fd;
+
+  fd = blo_filedata_from_file(filepath, reports);
+  if (fd) {
+    fd->skip_flags = skip_flags;
+    fd->lazy_root_idnames.emplace(root_idnames);
+    bfd = blo_read_file_internal(fd, filepath);
+    blo_filedata_free(fd);
+  }
+
+  return bfd;
+}
+
 BlendFileData *BLO_read_from_memory(const void *mem,
                                     int memsize,
                                     eBLOReadSkip skip_flags,
@@ -49,8 +49,10 @@
 #include "BLI_ghash.h"
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
@@ -171,6 +173,12 @@
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
+/**
+ * Run the DNA reconstruction of data-blocks on worker threads, ahead of the main thread creating
+ * the IDs, see #ReadPipeline. The rest of file reading is unaffected.
+ */
+#define USE_READ_PIPELINE
+
 static CLG_LogRef LOG = {"blo.readfile"};
 static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 
@@ -178,6 +186,10 @@ static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 static void read_libraries(FileData *basefd, ListBase *mainlist);
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const int id_type_index);
 static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const char *name);
+static void read_lazy_root_ids(FileData *fd, BlendFileData *bfd);
+#ifdef USE_READ_PIPELINE
+static bool read_pipeline_take(FileData *fd, BHead *bh, void **r_data);
+#endif
 
 struct BHeadN {
   BHeadN *next, *prev;
@@ -1217,6 +1229,19 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
   return fd;
 }
 
+/**
+ * Number of zstd frames decompressed ahead of the reading position when loading compressed files
+ * from disk. Frames are about 1MB each, so this bounds the extra memory used during loading.
+ */
+static int blo_zstd_readahead_frames()
+{
+  const int threads_num = BLI_task_scheduler_num_threads();
+  if (threads_num <= 1) {
+    return 0;
+  }
+  return std::min(threads_num * 2, 64);
+}
+
 static FileData *blo_filedata_from_file_descriptor(const char *filepath,
                                                    BlendFileReadReport *reports,
                                                    const int filedes)
@@ -1262,7 +1287,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
     }
   }
   else if (BLI_file_magic_is_zstd(header)) {
-    file = BLI_filereader_new_zstd(rawfile);
+    file = BLI_filereader_new_zstd_parallel(rawfile, blo_zstd_readahead_frames());
     if (file != nullptr) {
       rawfile = nullptr; /* The `Zstd` #FileReader takes ownership of `rawfile`. */
     }
@@ -1827,6 +1852,12 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
 {
   void *temp = nullptr;
 
+#ifdef USE_READ_PIPELINE
+  if (fd->read_pipeline && read_pipeline_take(fd, bh, &temp)) {
+    return temp;
+  }
+#endif
+
   if (bh->len) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
     BHead *bh_orig = bh;
@@ -1938,6 +1969,280 @@ static void link_glob_list(FileData *fd, ListBase *lb) /* for glob data */
 
 /** \} */
 
+#ifdef USE_READ_PIPELINE
+
+/* -------------------------------------------------------------------- */
+/** \name DNA Struct Loading (Threaded)
+ *
+ * When reading a whole file, converting the data-blocks to the current DNA (see #read_struct) is
+ * done on worker threads, one batch of IDs ahead of the main thread. Only #DNA_struct_reconstruct
+ * and copying blocks that match the current DNA run in parallel. Reading from the file stays
+ * on the main thread since #FileReader is not thread-safe, and so does creating the IDs:
+ * #direct_link_id, pointer remapping and versioning all rely on the shared #FileData and #Main
+ * state. This includes the `blend_read_data` callbacks of every ID type: they resolve pointers
+ * through the single #FileData.datamap (which also counts the users of each block to free the
+ * unused ones), and many of them add reports or look up other data of the file. Any speedup is
+ * therefore limited to the share of loading time spent in reconstruction, which is largest for
+ * files written by older versions of Blender.
+ *
+ * The main thread prepares a batch (reads the file data and allocates the result of blocks that
+ * can simply be copied), the task pool then decodes it while the main thread creates the IDs of
+ * the previous batch. #read_struct takes the decoded data from #ReadPipeline.decoded.
+ * \{ */
+
+/** Amount of file data per batch, also bounds the extra memory used for decoded data. */
+#define READ_PIPELINE_BATCH_SIZE (16 << 20)
+/** Amount of file data per task, small IDs are grouped together to reduce overhead. */
+#define READ_PIPELINE_TASK_SIZE (256 << 10)
+
+struct ReadPipelineBlock {
+  /** BHead in #FileData.bhead_list, used as key by #read_struct. */
+  BHead *bhead;
+  /** BHead with the file data to decode, null when there is nothing left to do. */
+  BHead *bhead_src;
+  /** Temporary copy of `bhead` with its data read from the file, freed once decoded. */
+  BHead *bhead_full;
+  const char *alloc_name;
+  /** Result, as it would be returned by #read_struct. */
+  void *data;
+};
+
+struct ReadPipelineTask {
+  int64_t blocks_start;
+  int64_t blocks_end;
+};
+
+struct ReadPipeline {
+  TaskPool *task_pool;
+  const DNA_ReconstructInfo *reconstruct_info;
+  const char *compflags;
+
+  /** Blocks of the batch being decoded by the task pool. */
+  blender::Vector<ReadPipelineBlock> batch;
+  /** First BHead of the batch being decoded, the main thread waits for it when reaching it. */
+  BHead *batch_first = nullptr;
+  /** First BHead after the batch being decoded, null when the end of the file was reached. */
+  BHead *batch_next = nullptr;
+
+  /** Decoded data of the previous batch, not yet taken by #read_struct. */
+  blender::Map<const BHead *, void *> decoded;
+};
+
+static void read_pipeline_decode_task(TaskPool *__restrict pool, void *taskdata)
+{
+  ReadPipeline &pipeline = *static_cast<ReadPipeline *>(BLI_task_pool_user_data(pool));
+  const ReadPipelineTask &task = *static_cast<const ReadPipelineTask *>(taskdata);
+
+  const blender::IndexRange range = blender::IndexRange::from_begin_end(task.blocks_start,
+                                                                        task.blocks_end);
+  for (ReadPipelineBlock &block : pipeline.batch.as_mutable_span().slice(range)) {
+    const BHead *bh = block.bhead_src;
+    if (bh == nullptr) {
+      continue;
+    }
+    if (pipeline.compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+      block.data = DNA_struct_reconstruct(
+          pipeline.reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1), block.alloc_name);
+    }
+    else {
+      /* #SDNA_CMP_EQUAL, allocated when preparing the batch. */
+      memcpy(block.data, (bh + 1), bh->len);
+    }
+    if (block.bhead_full) {
+      MEM_freeN(BHEADN_FROM_BHEAD(block.bhead_full));
+      block.bhead_full = nullptr;
+    }
+  }
+}
+
+/**
+ * Same as #read_struct, except that the conversion of the data is left to
+ * #read_pipeline_decode_task. Returns the amount of file data of the block.
+ */
+static size_t read_pipeline_prepare_block(FileData *fd,
+                                          ReadPipeline &pipeline,
+                                          BHead *bh,
+                                          const char *blockname,
+                                          const int id_type_index)
+{
+  pipeline.batch.append({bh, nullptr, nullptr, nullptr, nullptr});
+  ReadPipelineBlock &block = pipeline.batch.last();
+
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return 0;
+  }
+
+  block.alloc_name = get_alloc_name(fd, bh, blockname, id_type_index);
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+      block.bhead_full = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(block.bhead_full == nullptr)) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+        return 0;
+      }
+      block.bhead_src = block.bhead_full;
+    }
+    else {
+      block.bhead_src = bh;
+    }
+  }
+  else {
+    /* SDNA_CMP_EQUAL */
+    const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+    block.data = MEM_mallocN_aligned(bh->len, alignment, block.alloc_name);
+    if (BHEADN_FROM_BHEAD(bh)->has_data) {
+      block.bhead_src = bh;
+    }
+    else {
+      /* Read the data from the file directly into its final memory, no decoding needed. */
+      if (UNLIKELY(!blo_bhead_read_data(fd, bh, block.data))) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+        MEM_freeN(block.data);
+        block.data = nullptr;
+      }
+    }
+  }
+  return size_t(bh->len);
+}
+
+/** Read the next batch of IDs, starting at \a bhead, and start decoding it. */
+static void read_pipeline_batch_start(FileData *fd, ReadPipeline &pipeline, BHead *bhead)
+{
+  BLI_assert(pipeline.batch.is_empty());
+
+  /* Index of the first block of each task. Tasks are only pushed once the whole batch is known,
+   * since #ReadPipeline.batch may still be reallocated until then. */
+  blender::Vector<int64_t> task_starts;
+  size_t batch_size = 0;
+  size_t task_size = 0;
+  pipeline.batch_first = bhead;
+
+  while (bhead && bhead->code != BLO_CODE_ENDB && batch_size < READ_PIPELINE_BATCH_SIZE) {
+    if (bhead->code == ID_LINK_PLACEHOLDER || !blo_bhead_is_id_valid_type(bhead)) {
+      /* Left to the main thread, like any #BLO_CODE_DATA following it. */
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+
+    /* Must match the allocation names used by #read_libblock. */
+    const int id_type_index = BKE_idtype_idcode_to_index(bhead->code);
+#  ifndef NDEBUG
+    const char *blockname = nullptr;
+#  else
+    const char *blockname = get_alloc_name(fd, bhead, nullptr, id_type_index);
+#  endif
+
+    if (task_size == 0) {
+      task_starts.append(pipeline.batch.size());
+    }
+
+    /* The ID and all its data. */
+    size_t id_size = 0;
+    do {
+      id_size += read_pipeline_prepare_block(fd, pipeline, bhead, blockname, id_type_index);
+      bhead = blo_bhead_next(fd, bhead);
+    } while (bhead && bhead->code == BLO_CODE_DATA);
+
+    batch_size += id_size;
+    task_size += id_size;
+    if (task_size >= READ_PIPELINE_TASK_SIZE) {
+      task_size = 0;
+    }
+  }
+
+  pipeline.batch_next = bhead;
+
+  for (const int64_t i : task_starts.index_range()) {
+    ReadPipelineTask *task = MEM_cnew<ReadPipelineTask>(__func__);
+    task->blocks_start = task_starts[i];
+    task->blocks_end = (i + 1 < task_starts.size()) ? task_starts[i + 1] : pipeline.batch.size();
+    BLI_task_pool_push(pipeline.task_pool, read_pipeline_decode_task, task, true, nullptr);
+  }
+}
+
+static void read_pipeline_free_decoded(ReadPipeline &pipeline)
+{
+  /* Data the main thread skipped (e.g. unknown ID types are only detected after decoding). */
+  for (void *data : pipeline.decoded.values()) {
+    if (data) {
+      MEM_freeN(data);
+    }
+  }
+  pipeline.decoded.clear();
+}
+
+/**
+ * Called by the main loop of #blo_read_file_internal for each BHead it handles. When reaching the
+ * batch being decoded, wait for it and start decoding the next one.
+ */
+static void read_pipeline_step(FileData *fd, BHead *bhead)
+{
+  ReadPipeline &pipeline = *fd->read_pipeline;
+  if (bhead != pipeline.batch_first) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(pipeline.task_pool);
+
+  read_pipeline_free_decoded(pipeline);
+  pipeline.decoded.reserve(pipeline.batch.size());
+  for (const ReadPipelineBlock &block : pipeline.batch) {
+    pipeline.decoded.add(block.bhead, block.data);
+  }
+  pipeline.batch.clear();
+  pipeline.batch_first = nullptr;
+
+  if (pipeline.batch_next) {
+    read_pipeline_batch_start(fd, pipeline, pipeline.batch_next);
+  }
+}
+
+static bool read_pipeline_take(FileData *fd, BHead *bh, void **r_data)
+{
+  std::optional<void *> data = fd->read_pipeline->decoded.pop_try(bh);
+  if (!data) {
+    return false;
+  }
+  *r_data = *data;
+  return true;
+}
+
+static void read_pipeline_begin(FileData *fd)
+{
+  ReadPipeline *pipeline = MEM_new<ReadPipeline>(__func__);
+  pipeline->task_pool = BLI_task_pool_create(pipeline, TASK_PRIORITY_HIGH);
+  pipeline->reconstruct_info = fd->reconstruct_info;
+  pipeline->compflags = fd->compflags;
+  fd->read_pipeline = pipeline;
+
+  read_pipeline_batch_start(fd, *pipeline, blo_bhead_first(fd));
+}
+
+static void read_pipeline_end(FileData *fd)
+{
+  ReadPipeline *pipeline = fd->read_pipeline;
+  if (pipeline == nullptr) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(pipeline->task_pool);
+  BLI_task_pool_free(pipeline->task_pool);
+
+  for (const ReadPipelineBlock &block : pipeline->batch) {
+    if (block.data) {
+      MEM_freeN(block.data);
+    }
+  }
+  read_pipeline_free_decoded(*pipeline);
+
+  MEM_delete(pipeline);
+  fd->read_pipeline = nullptr;
+}
+
+/** \} */
+
+#endif /* USE_READ_PIPELINE */
+
 /* -------------------------------------------------------------------- */
 /** \name Read ID
  * \{ */
@@ -3688,7 +3993,23 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+#ifdef USE_READ_PIPELINE
+  /* Undo reuses most unchanged IDs, and lazy loading only reads few of them, so it is only worth
+   * decoding ahead when reading all data-blocks. Files with a different endianness are rare enough
+   * to not bother with their in-place conversion. */
+  if (!is_undo && !fd->lazy_root_idnames && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0 &&
+      (fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0 && BLI_task_scheduler_num_threads() > 1)
+  {
+    read_pipeline_begin(fd);
+  }
+#endif
+
   while (bhead) {
+#ifdef USE_READ_PIPELINE
+    if (fd->read_pipeline) {
+      read_pipeline_step(fd, bhead);
+    }
+#endif
     switch (bhead->code) {
       case BLO_CODE_DATA:
       case BLO_CODE_DNA1:
@@ -3712,7 +4033,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         break;
 
       case ID_LINK_PLACEHOLDER:
-        if (fd->skip_flags & BLO_READ_SKIP_DATA) {
+        if ((fd->skip_flags & BLO_READ_SKIP_DATA) || fd->lazy_root_idnames) {
+          /* In lazy mode, placeholders are only read when used, see #read_lazy_root_ids. */
           bhead = blo_bhead_next(fd, bhead);
         }
         else {
@@ -3736,6 +4058,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
           if (fd->skip_flags & BLO_READ_SKIP_DATA) {
             bhead = blo_bhead_next(fd, bhead);
           }
+          else if (fd->lazy_root_idnames && bhead->code != ID_LI) {
+            /* Only index the BHead for now, libraries are still read since placeholders of linked
+             * IDs need the Main of their library. */
+            bhead = blo_bhead_next(fd, bhead);
+          }
           else {
             bhead = read_libblock(fd, bfd->main, bhead, ID_TAG_LOCAL, {}, false, nullptr);
           }
@@ -3748,6 +4075,21 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
 
     if (bfd->main->is_read_invalid) {
+#ifdef USE_READ_PIPELINE
+      read_pipeline_end(fd);
+#endif
+      return bfd;
+    }
+  }
+
+#ifdef USE_READ_PIPELINE
+  read_pipeline_end(fd);
+#endif
+
+  if (fd->lazy_root_idnames && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    BLI_assert(!is_undo);
+    read_lazy_root_ids(fd, bfd);
+    if (bfd->main->is_read_invalid) {
       return bfd;
     }
   }
@@ -4278,6 +4620,123 @@ void BLO_expand_main(void *fdhandle, Main *mainvar, BLOExpandDoitCallback callba
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Lazy Loading
+ *
+ * Only read the local data-blocks needed by a few root IDs, see #BLO_read_from_file_lazy.
+ * \{ */
+
+/**
+ * Read the data-block of the given BHead if it was not read yet. Local data-blocks are tagged for
+ * expanding, so that their own dependencies get read in turn by #BLO_expand_main. Placeholders of
+ * linked data-blocks go into the Main of their library, exactly like in a regular read of the
+ * whole file.
+ */
+static void read_lazy_id(FileData *fd, Main *mainvar, BHead *bhead)
+{
+  /* In 2.50+ file identifier for screens is patched, forward compatibility. */
+  if (bhead->code == ID_SCRN) {
+    bhead->code = ID_SCR;
+  }
+  if (!blo_bhead_is_id_valid_type(bhead)) {
+    return;
+  }
+  if (oldnewmap_liblookup(fd->libmap, bhead->old, false) != nullptr) {
+    /* Already read, either as a root or as a dependency of another ID. */
+    return;
+  }
+
+  ID *id = nullptr;
+  if (bhead->code == ID_LINK_PLACEHOLDER) {
+    /* Libraries are always read in lazy mode, so this finds the Main created by
+     * #direct_link_library. */
+    BHead *bheadlib = find_previous_lib(fd, bhead);
+    if (bheadlib == nullptr) {
+      return;
+    }
+    Library *lib = static_cast<Library *>(
+        read_struct(fd, bheadlib, "Data for Library ID type", INDEX_ID_NULL));
+    Main *libmain = blo_find_main(fd, lib->filepath, fd->relabase);
+    MEM_freeN(lib);
+
+    read_libblock(fd, libmain, bhead, 0, {}, true, &id);
+    if (id != nullptr) {
+      id_sort_by_name(which_libbase(libmain, GS(id->name)), id, static_cast<ID *>(id->prev));
+    }
+    return;
+  }
+
+  ID_Readfile_Data::Tags id_read_tags{};
+  id_read_tags.needs_expanding = true;
+  read_libblock(fd, mainvar, bhead, ID_TAG_LOCAL, id_read_tags, false, &id);
+  if (id != nullptr) {
+    /* Keep the same order as when reading the whole file. */
+    id_sort_by_name(which_libbase(mainvar, GS(id->name)), id, static_cast<ID *>(id->prev));
+  }
+}
+
+static void expand_doit_lazy(void *fdhandle, Main *mainvar, void *old)
+{
+  FileData *fd = static_cast<FileData *>(fdhandle);
+
+  if (mainvar->is_read_invalid) {
+    return;
+  }
+
+  BHead *bhead = find_bhead(fd, old);
+  if (bhead != nullptr) {
+    read_lazy_id(fd, mainvar, bhead);
+  }
+}
+
+static void read_lazy_root_ids(FileData *fd, BlendFileData *bfd)
+{
+  blender::Vector<BHead *> root_bheads;
+
+  if (fd->lazy_root_idnames->is_empty()) {
+    /* Default to the active scene. At this point `bfd->curscene` is still the address stored in
+     * the file. */
+    BHead *bhead = find_bhead(fd, bfd->curscene);
+    if (bhead == nullptr) {
+      /* Very old files don't store the active scene, #link_global then uses the first one. */
+      for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+        if (bhead->code == ID_SCE) {
+          break;
+        }
+      }
+    }
+    if (bhead != nullptr) {
+      root_bheads.append(bhead);
+    }
+  }
+  else {
+    blender::Set<blender::StringRef> root_idnames;
+    for (const std::string &idname : *fd->lazy_root_idnames) {
+      root_idnames.add(idname);
+    }
+    for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+      if (blo_bhead_is_id_valid_type(bhead) &&
+          root_idnames.contains(blo_bhead_id_name(fd, bhead)))
+      {
+        root_bheads.append(bhead);
+      }
+    }
+  }
+
+  if (root_bheads.is_empty()) {
+    BLO_reportf_wrap(
+        fd->reports, RPT_WARNING, RPT_("Lazy loading: none of the requested data-blocks found"));
+    return;
+  }
+
+  for (BHead *bhead : root_bheads) {
+    read_lazy_id(fd, bfd->main, bhead);
+  }
+  BLO_expand_main(fd, bfd->main, expand_doit_lazy);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Library Linking (helper functions)
  * \{ */
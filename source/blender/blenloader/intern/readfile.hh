@@ -11,6 +11,7 @@
 
 #include <cstdio> /* IWYU pragma: keep. Include header using off_t before poisoning it below. */
 #include <optional>
+#include <string>
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -18,6 +19,7 @@
 
 #include "BLI_filereader.h"
 #include "BLI_map.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_sdna_types.h"
 #include "DNA_space_types.h"
@@ -37,6 +39,7 @@ struct Main;
 struct MemFile;
 struct Object;
 struct OldNewMap;
+struct ReadPipeline;
 struct UserDef;
 
 enum eFileDataFlag {
@@ -108,6 +111,19 @@ struct FileData {
   /** Optionally skip some data-blocks when they're not needed. */
   eBLOReadSkip skip_flags = BLO_READ_SKIP_NONE;
 
+  /**
+   * When set, reading the local data-blocks is deferred until they are needed by one of these root
+   * IDs (full names including the ID code, an empty list means the active scene). All other IDs
+   * are only indexed. See #BLO_read_from_file_lazy.
+   */
+  std::optional<blender::Vector<std::string>> lazy_root_idnames;
+
+  /**
+   * When reading a whole file, the DNA conversion of upcoming data-blocks is done ahead of time on
+   * worker threads. Only set during #blo_read_file_internal.
+   */
+  ReadPipeline *read_pipeline = nullptr;
+
   /**
    * Tag to apply to all loaded ID data-blocks.
    *
@@ -23,7 +23,9 @@
 
 #include "DNA_listBase.h"
 
+#include "BLI_hash_mm2a.hh"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_vector.hh"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -34,12 +36,101 @@
 
 #include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
 
+/* -------------------------------------------------------------------- */
+/** \name Deduplicated Chunk Storage
+ *
+ * Large chunks (typically parts of big arrays, which are written in chunks of their own) are
+ * stored once for the whole undo stack, indexed by a hash of their content. This shares them
+ * between undo steps regardless of their position in the #MemFile, e.g. when data was inserted
+ * before them, or when the array of an ID was resized and its following arrays shifted.
+ * \{ */
+
+/** Smaller chunks are only shared with the matching chunk of the previous undo step. */
+#define MEMFILE_STORE_MIN_SIZE 4096
+
+struct MemFileStoredChunk {
+  size_t size;
+  uint32_t hash;
+  /** Number of #MemFileChunk using this buffer, in all undo steps. */
+  int users;
+};
+
+struct MemFileChunkStore {
+  blender::Map<const char *, MemFileStoredChunk> chunks;
+  /** Stored buffers by hash of their content (collisions are checked by comparing the data). */
+  blender::Map<uint32_t, blender::Vector<const char *, 1>> buffers_by_hash;
+};
+
+/** Created on demand, freed once the last undo step using it is freed. */
+static MemFileChunkStore *memfile_chunk_store = nullptr;
+
+/**
+ * Get a stored buffer with the same content as \a buf, adding a copy of it when none exists.
+ */
+static const char *memfile_chunk_store_add(const char *buf, const size_t size, bool *r_is_new)
+{
+  if (memfile_chunk_store == nullptr) {
+    memfile_chunk_store = MEM_new<MemFileChunkStore>(__func__);
+  }
+  MemFileChunkStore &store = *memfile_chunk_store;
+
+  const uint32_t hash = BLI_hash_mm2(reinterpret_cast<const uchar *>(buf), size, 0);
+  blender::Vector<const char *, 1> &buffers = store.buffers_by_hash.lookup_or_add_default(hash);
+  for (const char *stored_buf : buffers) {
+    MemFileStoredChunk &stored_chunk = store.chunks.lookup(stored_buf);
+    if (stored_chunk.size == size && memcmp(stored_buf, buf, size) == 0) {
+      stored_chunk.users++;
+      *r_is_new = false;
+      return stored_buf;
+    }
+  }
+
+  char *buf_new = static_cast<char *>(MEM_mallocN(size, "Stored chunk buffer"));
+  memcpy(buf_new, buf, size);
+  buffers.append(buf_new);
+  store.chunks.add_new(buf_new, {size, hash, 1});
+  *r_is_new = true;
+  return buf_new;
+}
+
+static void memfile_chunk_store_user_add(const char *buf)
+{
+  memfile_chunk_store->chunks.lookup(buf).users++;
+}
+
+static void memfile_chunk_store_user_remove(const char *buf)
+{
+  MemFileChunkStore &store = *memfile_chunk_store;
+  MemFileStoredChunk &stored_chunk = store.chunks.lookup(buf);
+  if (--stored_chunk.users > 0) {
+    return;
+  }
+
+  blender::Vector<const char *, 1> &buffers = store.buffers_by_hash.lookup(stored_chunk.hash);
+  buffers.remove_first_occurrence_and_reorder(buf);
+  if (buffers.is_empty()) {
+    store.buffers_by_hash.remove(stored_chunk.hash);
+  }
+  store.chunks.remove(buf);
+  MEM_freeN(const_cast<char *>(buf));
+
+  if (store.chunks.is_empty()) {
+    MEM_delete(memfile_chunk_store);
+    memfile_chunk_store = nullptr;
+  }
+}
+
+/** \} */
+
 /* **************** support for memory-write, for undo buffers *************** */
 
 void BLO_memfile_free(MemFile *memfile)
 {
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (chunk->is_stored) {
+      memfile_chunk_store_user_remove(chunk->buf);
+    }
+    else if (chunk->is_identical == false) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -47,6 +138,7 @@ void BLO_memfile_free(MemFile *memfile)
   MEM_delete(memfile->shared_storage);
   memfile->shared_storage = nullptr;
   memfile->size = 0;
+  memfile->size_deduplicated = 0;
 }
 
 MemFileSharedStorage::~MemFileSharedStorage()
@@ -63,9 +155,10 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
    * by it (i.e. shared with some previous memory steps). */
   blender::Map<const char *, MemFileChunk *> buffer_to_second_memchunk;
 
-  /* First, detect all memchunks in second memfile that are not owned by it. */
+  /* First, detect all memchunks in second memfile that are not owned by it. Stored chunks are
+   * reference counted, they don't need any ownership transfer. */
   LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
-    if (sc->is_identical) {
+    if (sc->is_identical && !sc->is_stored) {
       buffer_to_second_memchunk.add(sc->buf, sc);
     }
   }
@@ -73,7 +166,7 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
    * it is also used by the second memfile, transfer the ownership. */
   LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
-    if (!fc->is_identical) {
+    if (!fc->is_identical && !fc->is_stored) {
       if (MemFileChunk *sc = buffer_to_second_memchunk.lookup_default(fc->buf, nullptr)) {
         BLI_assert(sc->is_identical);
         sc->is_identical = false;
@@ -140,6 +233,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
   curchunk->is_identical_future = true;
+  curchunk->is_stored = false;
   curchunk->id_session_uid = mem_data->current_id_session_uid;
   BLI_addtail(&memfile->chunks, curchunk);
 
@@ -151,11 +245,28 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
         curchunk->buf = compchunk->buf;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
+        if (compchunk->is_stored) {
+          memfile_chunk_store_user_add(curchunk->buf);
+          curchunk->is_stored = true;
+        }
       }
     }
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  /* Not equal, look for the same content anywhere in the undo stack. */
+  if (curchunk->buf == nullptr && mem_data->use_deduplication && size >= MEMFILE_STORE_MIN_SIZE) {
+    bool is_new;
+    curchunk->buf = memfile_chunk_store_add(buf, size, &is_new);
+    curchunk->is_stored = true;
+    if (is_new) {
+      memfile->size += size;
+    }
+    else {
+      memfile->size_deduplicated += size;
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
@@ -165,6 +276,39 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+bool BLO_memfile_chunk_add_from_reference(MemFileWriteData *mem_data, const uint id_session_uid)
+{
+  MemFileChunk *compchunk = mem_data->id_session_uid_mapping.lookup_default(id_session_uid,
+                                                                            nullptr);
+  if (compchunk == nullptr) {
+    return false;
+  }
+
+  /* All data of an ID is in consecutive chunks, see #mywrite_id_end in `writefile.cc`. */
+  MemFile *memfile = mem_data->written_memfile;
+  for (; compchunk != nullptr && compchunk->id_session_uid == id_session_uid;
+       compchunk = static_cast<MemFileChunk *>(compchunk->next))
+  {
+    MemFileChunk *curchunk = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    curchunk->buf = compchunk->buf;
+    curchunk->size = compchunk->size;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->is_stored = compchunk->is_stored;
+    curchunk->id_session_uid = id_session_uid;
+    if (curchunk->is_stored) {
+      memfile_chunk_store_user_add(curchunk->buf);
+    }
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+
+  mem_data->reference_current_chunk = compchunk;
+  return true;
+}
+
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
 {
   Main *bmain_undo = nullptr;
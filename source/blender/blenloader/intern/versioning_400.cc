@@ -33,6 +33,7 @@
 #include "DNA_movieclip_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_volume_types.h"
 #include "DNA_workspace_types.h"
 #include "DNA_world_types.h"
 
@@ -5830,6 +5831,16 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
     rename_mesh_uv_seam_attribute(*mesh);
   }
 
+  if (!MAIN_VERSION_FILE_ATLEAST(bmain, 404, 28)) {
+    if (!DNA_struct_member_exists(fd->filesdna, "Volume", "float", "load_bounds_min[3]")) {
+      const Volume *default_volume = DNA_struct_default_get(Volume);
+      LISTBASE_FOREACH (Volume *, volume, &bmain->volumes) {
+        copy_v3_v3(volume->load_bounds_min, default_volume->load_bounds_min);
+        copy_v3_v3(volume->load_bounds_max, default_volume->load_bounds_max);
+      }
+    }
+  }
+
   /**
    * Always bump subversion in BKE_blender_version.h when adding versioning
    * code here, and wrap it inside a MAIN_VERSION_FILE_ATLEAST check.
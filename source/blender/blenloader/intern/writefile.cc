@@ -82,12 +82,16 @@
 /* Allow writefile to use deprecated functionality (for forward compatibility code). */
 #define DNA_DEPRECATED_ALLOW
 
+#include "DNA_collection_types.h"
 #include "DNA_fileglobal_types.h"
 #include "DNA_genfile.h"
 #include "DNA_key_types.h"
+#include "DNA_node_types.h"
 #include "DNA_print.hh"
+#include "DNA_scene_types.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_endian_defines.h"
 #include "BLI_fileops.hh"
 #include "BLI_implicit_sharing.hh"
@@ -96,6 +100,7 @@
 #include "BLI_path_utils.hh"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
@@ -210,6 +215,40 @@ bool RawWriteWrap::write(const void *buf, size_t buf_len)
   return ::write(file_handle, buf, buf_len) == buf_len;
 }
 
+/** Store the written data in a #MemFile, see #BLO_write_file_snapshot. */
+class MemFileWriteWrap : public WriteWrap {
+ public:
+  MemFileWriteWrap(MemFile *memfile);
+
+  bool open(const char *filepath) override;
+  bool close() override;
+  bool write(const void *buf, size_t buf_len) override;
+
+ private:
+  MemFileWriteData mem_data;
+};
+
+MemFileWriteWrap::MemFileWriteWrap(MemFile *memfile)
+{
+  BLO_memfile_write_init(&mem_data, memfile, nullptr);
+  /* Not part of the undo stack, don't share chunks with it. */
+  mem_data.use_deduplication = false;
+}
+bool MemFileWriteWrap::open(const char * /*filepath*/)
+{
+  return true;
+}
+bool MemFileWriteWrap::close()
+{
+  BLO_memfile_write_finalize(&mem_data);
+  return true;
+}
+bool MemFileWriteWrap::write(const void *buf, size_t buf_len)
+{
+  BLO_memfile_chunk_add(&mem_data, static_cast<const char *>(buf), buf_len);
+  return true;
+}
+
 class ZstdWriteWrap : public WriteWrap {
   WriteWrap &base_wrap;
 
@@ -405,6 +444,18 @@ bool ZstdWriteWrap::write(const void *buf, const size_t buf_len)
 /** \name Write Data Type & Functions
  * \{ */
 
+/**
+ * Data written for a single ID on a worker thread, see #write_ids_parallel.
+ */
+struct WriteIDRecord {
+  blender::Vector<uchar> data;
+  /**
+   * Size of each #mywrite call. Writing them out with the same sizes keeps the buffering, and so
+   * the compressed frames, identical to writing the ID directly.
+   */
+  blender::Vector<int64_t> sizes;
+};
+
 struct WriteData {
   const SDNA *sdna;
   std::ostream *debug_dst = nullptr;
@@ -460,6 +511,9 @@ struct WriteData {
    * Will be nullptr for UNDO.
    */
   WriteWrap *ww;
+
+  /** When set, #mywrite only appends the data to this record (no buffer or #WriteWrap). */
+  WriteIDRecord *record;
 };
 
 struct BlendWriter {
@@ -557,6 +611,12 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
     return;
   }
 
+  if (wd->record) {
+    wd->record->data.extend(blender::Span(static_cast<const uchar *>(adr), int64_t(len)));
+    wd->record->sizes.append(int64_t(len));
+    return;
+  }
+
 #ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
 #endif
@@ -1331,6 +1391,159 @@ static void write_id(WriteData *wd, ID *id)
   mywrite_id_end(wd, id);
 }
 
+/** Number of IDs serialized ahead per thread, bounds the memory used by the records. */
+#define WRITE_IDS_PARALLEL_AHEAD 4
+
+struct WriteIDsParallelData {
+  const SDNA *sdna;
+  blender::Span<ID *> ids;
+  blender::MutableSpan<WriteIDRecord> records;
+};
+
+/**
+ * ID types whose `blend_write` callback was checked to only change the temporary copy of the ID
+ * it writes and to not use global state. All other IDs are written from the main thread, e.g.
+ * meshes convert custom normals and cameras add ID properties while writing.
+ */
+static bool write_id_is_threadsafe(const ID *id)
+{
+  switch (GS(id->name)) {
+    case ID_CF:
+    case ID_GR:
+    case ID_LP:
+    case ID_LT:
+    case ID_PAL:
+    case ID_PC:
+    case ID_SO:
+    case ID_SPK:
+    case ID_TXT:
+    case ID_VF:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void write_id_record_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const WriteIDsParallelData &data = *static_cast<const WriteIDsParallelData *>(
+      BLI_task_pool_user_data(pool));
+  const int index = POINTER_AS_INT(taskdata);
+
+  WriteData *wd = MEM_new<WriteData>(__func__);
+  wd->sdna = data.sdna;
+  wd->record = &data.records[index];
+  write_id(wd, data.ids[index]);
+  writedata_free(wd);
+}
+
+static void write_ids_parallel_push(TaskPool *pool,
+                                    const WriteIDsParallelData &data,
+                                    const blender::IndexRange range)
+{
+  for (const int64_t i : range) {
+    if (write_id_is_threadsafe(data.ids[i])) {
+      BLI_task_pool_push(pool, write_id_record_task, POINTER_FROM_INT(int(i)), false, nullptr);
+    }
+  }
+}
+
+/**
+ * Write the given local IDs, serializing them on worker threads into a #WriteIDRecord each. The
+ * main thread writes the records out in order, while the next IDs are being serialized.
+ * Compression is already done in parallel by #ZstdWriteWrap.
+ *
+ * Since records are written with the same #mywrite calls as when writing the IDs directly, the
+ * resulting file is identical.
+ */
+static void write_ids_parallel(WriteData *wd, const blender::Span<ID *> ids)
+{
+  BLI_assert(!wd->use_memfile && wd->debug_dst == nullptr);
+
+  blender::Array<WriteIDRecord> records(ids.size());
+  WriteIDsParallelData data = {wd->sdna, ids, records};
+  TaskPool *pool = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+
+  const int64_t chunk_size = int64_t(BLI_task_scheduler_num_threads()) * WRITE_IDS_PARALLEL_AHEAD;
+  blender::IndexRange chunk = ids.index_range().take_front(chunk_size);
+  write_ids_parallel_push(pool, data, chunk);
+
+  while (!chunk.is_empty()) {
+    BLI_task_pool_work_and_wait(pool);
+
+    /* Serialize the next chunk while this one is written out. */
+    const blender::IndexRange next_chunk = ids.index_range().drop_front(chunk.one_after_last())
+                                               .take_front(chunk_size);
+    write_ids_parallel_push(pool, data, next_chunk);
+
+    for (const int64_t i : chunk) {
+      if (!write_id_is_threadsafe(ids[i])) {
+        write_id(wd, ids[i]);
+        continue;
+      }
+      WriteIDRecord &record = records[i];
+      const uchar *record_data = record.data.data();
+      for (const int64_t size : record.sizes) {
+        mywrite(wd, record_data, size_t(size));
+        record_data += size;
+      }
+      record.data.clear_and_shrink();
+      record.sizes.clear_and_shrink();
+    }
+
+    chunk = next_chunk;
+  }
+
+  BLI_task_pool_free(pool);
+}
+
+/**
+ * Whether the ID was not changed since the previous undo push, according to the recalc tags
+ * accumulated by the depsgraph (including the ones of its embedded IDs).
+ */
+static bool write_undo_id_is_unchanged(const ID *id)
+{
+  /* UI data changes all the time without being tagged. */
+  if (ELEM(GS(id->name), ID_WM, ID_SCR, ID_WS)) {
+    return false;
+  }
+  if (id->recalc_after_undo_push != 0) {
+    return false;
+  }
+  if (const bNodeTree *ntree = blender::bke::node_tree_from_id(const_cast<ID *>(id))) {
+    if (ntree->id.recalc_after_undo_push != 0) {
+      return false;
+    }
+  }
+  if (GS(id->name) == ID_SCE) {
+    const Scene *scene = reinterpret_cast<const Scene *>(id);
+    if (scene->master_collection && scene->master_collection->id.recalc_after_undo_push != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Incremental undo: reuse the chunks of the previous undo step for an unchanged ID, so that undo
+ * pushes only cost as much as the changed IDs.
+ *
+ * \return false when the ID still needs to be written.
+ */
+static bool write_undo_id_reuse(WriteData *wd, ID *id)
+{
+  BLI_assert(wd->use_memfile && wd->buffer.used_len == 0);
+  if (wd->mem.reference_memfile == nullptr || !write_undo_id_is_unchanged(id)) {
+    return false;
+  }
+  if (!BLO_memfile_chunk_add_from_reference(&wd->mem, id->session_uid)) {
+    return false;
+  }
+  /* Same as what #BLO_Write_IDBuffer does when writing the ID. */
+  id->recalc_up_to_undo_push = 0;
+  return true;
+}
+
 static void write_blend_file_header(WriteData *wd)
 {
   char buf[16];
@@ -1508,8 +1721,20 @@ static bool write_file_handle(Main *mainvar,
   }
 
   /* Actually write local data-blocks to the file. */
-  for (ID *id : local_ids_to_write) {
-    write_id(wd, id);
+  if (!is_undo && wd->debug_dst == nullptr && BLI_task_scheduler_num_threads() > 1) {
+    write_ids_parallel(wd, local_ids_to_write);
+  }
+  else {
+    /* Relying on recalc tags may miss changes done without tagging, so this is opt-in, and a full
+     * write is always done when requested by a full undo barrier. */
+    const bool use_undo_incremental = is_undo && !mainvar->use_memfile_full_barrier &&
+                                      USER_EXPERIMENTAL_TEST(&U, use_undo_incremental);
+    for (ID *id : local_ids_to_write) {
+      if (use_undo_incremental && write_undo_id_reuse(wd, id)) {
+        continue;
+      }
+      write_id(wd, id);
+    }
   }
 
   /* Write libraries about libraries and linked data-blocks. */
@@ -1618,49 +1843,43 @@ static void write_file_main_validate_post(Main *bmain, ReportList *reports)
   }
 }
 
-static bool BLO_write_file_impl(Main *mainvar,
-                                const char *filepath,
-                                const int write_flags,
-                                const BlendFileWriteParams *params,
-                                ReportList *reports,
-                                WriteWrap &ww)
+static bool write_file_check_asset_edit(Main *mainvar,
+                                        const char *filepath,
+                                        const int write_flags,
+                                        ReportList *reports)
 {
-  BLI_assert(!BLI_path_is_rel(filepath));
-  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
-
-  char tempname[FILE_MAX + 1];
-
-  eBLO_WritePathRemap remap_mode = params->remap_mode;
-  const bool use_save_versions = params->use_save_versions;
-  const bool use_save_as_copy = params->use_save_as_copy;
-  const bool use_userdef = params->use_userdef;
-  const BlendThumbnail *thumb = params->thumb;
-  const bool relbase_valid = (mainvar->filepath[0] != '\0');
-
   /* Extra protection: Never save a non asset file as asset file. Otherwise a normal file is turned
    * into an asset file, which can result in data loss because the asset system will allow editing
    * this file from the UI, regenerating its content with just the asset and it dependencies. */
   if ((write_flags & G_FILE_ASSET_EDIT_FILE) && !mainvar->is_asset_edit_file) {
-    BKE_reportf(reports, RPT_ERROR, "Cannot save normal file (%s) as asset system file", tempname);
+    BKE_reportf(reports, RPT_ERROR, "Cannot save normal file (%s) as asset system file", filepath);
     return false;
   }
+  return true;
+}
+
+/**
+ * Write \a mainvar to the already opened \a ww, remapping paths for \a filepath as requested.
+ *
+ * \return True if write failed.
+ */
+static bool write_file_main(Main *mainvar,
+                            const char *filepath,
+                            const int write_flags,
+                            const BlendFileWriteParams *params,
+                            WriteWrap &ww)
+{
+  eBLO_WritePathRemap remap_mode = params->remap_mode;
+  const bool use_save_as_copy = params->use_save_as_copy;
+  const bool use_userdef = params->use_userdef;
+  const BlendThumbnail *thumb = params->thumb;
+  const bool relbase_valid = (mainvar->filepath[0] != '\0');
 
   /* Path backup/restore. */
   void *path_list_backup = nullptr;
   const eBPathForeachFlag path_list_flag = (BKE_BPATH_FOREACH_PATH_SKIP_LINKED |
                                             BKE_BPATH_FOREACH_PATH_SKIP_MULTIFILE);
 
-  write_file_main_validate_pre(mainvar, reports);
-
-  /* Open temporary file, so we preserve the original in case we crash. */
-  SNPRINTF(tempname, "%s@", filepath);
-
-  if (ww.open(tempname) == false) {
-    BKE_reportf(
-        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
-    return false;
-  }
-
   if (remap_mode == BLO_WRITE_PATH_REMAP_ABSOLUTE) {
     /* Paths will already be absolute, no remapping to do. */
     if (relbase_valid == false) {
@@ -1756,20 +1975,22 @@ static bool BLO_write_file_impl(Main *mainvar,
   const bool err = write_file_handle(
       mainvar, &ww, nullptr, nullptr, write_flags, use_userdef, thumb, debug_dst);
 
-  ww.close();
-
   if (UNLIKELY(path_list_backup)) {
     BKE_bpath_list_restore(mainvar, path_list_flag, path_list_backup);
     BKE_bpath_list_free(path_list_backup);
   }
 
-  if (err) {
-    BKE_report(reports, RPT_ERROR, strerror(errno));
-    remove(tempname);
-
-    return false;
-  }
+  return err;
+}
 
+/**
+ * Rename the written \a tempname to \a filepath, doing the reverse file history first if needed.
+ */
+static bool write_file_finalize(const char *tempname,
+                                const char *filepath,
+                                const bool use_save_versions,
+                                ReportList *reports)
+{
   /* File save to temporary file was successful, now do reverse file history
    * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
   if (use_save_versions) {
@@ -1784,6 +2005,51 @@ static bool BLO_write_file_impl(Main *mainvar,
     return false;
   }
 
+  return true;
+}
+
+static bool BLO_write_file_impl(Main *mainvar,
+                                const char *filepath,
+                                const int write_flags,
+                                const BlendFileWriteParams *params,
+                                ReportList *reports,
+                                WriteWrap &ww)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  char tempname[FILE_MAX + 1];
+
+  if (!write_file_check_asset_edit(mainvar, filepath, write_flags, reports)) {
+    return false;
+  }
+
+  write_file_main_validate_pre(mainvar, reports);
+
+  /* Open temporary file, so we preserve the original in case we crash. */
+  SNPRINTF(tempname, "%s@", filepath);
+
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  const bool err = write_file_main(mainvar, filepath, write_flags, params, ww);
+
+  ww.close();
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+
+    return false;
+  }
+
+  if (!write_file_finalize(tempname, filepath, params->use_save_versions, reports)) {
+    return false;
+  }
+
   write_file_main_validate_post(mainvar, reports);
 
   return true;
@@ -1811,6 +2077,86 @@ bool BLO_write_file(Main *mainvar,
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
+bool BLO_write_file_snapshot(Main *mainvar,
+                             const char *filepath,
+                             const int write_flags,
+                             const BlendFileWriteParams *params,
+                             ReportList *reports,
+                             MemFile *r_memfile)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  if (!write_file_check_asset_edit(mainvar, filepath, write_flags, reports)) {
+    return false;
+  }
+
+  write_file_main_validate_pre(mainvar, reports);
+
+  MemFileWriteWrap mem_wrap(r_memfile);
+  mem_wrap.open(filepath);
+  const bool err = write_file_main(mainvar, filepath, write_flags, params, mem_wrap);
+  mem_wrap.close();
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, "Cannot write file snapshot");
+    BLO_memfile_free(r_memfile);
+    return false;
+  }
+
+  write_file_main_validate_post(mainvar, reports);
+
+  return true;
+}
+
+bool BLO_memfile_write_file(MemFile *memfile,
+                            const char *filepath,
+                            const int write_flags,
+                            const bool use_save_versions,
+                            float *progress,
+                            ReportList *reports)
+{
+  char tempname[FILE_MAX + 1];
+  SNPRINTF(tempname, "%s@", filepath);
+
+  RawWriteWrap raw_wrap;
+  ZstdWriteWrap zstd_wrap(raw_wrap);
+  WriteWrap &ww = (write_flags & G_FILE_COMPRESS) ? static_cast<WriteWrap &>(zstd_wrap) :
+                                                     static_cast<WriteWrap &>(raw_wrap);
+
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  bool err = false;
+  size_t written_size = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    if (!ww.write(chunk->buf, chunk->size)) {
+      err = true;
+      break;
+    }
+    written_size += chunk->size;
+    if (progress) {
+      *progress = float(double(written_size) / double(std::max<size_t>(memfile->size, 1)));
+    }
+  }
+
+  if (!ww.close()) {
+    err = true;
+  }
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+
+    return false;
+  }
+
+  return write_file_finalize(tempname, filepath, use_save_versions, reports);
+}
+
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, const int write_flags)
 {
   bool use_userdef = false;
@@ -4,6 +4,16 @@
 #include "blendfile_loading_base_test.h"
 
 #include "BLI_path_utils.hh"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_lib_query.hh"
+#include "BKE_main.hh"
+
+#include "BLO_readfile.hh"
+
+#include "DNA_ID.h"
+#include "DNA_scene_types.h"
 
 class BlendfileLoadingTest : public BlendfileLoadingBaseTest {};
 
@@ -16,3 +26,91 @@ TEST_F(BlendfileLoadingTest, CanaryTest)
   depsgraph_create(DAG_EVAL_RENDER);
   EXPECT_NE(nullptr, this->depsgraph);
 }
+
+/* Names of the given ID and of all the IDs it uses, recursively. */
+static void collect_used_id_names(ID *id, blender::Set<std::string> &r_names)
+{
+  if (id == nullptr || !r_names.add(id->name)) {
+    return;
+  }
+  BKE_library_foreach_ID_link(
+      nullptr,
+      id,
+      [&](LibraryIDLinkCallbackData *cb_data) -> int {
+        if (cb_data->cb_flag & (IDWALK_CB_EMBEDDED | IDWALK_CB_EMBEDDED_NOT_OWNING |
+                                IDWALK_CB_LOOPBACK | IDWALK_CB_READFILE_IGNORE))
+        {
+          return IDWALK_RET_NOP;
+        }
+        collect_used_id_names(*cb_data->id_pointer, r_names);
+        return IDWALK_RET_NOP;
+      },
+      nullptr,
+      IDWALK_READONLY);
+}
+
+static blender::Set<std::string> main_id_names(Main *bmain)
+{
+  blender::Set<std::string> names;
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (GS(id->name) != ID_LI) {
+      names.add(id->name);
+    }
+  }
+  FOREACH_MAIN_ID_END;
+  return names;
+}
+
+TEST_F(BlendfileLoadingTest, LazyLoadActiveScene)
+{
+  if (!blendfile_load("modifier_stack" SEP_STR "array_test.blend")) {
+    return;
+  }
+  const std::string scene_name = bfile->curscene->id.name;
+  blender::Set<std::string> eager_used_names;
+  collect_used_id_names(&bfile->curscene->id, eager_used_names);
+  const blender::Set<std::string> eager_names = main_id_names(bfile->main);
+  blendfile_free();
+
+  if (!blendfile_load_lazy("modifier_stack" SEP_STR "array_test.blend")) {
+    return;
+  }
+  EXPECT_EQ(scene_name, bfile->curscene->id.name);
+
+  /* Everything used by the scene is read, and nothing that is not in the file. */
+  const blender::Set<std::string> lazy_names = main_id_names(bfile->main);
+  for (const std::string &name : eager_used_names) {
+    EXPECT_TRUE(lazy_names.contains(name)) << name;
+  }
+  for (const std::string &name : lazy_names) {
+    EXPECT_TRUE(eager_names.contains(name)) << name;
+  }
+
+  /* The lazily loaded scene must evaluate just like the fully loaded one. */
+  depsgraph_create(DAG_EVAL_RENDER);
+  EXPECT_NE(nullptr, this->depsgraph);
+}
+
+TEST_F(BlendfileLoadingTest, LazyLoadNamedRoot)
+{
+  if (!blendfile_load("modifier_stack" SEP_STR "array_test.blend")) {
+    return;
+  }
+  /* Pick an object which is not necessarily used by anything else. */
+  ASSERT_NE(bfile->main->objects.first, nullptr);
+  const std::string object_name = static_cast<ID *>(bfile->main->objects.first)->name;
+  blender::Set<std::string> eager_used_names;
+  collect_used_id_names(static_cast<ID *>(bfile->main->objects.first), eager_used_names);
+  blendfile_free();
+
+  const blender::Vector<std::string> root_idnames = {object_name};
+  if (!blendfile_load_lazy("modifier_stack" SEP_STR "array_test.blend", root_idnames)) {
+    return;
+  }
+  const blender::Set<std::string> lazy_names = main_id_names(bfile->main);
+  EXPECT_TRUE(lazy_names.contains(object_name));
+  for (const std::string &name : eager_used_names) {
+    EXPECT_TRUE(lazy_names.contains(name)) << name;
+  }
+}
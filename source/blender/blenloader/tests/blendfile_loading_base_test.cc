@@ -112,6 +112,18 @@ void BlendfileLoadingBaseTest::TearDown()
 }
 
 bool BlendfileLoadingBaseTest::blendfile_load(const char *filepath)
+{
+  return blendfile_load_ex(filepath, std::nullopt);
+}
+
+bool BlendfileLoadingBaseTest::blendfile_load_lazy(const char *filepath,
+                                                   blender::Span<std::string> root_idnames)
+{
+  return blendfile_load_ex(filepath, root_idnames);
+}
+
+bool BlendfileLoadingBaseTest::blendfile_load_ex(
+    const char *filepath, std::optional<blender::Span<std::string>> lazy_root_idnames)
 {
   const std::string &test_assets_dir = blender::tests::flags_test_asset_dir();
   if (test_assets_dir.empty()) {
@@ -122,13 +134,23 @@ bool BlendfileLoadingBaseTest::blendfile_load(const char *filepath)
   BLI_path_join(abspath, sizeof(abspath), test_assets_dir.c_str(), filepath);
 
   BlendFileReadReport bf_reports = {};
-  bfile = BLO_read_from_file(abspath, BLO_READ_SKIP_NONE, &bf_reports);
+  if (lazy_root_idnames) {
+    bfile = BLO_read_from_file_lazy(abspath, BLO_READ_SKIP_NONE, *lazy_root_idnames, &bf_reports);
+  }
+  else {
+    bfile = BLO_read_from_file(abspath, BLO_READ_SKIP_NONE, &bf_reports);
+  }
   if (bfile == nullptr) {
     ADD_FAILURE() << "Unable to load file '" << filepath << "' from test assets dir '"
                   << test_assets_dir << "'";
     return false;
   }
 
+  /* Lazy loading of a non-scene root may not read any scene. */
+  if (bfile->curscene == nullptr) {
+    return true;
+  }
+
   /* Make sure that all view_layers in the file are synced. Depsgraph can make a copy of the whole
    * scene, which will fail when one view layer isn't synced. */
   LISTBASE_FOREACH (ViewLayer *, view_layer, &bfile->curscene->view_layers) {
@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
+#include "BLI_span.hh"
+
 #include "DEG_depsgraph.hh"
 #include "testing/testing.h"
 
@@ -36,6 +41,11 @@ class BlendfileLoadingBaseTest : public testing::Test {
    * those will SEGFAULT.
    */
   bool blendfile_load(const char *filepath);
+  /* Same as #blendfile_load, but only reads the given root IDs and their dependencies, see
+   * #BLO_read_from_file_lazy. An empty list loads the active scene. */
+  bool blendfile_load_lazy(const char *filepath, blender::Span<std::string> root_idnames = {});
+  bool blendfile_load_ex(const char *filepath,
+                         std::optional<blender::Span<std::string>> lazy_root_idnames);
   /* Free bfile if it is not nullptr. */
   void blendfile_free();
 
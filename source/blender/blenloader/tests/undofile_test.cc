@@ -0,0 +1,130 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_vector.hh"
+
+#include "BLO_undofile.hh"
+
+namespace blender::blenloader::tests {
+
+static Vector<char> chunk_data(const int64_t size, const char seed)
+{
+  Vector<char> data(size);
+  for (const int64_t i : data.index_range()) {
+    data[i] = char(i * 7 + seed);
+  }
+  return data;
+}
+
+static MemFile *memfile_write(MemFile *reference, const Span<Vector<char>> chunks)
+{
+  MemFile *memfile = MEM_cnew<MemFile>(__func__);
+  MemFileWriteData mem_data{};
+  BLO_memfile_write_init(&mem_data, memfile, reference);
+  for (const Vector<char> &chunk : chunks) {
+    BLO_memfile_chunk_add(&mem_data, chunk.data(), size_t(chunk.size()));
+  }
+  BLO_memfile_write_finalize(&mem_data);
+  return memfile;
+}
+
+static Vector<char> memfile_read(MemFile *memfile)
+{
+  Vector<char> result;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    result.extend(Span(chunk->buf, int64_t(chunk->size)));
+  }
+  return result;
+}
+
+static void memfile_delete(MemFile *memfile)
+{
+  BLO_memfile_free(memfile);
+  MEM_freeN(memfile);
+}
+
+TEST(undofile, ShiftedChunksDeduplicated)
+{
+  const Vector<char> small = chunk_data(100, 1);
+  const Vector<char> large_a = chunk_data(32768, 2);
+  const Vector<char> large_b = chunk_data(32768, 3);
+
+  MemFile *first = memfile_write(nullptr, {large_a, large_b});
+  EXPECT_EQ(first->size, size_t(large_a.size() + large_b.size()));
+  EXPECT_EQ(first->size_deduplicated, size_t(0));
+
+  /* Inserting a chunk shifts all following ones, they are still shared. */
+  MemFile *second = memfile_write(first, {small, large_a, large_b});
+  EXPECT_EQ(second->size, size_t(small.size()));
+  EXPECT_EQ(second->size_deduplicated, size_t(large_a.size() + large_b.size()));
+
+  Vector<char> expected;
+  expected.extend(small);
+  expected.extend(large_a);
+  expected.extend(large_b);
+
+  /* Freeing the step that added the chunks keeps them alive for the next one. */
+  BLO_memfile_merge(first, second);
+  MEM_freeN(first);
+  EXPECT_EQ_ARRAY(expected.data(), memfile_read(second).data(), expected.size());
+
+  /* Identical chunk at the same position. */
+  MemFile *third = memfile_write(second, {small, large_a, large_b});
+  EXPECT_EQ(third->size, size_t(0));
+  EXPECT_EQ_ARRAY(expected.data(), memfile_read(third).data(), expected.size());
+
+  BLO_memfile_merge(second, third);
+  MEM_freeN(second);
+  memfile_delete(third);
+}
+
+TEST(undofile, ChunksAddedFromReference)
+{
+  const Vector<char> id_a = chunk_data(200, 1);
+  const Vector<char> id_b = chunk_data(300, 2);
+
+  MemFile *first = MEM_cnew<MemFile>(__func__);
+  MemFileWriteData mem_data{};
+  BLO_memfile_write_init(&mem_data, first, nullptr);
+  mem_data.current_id_session_uid = 1;
+  BLO_memfile_chunk_add(&mem_data, id_a.data(), size_t(id_a.size()));
+  BLO_memfile_chunk_add(&mem_data, id_a.data(), size_t(id_a.size()));
+  mem_data.current_id_session_uid = 2;
+  BLO_memfile_chunk_add(&mem_data, id_b.data(), size_t(id_b.size()));
+  BLO_memfile_write_finalize(&mem_data);
+
+  BLO_memfile_clear_future(first);
+  MemFile *second = MEM_cnew<MemFile>(__func__);
+  mem_data = {};
+  BLO_memfile_write_init(&mem_data, second, first);
+  EXPECT_FALSE(BLO_memfile_chunk_add_from_reference(&mem_data, 3));
+  EXPECT_TRUE(BLO_memfile_chunk_add_from_reference(&mem_data, 2));
+  EXPECT_TRUE(BLO_memfile_chunk_add_from_reference(&mem_data, 1));
+  BLO_memfile_write_finalize(&mem_data);
+
+  EXPECT_EQ(BLI_listbase_count(&second->chunks), 3);
+  EXPECT_EQ(second->size, size_t(0));
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &second->chunks) {
+    EXPECT_TRUE(chunk->is_identical);
+  }
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &first->chunks) {
+    EXPECT_TRUE(chunk->is_identical_future);
+  }
+
+  Vector<char> expected;
+  expected.extend(id_b);
+  expected.extend(id_a);
+  expected.extend(id_a);
+  EXPECT_EQ_ARRAY(expected.data(), memfile_read(second).data(), expected.size());
+
+  BLO_memfile_merge(first, second);
+  MEM_freeN(first);
+  memfile_delete(second);
+}
+
+}  // namespace blender::blenloader::tests
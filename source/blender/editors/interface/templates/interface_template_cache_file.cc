@@ -126,6 +126,9 @@ void uiTemplateCacheFileTimeSettings(uiLayout *layout, PointerRNA *fileptr)
   row = uiLayoutRow(layout, false);
   uiItemR(row, fileptr, "frame_offset", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   uiLayoutSetActive(row, !RNA_boolean_get(fileptr, "is_sequence"));
+
+  row = uiLayoutRow(layout, false);
+  uiItemR(row, fileptr, "playback_prefetch_frames", UI_ITEM_NONE, std::nullopt, ICON_NONE);
 }
 
 static void cache_file_layer_item(uiList * /*ui_list*/,
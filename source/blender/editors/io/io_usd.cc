@@ -977,6 +977,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   const bool import_subdiv = RNA_boolean_get(op->ptr, "import_subdiv");
 
   const bool support_scene_instancing = RNA_boolean_get(op->ptr, "support_scene_instancing");
+  const bool share_instance_meshes = RNA_boolean_get(op->ptr, "share_instance_meshes");
 
   const bool import_visible_only = RNA_boolean_get(op->ptr, "import_visible_only");
 
@@ -1051,6 +1052,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   params.create_collection = create_collection;
   params.create_world_material = create_world_material;
   params.support_scene_instancing = support_scene_instancing;
+  params.share_instance_meshes = share_instance_meshes;
 
   params.import_shapes = import_shapes;
   params.import_skeletons = import_skeletons;
@@ -1199,6 +1201,9 @@ static void wm_usd_import_draw(bContext *C, wmOperator *op)
   {
     uiLayout *col = uiLayoutColumn(panel, false);
     uiItemR(col, ptr, "support_scene_instancing", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+    uiLayout *row = uiLayoutRow(col, true);
+    uiItemR(row, ptr, "share_instance_meshes", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+    uiLayoutSetEnabled(row, !RNA_boolean_get(ptr, "support_scene_instancing"));
   }
 }
 
@@ -1268,6 +1273,13 @@ void WM_OT_usd_import(wmOperatorType *ot)
                   "Scene Instancing",
                   "Import USD scene graph instances as collection instances");
 
+  RNA_def_boolean(ot->srna,
+                  "share_instance_meshes",
+                  false,
+                  "Share Instance Meshes",
+                  "When scene instancing is disabled, let the objects created for instances of "
+                  "the same USD prototype share their mesh data instead of duplicating it");
+
   RNA_def_boolean(ot->srna,
                   "import_visible_only",
                   true,
@@ -224,6 +224,15 @@ struct BakeGeometryNodesJob {
   Vector<NodeBakeRequest> bake_requests;
 };
 
+static bake::BlobCompression get_blob_compression(const NodeBakeRequest &request)
+{
+  const NodesModifierBake *bake = request.nmd->find_bake(request.bake_id);
+  if (bake && (bake->flag & NODES_MODIFIER_BAKE_COMPRESS)) {
+    return bake::BlobCompression::Zstd;
+  }
+  return bake::BlobCompression::None;
+}
+
 static void request_bakes_in_modifier_cache(BakeGeometryNodesJob &job)
 {
   for (NodeBakeRequest &request : job.bake_requests) {
@@ -323,6 +332,7 @@ static void bake_geometry_nodes_startjob(void *customdata, wmJobWorkerStatus *wo
                       (frame_file_name + ".json").c_str());
         BLI_file_ensure_parent_dir_exists(meta_path);
         bake::DiskBlobWriter blob_writer{request.path->blobs_dir, frame_file_name};
+        blob_writer.set_compression(get_blob_compression(request));
         fstream meta_file{meta_path, std::ios::out};
         bake::serialize_bake(frame_cache.state, blob_writer, *request.blob_sharing, meta_file);
         written_size += blob_writer.written_size();
@@ -332,6 +342,7 @@ static void bake_geometry_nodes_startjob(void *customdata, wmJobWorkerStatus *wo
         PackedBake &packed_data = packed_data_by_bake.lookup_or_add_default(&request);
 
         bake::MemoryBlobWriter blob_writer{frame_file_name};
+        blob_writer.set_compression(get_blob_compression(request));
         std::ostringstream meta_file{std::ios::binary};
         bake::serialize_bake(frame_cache.state, blob_writer, *request.blob_sharing, meta_file);
 
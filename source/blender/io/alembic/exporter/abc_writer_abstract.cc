@@ -31,6 +31,15 @@ bool ABCAbstractWriter::is_supported(const HierarchyContext * /*context*/) const
   return true;
 }
 
+void ABCAbstractWriter::extract(const HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    /* Nothing will be written, see write(). */
+    return;
+  }
+  do_extract(context);
+}
+
 void ABCAbstractWriter::write(HierarchyContext &context)
 {
   if (!frame_has_been_written_) {
@@ -34,6 +34,7 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
  public:
   explicit ABCAbstractWriter(const ABCWriterConstructorArgs &args);
 
+  void extract(const HierarchyContext &context) override;
   void write(HierarchyContext &context) override;
 
   /* Returns true if the data to be written is actually supported. This would, for example, allow a
@@ -65,6 +66,8 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
   virtual Alembic::Abc::OCompoundProperty abc_prop_for_custom_props() = 0;
 
  protected:
+  /* See AbstractHierarchyWriter::extract(). This must not use the Alembic API. */
+  virtual void do_extract(const HierarchyContext & /*context*/) {}
   virtual void do_write(HierarchyContext &context) = 0;
 
   virtual void update_bounding_box(Object *object);
@@ -132,8 +132,48 @@ bool ABCGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return true;
 }
 
-void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+struct ABCGenericMeshWriter::ExtractedMesh {
+  Mesh *mesh = nullptr;
+  bool needsfree = false;
+
+  std::optional<io::ContentHash> hash;
+  /* The mesh is the same as in the previous sample, nothing else is extracted. */
+  bool is_unchanged = false;
+
+  std::vector<Imath::V3f> points;
+  std::vector<int32_t> face_verts;
+  std::vector<int32_t> loop_counts;
+
+  /* Only for poly-meshes. */
+  std::vector<Imath::V3f> normals;
+  std::vector<Imath::V3f> velocities;
+  bool has_velocities = false;
+
+  /* Only for subdivision surfaces. */
+  std::vector<int32_t> edge_crease_indices;
+  std::vector<int32_t> edge_crease_lengths;
+  std::vector<float> edge_crease_sharpness;
+  std::vector<int32_t> vert_crease_indices;
+  std::vector<float> vert_crease_sharpness;
+};
+
+ABCGenericMeshWriter::~ABCGenericMeshWriter()
 {
+  release_extracted();
+}
+
+void ABCGenericMeshWriter::release_extracted()
+{
+  if (extracted_ && extracted_->needsfree) {
+    free_export_mesh(extracted_->mesh);
+  }
+  extracted_.reset();
+}
+
+void ABCGenericMeshWriter::do_extract(const HierarchyContext &context)
+{
+  release_extracted();
+
   Object *object = context.object;
   bool needsfree = false;
 
@@ -146,6 +186,21 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
   /* Ensure data exists if currently in edit mode. */
   BKE_mesh_wrapper_ensure_mdata(mesh);
 
+  /* Compare with the previous sample before triangulating, so that can be skipped as well. */
+  std::optional<io::ContentHash> hash;
+  if (args_.export_params->frame_start != args_.export_params->frame_end) {
+    hash = io::mesh_content_hash(*mesh);
+    if (frame_has_been_written_ && hash == written_hash_) {
+      if (needsfree) {
+        free_export_mesh(mesh);
+      }
+      extracted_ = std::make_unique<ExtractedMesh>();
+      extracted_->hash = hash;
+      extracted_->is_unchanged = true;
+      return;
+    }
+  }
+
   if (args_.export_params->triangulate) {
     const bool tag_only = false;
     const int quad_method = args_.export_params->quad_method;
@@ -169,6 +224,51 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     needsfree = true;
   }
 
+  extracted_ = std::make_unique<ExtractedMesh>();
+  ExtractedMesh &data = *extracted_;
+  data.mesh = mesh;
+  data.needsfree = needsfree;
+  data.hash = hash;
+
+  get_vertices(mesh, data.points);
+  get_topology(mesh, data.face_verts, data.loop_counts);
+
+  if (is_subd_) {
+    get_edge_creases(
+        mesh, data.edge_crease_indices, data.edge_crease_lengths, data.edge_crease_sharpness);
+    get_vert_creases(mesh, data.vert_crease_indices, data.vert_crease_sharpness);
+  }
+  else {
+    if (args_.export_params->normals) {
+      get_loop_normals(mesh, data.normals);
+    }
+    data.has_velocities = get_velocities(mesh, data.velocities);
+  }
+}
+
+void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  if (!extracted_) {
+    /* write() was called without extract(), see AbstractHierarchyWriter::extract(). */
+    do_extract(context);
+  }
+  if (!extracted_) {
+    return;
+  }
+
+  if (extracted_->is_unchanged) {
+    if (is_subd_) {
+      abc_subdiv_schema_.setFromPrevious();
+    }
+    else {
+      abc_poly_mesh_schema_.setFromPrevious();
+    }
+    write_custom_data_from_previous(m_custom_data_config);
+    release_extracted();
+    return;
+  }
+
+  Mesh *mesh = extracted_->mesh;
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mesh = mesh;
   m_custom_data_config.face_offsets = mesh->face_offsets_for_write().data();
@@ -180,20 +280,17 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
 
   try {
     if (is_subd_) {
-      write_subd(context, mesh);
+      write_subd(context, *extracted_);
     }
     else {
-      write_mesh(context, mesh);
+      write_mesh(context, *extracted_);
     }
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    written_hash_ = extracted_->hash;
+    release_extracted();
   }
   catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    release_extracted();
     throw;
   }
 }
@@ -203,21 +300,18 @@ void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(nullptr, mesh);
 }
 
-void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, ExtractedMesh &data)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> face_verts, loop_counts;
-  std::vector<Imath::V3f> velocities;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
+  Mesh *mesh = data.mesh;
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
   }
 
   OPolyMeshSchema::Sample mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(face_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(data.points),
+      Int32ArraySample(data.face_verts),
+      Int32ArraySample(data.loop_counts));
 
   UVSample uvs_and_indices;
 
@@ -241,12 +335,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals);
-
     ON3fGeomParam::Sample normals_sample;
-    if (!normals.empty()) {
+    if (!data.normals.empty()) {
       normals_sample.setScope(kFacevaryingScope);
-      normals_sample.setVals(V3fArraySample(normals));
+      normals_sample.setVals(V3fArraySample(data.normals));
     }
 
     mesh_sample.setNormals(normals_sample);
@@ -256,8 +348,8 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     write_generated_coordinates(abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (get_velocities(mesh, velocities)) {
-    mesh_sample.setVelocities(V3fArraySample(velocities));
+  if (data.has_velocities) {
+    mesh_sample.setVelocities(V3fArraySample(data.velocities));
   }
 
   update_bounding_box(context.object);
@@ -268,24 +360,17 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_arb_geo_params(mesh);
 }
 
-void ABCGenericMeshWriter::write_subd(HierarchyContext &context, Mesh *mesh)
+void ABCGenericMeshWriter::write_subd(HierarchyContext &context, ExtractedMesh &data)
 {
-  std::vector<float> edge_crease_sharpness, vert_crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> face_verts, loop_counts;
-  std::vector<int32_t> edge_crease_indices, edge_crease_lengths, vert_crease_indices;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
-  get_edge_creases(mesh, edge_crease_indices, edge_crease_lengths, edge_crease_sharpness);
-  get_vert_creases(mesh, vert_crease_indices, vert_crease_sharpness);
+  Mesh *mesh = data.mesh;
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_subdiv_schema_);
   }
 
-  OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(face_verts), Int32ArraySample(loop_counts));
+  OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(V3fArraySample(data.points),
+                                                          Int32ArraySample(data.face_verts),
+                                                          Int32ArraySample(data.loop_counts));
 
   UVSample sample;
   if (args_.export_params->uvs) {
@@ -311,15 +396,15 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, Mesh *mesh)
     write_generated_coordinates(abc_subdiv_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (!edge_crease_indices.empty()) {
-    subdiv_sample.setCreaseIndices(Int32ArraySample(edge_crease_indices));
-    subdiv_sample.setCreaseLengths(Int32ArraySample(edge_crease_lengths));
-    subdiv_sample.setCreaseSharpnesses(FloatArraySample(edge_crease_sharpness));
+  if (!data.edge_crease_indices.empty()) {
+    subdiv_sample.setCreaseIndices(Int32ArraySample(data.edge_crease_indices));
+    subdiv_sample.setCreaseLengths(Int32ArraySample(data.edge_crease_lengths));
+    subdiv_sample.setCreaseSharpnesses(FloatArraySample(data.edge_crease_sharpness));
   }
 
-  if (!vert_crease_indices.empty()) {
-    subdiv_sample.setCornerIndices(Int32ArraySample(vert_crease_indices));
-    subdiv_sample.setCornerSharpnesses(FloatArraySample(vert_crease_sharpness));
+  if (!data.vert_crease_indices.empty()) {
+    subdiv_sample.setCornerIndices(Int32ArraySample(data.vert_crease_indices));
+    subdiv_sample.setCornerSharpnesses(FloatArraySample(data.vert_crease_sharpness));
   }
 
   update_bounding_box(context.object);
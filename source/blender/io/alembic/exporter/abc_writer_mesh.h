@@ -7,12 +7,16 @@
  * \ingroup balembic
  */
 
+#include "IO_content_hash.hh"
 #include "abc_writer_abstract.h"
 #include "intern/abc_customdata.h"
 
 #include <Alembic/AbcGeom/OPolyMesh.h>
 #include <Alembic/AbcGeom/OSubD.h>
 
+#include <memory>
+#include <optional>
+
 struct ModifierData;
 
 namespace blender::io::alembic {
@@ -36,8 +40,16 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   CDStreamConfig m_custom_data_config;
 
+  /* Export mesh of the current frame and the Alembic arrays converted from it. */
+  struct ExtractedMesh;
+  std::unique_ptr<ExtractedMesh> extracted_;
+
+  /* Hash of the export mesh of the last written sample, only set when exporting animation. */
+  std::optional<io::ContentHash> written_hash_;
+
  public:
   explicit ABCGenericMeshWriter(const ABCWriterConstructorArgs &args);
+  ~ABCGenericMeshWriter() override;
 
   void create_alembic_objects(const HierarchyContext *context) override;
   Alembic::Abc::OObject get_alembic_object() const override;
@@ -45,6 +57,7 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
  protected:
   bool is_supported(const HierarchyContext *context) const override;
+  void do_extract(const HierarchyContext &context) override;
   void do_write(HierarchyContext &context) override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
@@ -53,8 +66,10 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
  private:
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void write_subd(HierarchyContext &context, Mesh *mesh);
+  void release_extracted();
+
+  void write_mesh(HierarchyContext &context, ExtractedMesh &data);
+  void write_subd(HierarchyContext &context, ExtractedMesh &data);
   template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
 
   void write_arb_geo_params(Mesh *mesh);
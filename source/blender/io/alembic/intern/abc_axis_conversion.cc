@@ -12,6 +12,7 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_object_types.hh"
 
@@ -19,6 +20,17 @@
 
 namespace blender::io::alembic {
 
+void copy_zup_from_yup(MutableSpan<float3> zup, const Span<float3> yup)
+{
+  BLI_assert(zup.size() == yup.size());
+  threading::parallel_for(yup.index_range(), 8192, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const float3 value = yup[i];
+      zup[i] = float3(value.x, -value.z, value.y);
+    }
+  });
+}
+
 void create_swapped_rotation_matrix(float rot_x_mat[3][3],
                                     float rot_y_mat[3][3],
                                     float rot_z_mat[3][3],
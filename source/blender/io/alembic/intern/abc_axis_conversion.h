@@ -8,6 +8,8 @@
  */
 
 #include "BLI_compiler_compat.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 struct Object;
 
@@ -36,6 +38,12 @@ BLI_INLINE void copy_zup_from_yup(short zup[3], const short yup[3])
   zup[2] = old_yup1;
 }
 
+/**
+ * Copy an array of vectors from Y-up to Z-up, on multiple threads for large arrays. The loop only
+ * moves and negates components, so that the compiler can vectorize it.
+ */
+void copy_zup_from_yup(MutableSpan<float3> zup, Span<float3> yup);
+
 /* Copy from Z-up to Y-up. */
 
 BLI_INLINE void copy_yup_from_zup(float yup[3], const float zup[3])
@@ -8,6 +8,7 @@
 
 #include "abc_customdata.h"
 #include "abc_axis_conversion.h"
+#include "abc_util.h"
 
 #include <Alembic/Abc/ICompoundProperty.h>
 #include <Alembic/Abc/ISampleSelector.h>
@@ -25,6 +26,7 @@
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_attribute.hh"
@@ -305,6 +307,19 @@ void write_custom_data(const OCompoundProperty &prop,
   }
 }
 
+void write_custom_data_from_previous(CDStreamConfig &config)
+{
+  for (std::pair<const std::string, OV2fGeomParam> &item : config.abc_uv_maps) {
+    item.second.setFromPrevious();
+  }
+  for (std::pair<const std::string, OC4fGeomParam> &item : config.abc_vertex_colors) {
+    item.second.setFromPrevious();
+  }
+  if (config.abc_orco.valid()) {
+    config.abc_orco.setFromPrevious();
+  }
+}
+
 /* ************************************************************************** */
 
 using Alembic::Abc::C3fArraySamplePtr;
@@ -525,12 +540,16 @@ void read_velocity(const V3fArraySamplePtr &velocities,
   AttributeOwner owner = AttributeOwner::from_id(&config.mesh->id);
   CustomDataLayer *velocity_layer = BKE_attribute_new(
       owner, "velocity", CD_PROP_FLOAT3, bke::AttrDomain::Point, nullptr);
-  float(*velocity)[3] = (float(*)[3])velocity_layer->data;
-
-  for (int i = 0; i < num_velocity_vectors; i++) {
-    const Imath::V3f &vel_in = (*velocities)[i];
-    copy_zup_from_yup(velocity[i], vel_in.getValue());
-    mul_v3_fl(velocity[i], velocity_scale);
+  MutableSpan<float3> velocity(static_cast<float3 *>(velocity_layer->data),
+                               num_velocity_vectors);
+
+  copy_zup_from_yup(velocity, float3_span(velocities));
+  if (velocity_scale != 1.0f) {
+    threading::parallel_for(velocity.index_range(), 8192, [&](const IndexRange range) {
+      for (float3 &value : velocity.slice(range)) {
+        value *= velocity_scale;
+      }
+    });
   }
 }
 
@@ -573,10 +592,8 @@ void read_generated_coordinates(const ICompoundProperty &prop,
   }
 
   float(*orcodata)[3] = static_cast<float(*)[3]>(cd_data);
-  for (int vertex_idx = 0; vertex_idx < totvert; ++vertex_idx) {
-    const Imath::V3f &abc_coords = (*abc_orco)[vertex_idx];
-    copy_zup_from_yup(orcodata[vertex_idx], abc_coords.getValue());
-  }
+  copy_zup_from_yup(MutableSpan(reinterpret_cast<float3 *>(orcodata), int64_t(totvert)),
+                    float3_span(abc_orco));
 
   /* ORCOs are always stored in the normalized 0..1 range in Blender, but Alembic stores them
    * unnormalized, so we need to normalize them. */
@@ -98,6 +98,10 @@ void write_custom_data(const OCompoundProperty &prop,
                        CustomData *data,
                        int data_type);
 
+/* Repeat the previous sample of all properties written by #write_custom_data and
+ * #write_generated_coordinates, for frames in which the data didn't change. */
+void write_custom_data_from_previous(CDStreamConfig &config);
+
 void read_custom_data(const std::string &iobject_full_name,
                       const ICompoundProperty &prop,
                       const CDStreamConfig &config,
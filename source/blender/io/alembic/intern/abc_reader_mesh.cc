@@ -11,6 +11,8 @@
 #include "abc_customdata.h"
 #include "abc_util.h"
 
+#include <atomic>
+
 #include "DNA_customdata_types.h"
 #include "DNA_material_types.h"
 #include "DNA_modifier_types.h"
@@ -21,7 +23,10 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_ordered_edge.hh"
+#include "BLI_task.hh"
 
 #include "BLT_translation.hh"
 
@@ -123,6 +128,9 @@ struct AbcMeshData {
   AbcUvScope uv_scope;
   V2fArraySamplePtr uvs;
   UInt32ArraySamplePtr uvs_indices;
+
+  Alembic::AbcGeom::GeometryScope normals_scope = Alembic::AbcGeom::kUnknownScope;
+  N3fArraySamplePtr normals;
 };
 
 static void read_mverts_interp(float3 *vert_positions,
@@ -130,14 +138,15 @@ static void read_mverts_interp(float3 *vert_positions,
                                const P3fArraySamplePtr &ceil_positions,
                                const double weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
-
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
-    copy_zup_from_yup(vert_positions[i], tmp);
-  }
+  const Span<float3> floor_positions = float3_span(positions);
+  const Span<float3> ceil_positions_span = float3_span(ceil_positions);
+  threading::parallel_for(floor_positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const float3 pos = math::interpolate(
+          floor_positions[i], ceil_positions_span[i], float(weight));
+      vert_positions[i] = float3(pos.x, -pos.z, pos.y);
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -162,19 +171,13 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
   MutableSpan<float3> vert_positions = mesh.vert_positions_for_write();
-  for (int i = 0; i < positions->size(); i++) {
-    Imath::V3f pos_in = (*positions)[i];
-
-    copy_zup_from_yup(vert_positions[i], pos_in.getValue());
-  }
+  copy_zup_from_yup(vert_positions.take_front(positions->size()), float3_span(positions));
   mesh.tag_positions_changed();
 
   if (normals) {
     Vector<float3> vert_normals(mesh.verts_num);
-    for (const int64_t i : IndexRange(normals->size())) {
-      Imath::V3f nor_in = (*normals)[i];
-      copy_zup_from_yup(vert_normals[i], nor_in.getValue());
-    }
+    copy_zup_from_yup(vert_normals.as_mutable_span().take_front(normals->size()),
+                      float3_span(normals));
     bke::mesh_vert_normals_assign(mesh, std::move(vert_normals));
   }
 }
@@ -195,47 +198,56 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
   const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
   BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
-  uint loop_index = 0;
-  uint rev_loop_index = 0;
-  uint uv_index = 0;
-  bool seen_invalid_geometry = false;
 
-  for (int i = 0; i < face_counts->size(); i++) {
-    const int face_size = (*face_counts)[i];
-
-    face_offsets[i] = loop_index;
-
-    /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
-     * this is encoded in custom loop normals. See #71246. */
-
-    /* NOTE: Alembic data is stored in the reverse order. */
-    rev_loop_index = loop_index + (face_size - 1);
-
-    uint last_vertex_index = 0;
-    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
-      const int vert = (*face_indices)[loop_index];
-      corner_verts[rev_loop_index] = vert;
+  /* The offsets are needed to process faces independently. */
+  const int faces_num = int(face_counts->size());
+  MutableSpan<int> offsets(face_offsets, faces_num + 1);
+  offsets.take_front(faces_num).copy_from(Span<int>(face_counts->get(), faces_num));
+  const OffsetIndices<int> faces = offset_indices::accumulate_counts_to_offsets(offsets);
+  const Span<int> abc_corner_verts(face_indices->get(), int64_t(face_indices->size()));
+
+  std::atomic<bool> seen_invalid_geometry = false;
+
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    bool seen_invalid_face = false;
+    for (const int face_index : range) {
+      const IndexRange face = faces[face_index];
+
+      /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be
+       * flat-shaded, this is encoded in custom loop normals. See #71246. */
+
+      uint last_vertex_index = 0;
+      for (const int f : IndexRange(face.size())) {
+        const int loop_index = face[f];
+        /* NOTE: Alembic data is stored in the reverse order. */
+        const int rev_loop_index = face.last(f);
+        const int vert = abc_corner_verts[loop_index];
+        corner_verts[rev_loop_index] = vert;
+
+        if (f > 0 && vert == last_vertex_index) {
+          /* This face is invalid, as it has consecutive loops from the same vertex. This is
+           * caused by invalid geometry in the Alembic file, such as in #76514. */
+          seen_invalid_face = true;
+        }
+        last_vertex_index = vert;
 
-      if (f > 0 && vert == last_vertex_index) {
-        /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
-         * by invalid geometry in the Alembic file, such as in #76514. */
-        seen_invalid_geometry = true;
-      }
-      last_vertex_index = vert;
+        if (do_uvs) {
+          const uint uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : last_vertex_index];
 
-      if (do_uvs) {
-        uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : last_vertex_index];
+          /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+          if (uv_index >= uvs_size) {
+            continue;
+          }
 
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
+          mloopuvs[rev_loop_index][0] = (*uvs)[uv_index][0];
+          mloopuvs[rev_loop_index][1] = (*uvs)[uv_index][1];
         }
-
-        mloopuvs[rev_loop_index][0] = (*uvs)[uv_index][0];
-        mloopuvs[rev_loop_index][1] = (*uvs)[uv_index][1];
       }
     }
-  }
+    if (seen_invalid_face) {
+      seen_invalid_geometry.store(true, std::memory_order_relaxed);
+    }
+  });
 
   bke::mesh_calc_edges(*config.mesh, false, false);
   if (seen_invalid_geometry) {
@@ -273,16 +285,17 @@ static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr
   Array<float3> corner_normals(loop_count);
 
   const OffsetIndices faces = mesh->faces();
-  const N3fArraySample &loop_normals = *loop_normals_ptr;
-  int abc_index = 0;
-  for (int i = 0, e = mesh->faces_num; i < e; i++) {
-    const IndexRange face = faces[i];
-    /* As usual, ABC orders the loops in reverse. */
-    for (int j = face.size() - 1; j >= 0; j--, abc_index++) {
-      int blender_index = face[j];
-      copy_zup_from_yup(corner_normals[blender_index], loop_normals[abc_index].getValue());
+  const Span<float3> loop_normals = float3_span(loop_normals_ptr);
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      /* As usual, ABC orders the loops in reverse. */
+      for (const int j : face.index_range()) {
+        const float3 &normal = loop_normals[face[j]];
+        corner_normals[face.last(j)] = float3(normal.x, -normal.z, normal.y);
+      }
     }
-  }
+  });
 
   bke::mesh_set_custom_normals(*mesh, corner_normals);
 }
@@ -297,34 +310,38 @@ static void process_vertex_normals(CDStreamConfig &config,
   }
 
   Array<float3> vert_normals(normals_count);
-
-  const N3fArraySample &vertex_normals = *vertex_normals_ptr;
-  for (int index = 0; index < normals_count; index++) {
-    copy_zup_from_yup(vert_normals[index], vertex_normals[index].getValue());
-  }
+  copy_zup_from_yup(vert_normals, float3_span(vertex_normals_ptr));
 
   bke::mesh_set_custom_normals_from_verts(*config.mesh, vert_normals);
 }
 
-static void process_normals(CDStreamConfig &config,
-                            const IN3fGeomParam &normals,
-                            const ISampleSelector &selector)
+static void read_normals_params(AbcMeshData &abc_data,
+                                const IN3fGeomParam &normals,
+                                const ISampleSelector &selector)
 {
   if (!normals.valid()) {
-    process_no_normals(config);
     return;
   }
 
   IN3fGeomParam::Sample normsamp = normals.getExpandedValue(selector);
-  Alembic::AbcGeom::GeometryScope scope = normals.getScope();
+  abc_data.normals_scope = normals.getScope();
+  abc_data.normals = normsamp.getVals();
+}
 
-  switch (scope) {
+static void process_normals(CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  if (!mesh_data.normals) {
+    process_no_normals(config);
+    return;
+  }
+
+  switch (mesh_data.normals_scope) {
     case Alembic::AbcGeom::kFacevaryingScope: /* 'Vertex Normals' in Houdini. */
-      process_loop_normals(config, normsamp.getVals());
+      process_loop_normals(config, mesh_data.normals);
       break;
     case Alembic::AbcGeom::kVertexScope:
     case Alembic::AbcGeom::kVaryingScope: /* 'Point Normals' in Houdini. */
-      process_vertex_normals(config, normsamp.getVals());
+      process_vertex_normals(config, mesh_data.normals);
       break;
     case Alembic::AbcGeom::kConstantScope:
     case Alembic::AbcGeom::kUniformScope:
@@ -455,10 +472,16 @@ static void read_mesh_sample(const std::string &iobject_full_name,
     }
   }
 
+  /* Fetch all samples before converting them, the conversion of large arrays is multi-threaded
+   * and shouldn't wait for file access in between. */
   if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
     read_uvs_params(config, abc_mesh_data, schema.getUVsParam(), selector);
   }
 
+  if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
+    read_normals_params(abc_mesh_data, schema.getNormalsParam(), selector);
+  }
+
   if ((settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
     read_mverts(config, abc_mesh_data);
     read_generated_coordinates(schema.getArbGeomParams(), config, selector);
@@ -466,7 +489,7 @@ static void read_mesh_sample(const std::string &iobject_full_name,
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
     read_mpolys(config, abc_mesh_data);
-    process_normals(config, schema.getNormalsParam(), selector);
+    process_normals(config, abc_mesh_data);
   }
 
   if ((settings->read_flag & (MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR)) != 0) {
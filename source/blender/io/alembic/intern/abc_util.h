@@ -22,6 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
 using Alembic::Abc::chrono_t;
 using Alembic::Abc::V3fArraySamplePtr;
 
@@ -54,6 +57,15 @@ void convert_matrix_datatype(const Imath::M44d &xform, float r_mat[4][4]);
 
 void split(const std::string &s, char delim, std::vector<std::string> &tokens);
 
+/**
+ * View the values of an Alembic array sample of 3D float vectors, like positions or normals.
+ */
+template<typename ArraySamplePtr> Span<float3> float3_span(const ArraySamplePtr &sample)
+{
+  static_assert(sizeof(typename ArraySamplePtr::element_type::value_type) == sizeof(float3));
+  return {reinterpret_cast<const float3 *>(sample->get()), int64_t(sample->size())};
+}
+
 template<class TContainer> bool begins_with(const TContainer &input, const TContainer &match)
 {
   return input.size() >= match.size() && std::equal(match.begin(), match.end(), input.begin());
@@ -7,6 +7,7 @@
 /* Keep first since `BLI_utildefines.h` defines `AT` which conflicts with STL. */
 #include "intern/abc_axis_conversion.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_base.h"
 #include "BLI_math_matrix.h"
 
@@ -289,4 +290,22 @@ TEST(abc_matrix, CopyM44AxisSwapWithScale_gimbal_ZfromY)
   EXPECT_M4_NEAR(expect, result, 1e-5f);
 }
 
+TEST(abc_matrix, CopyZupFromYupArray)
+{
+  /* Large enough to be converted on multiple threads. */
+  Array<float3> yup(100000);
+  for (const int64_t i : yup.index_range()) {
+    yup[i] = float3(float(i), float(i) * 2.0f, float(i) * -3.0f);
+  }
+
+  Array<float3> zup(yup.size());
+  copy_zup_from_yup(zup, yup);
+
+  for (const int64_t i : yup.index_range()) {
+    float3 expect;
+    copy_zup_from_yup(expect, yup[i]);
+    EXPECT_EQ(expect, zup[i]);
+  }
+}
+
 }  // namespace blender::io::alembic
@@ -27,6 +27,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 struct Depsgraph;
 struct DupliObject;
@@ -125,6 +126,16 @@ struct HierarchyContext {
 class AbstractHierarchyWriter {
  public:
   virtual ~AbstractHierarchyWriter() = default;
+
+  /* Convert evaluated Blender data into export-ready buffers for the next write() call.
+   *
+   * The AbstractHierarchyIterator calls this for a batch of writers before any of them writes,
+   * from multiple threads at the same time. Implementations must therefore not touch the exported
+   * file, nor any state that is shared with other writers. Each extract() call is followed by one
+   * write() call with the same context on the calling thread, which should release the extracted
+   * data once it has been written. write() must also work without a preceding extract() call.
+   * The default implementation does nothing, in which case all work is done in write(). */
+  virtual void extract(const HierarchyContext & /*context*/) {}
   virtual void write(HierarchyContext &context) = 0;
   /* TODO(Sybren): add function like absent() that's called when a writer was previously created,
    * but wasn't used while exporting the current frame (for example, a particle-instanced mesh of
@@ -171,6 +182,8 @@ class EnsuredWriter {
   /* These operators make an EnsuredWriter* act as an AbstractHierarchyWriter* */
   operator bool() const;
   AbstractHierarchyWriter *operator->();
+
+  AbstractHierarchyWriter *get() const;
 };
 
 /* Unique identifier for a (potentially duplicated) object.
@@ -220,6 +233,15 @@ class AbstractHierarchyIterator {
   /* IDs of all duplisource objects, used to identify instance prototypes. */
   using DupliSources = std::set<ID *>;
 
+ private:
+  /* A writer that should write in the current iteration, with the context to write. */
+  struct PendingWrite {
+    AbstractHierarchyWriter *writer;
+    HierarchyContext context;
+  };
+  /* Writes in export hierarchy order, collected by make_writers(). */
+  std::vector<PendingWrite> pending_writes_;
+
  protected:
   ExportGraph export_graph_;
   ExportPathMap duplisource_export_path_;
@@ -284,11 +306,14 @@ class AbstractHierarchyIterator {
   bool determine_duplication_references(const HierarchyContext *parent_context,
                                         const std::string &indent);
 
-  /* These three functions create writers and call their write() method. */
+  /* These three functions create writers and schedule a call to their write() method. */
   void make_writers(const HierarchyContext *parent_context);
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *transform_context);
 
+  /* Let all scheduled writers extract their data in parallel, then write it in order. */
+  void write_pending();
+
   /* Return the appropriate HierarchyContext for the data of the object represented by
    * object_context. */
   HierarchyContext context_for_object_data(const HierarchyContext *object_context) const;
@@ -0,0 +1,32 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+#include "BLI_struct_equality_utils.hh"
+
+#include <cstdint>
+
+struct Mesh;
+
+namespace blender::io {
+
+/**
+ * 128 bit hash of the data that an exporter writes for some geometry. This code is shared between
+ * the Alembic and USD exporters, which use it to detect frames in which the exported data doesn't
+ * change, so that the previous sample can be reused.
+ */
+struct ContentHash {
+  uint64_t v1 = 0;
+  uint64_t v2 = 0;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_2(ContentHash, v1, v2)
+};
+
+/**
+ * Hash the topology and all attributes of the mesh, including vertex groups and generated
+ * coordinates. Meshes with the same hash export to the same data.
+ */
+ContentHash mesh_content_hash(const Mesh &mesh);
+
+}  // namespace blender::io
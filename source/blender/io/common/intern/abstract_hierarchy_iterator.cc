@@ -4,6 +4,7 @@
 #include "IO_abstract_hierarchy_iterator.h"
 #include "dupli_parent_finder.hh"
 
+#include <algorithm>
 #include <string>
 
 #include <fmt/core.h>
@@ -17,6 +18,7 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -126,6 +128,11 @@ AbstractHierarchyWriter *EnsuredWriter::operator->()
   return writer_;
 }
 
+AbstractHierarchyWriter *EnsuredWriter::get() const
+{
+  return writer_;
+}
+
 bool AbstractHierarchyWriter::check_is_animated(const HierarchyContext &context) const
 {
   Object *object = context.object;
@@ -189,6 +196,7 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_export_paths(HierarchyContext::root());
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
+  write_pending();
   export_graph_clear();
 }
 
@@ -635,7 +643,7 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
       /* XXX This can lead to too many XForms being written. For example, a camera writer can
        * refuse to write an orthographic camera. By the time that this is known, the XForm has
        * already been written. */
-      transform_writer->write(*context);
+      pending_writes_.push_back({transform_writer.get(), *context});
     }
 
     if (!context->weak_export && include_data_writers(context)) {
@@ -653,6 +661,30 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
    */
 }
 
+void AbstractHierarchyIterator::write_pending()
+{
+  std::vector<PendingWrite> pending_writes = std::move(pending_writes_);
+  pending_writes_.clear();
+
+  /* Converting the evaluated data is independent per writer. Writing is done serially, because
+   * the Alembic and USD libraries are not thread-safe. Extracted data is kept until it is written,
+   * so writers are handled in batches to limit how much of it exists at the same time. */
+  const int64_t batch_size = 64;
+  const int64_t pending_num = int64_t(pending_writes.size());
+  for (int64_t batch_start = 0; batch_start < pending_num; batch_start += batch_size) {
+    const IndexRange batch(batch_start, std::min(batch_size, pending_num - batch_start));
+    threading::parallel_for(batch, 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        pending_writes[i].writer->extract(pending_writes[i].context);
+      }
+    });
+
+    for (const int64_t i : batch) {
+      pending_writes[i].writer->write(pending_writes[i].context);
+    }
+  }
+}
+
 HierarchyContext AbstractHierarchyIterator::context_for_object_data(
     const HierarchyContext *object_context) const
 {
@@ -693,7 +725,7 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
   }
 
   if (data_writer.is_newly_created() || export_subset_.shapes) {
-    data_writer->write(data_context);
+    pending_writes_.push_back({data_writer.get(), data_context});
   }
 }
 
@@ -738,7 +770,7 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
 
     /* Always write upon creation, otherwise depend on which subset is active. */
     if (writer.is_newly_created() || export_subset_.shapes) {
-      writer->write(hair_context);
+      pending_writes_.push_back({writer.get(), hair_context});
     }
   }
 }
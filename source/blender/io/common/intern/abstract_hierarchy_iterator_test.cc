@@ -33,9 +33,22 @@ class TestHierarchyWriter : public AbstractHierarchyWriter {
   {
   }
 
+  /* Export paths for which extract() was called, but write() not yet. */
+  std::set<std::string> extracted_paths;
+
+  void extract(const HierarchyContext &context) override
+  {
+    extracted_paths.insert(context.export_path);
+  }
+
   void write(HierarchyContext &context) override
   {
     const char *id_name = context.object->id.name;
+
+    if (extracted_paths.erase(context.export_path) == 0) {
+      ADD_FAILURE() << "Data of " << writer_type << " writer for " << id_name
+                    << " was not extracted before writing to " << context.export_path;
+    }
     used_writers::mapped_type &writers = writers_map[id_name];
 
     if (writers.find(context.export_path) != writers.end()) {
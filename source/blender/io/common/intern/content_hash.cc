@@ -0,0 +1,56 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "IO_content_hash.hh"
+
+#include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_generic_virtual_array.hh"
+
+#include "DNA_mesh_types.h"
+
+#include <xxhash.h>
+
+namespace blender::io {
+
+ContentHash mesh_content_hash(const Mesh &mesh)
+{
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_128bits_reset(state);
+
+  auto add_data = [&](const void *data, const int64_t size) {
+    XXH3_128bits_update(state, data, size_t(size));
+  };
+  auto add_value = [&](const auto &value) { add_data(&value, sizeof(value)); };
+
+  add_value(mesh.verts_num);
+  add_value(mesh.edges_num);
+  add_value(mesh.faces_num);
+  add_value(mesh.corners_num);
+
+  const Span<int> face_offsets = mesh.face_offsets();
+  add_data(face_offsets.data(), face_offsets.size_in_bytes());
+
+  /* Topology is stored in attributes as well. Vertex groups are hashed through their attribute
+   * values, because the layer itself contains pointers. */
+  mesh.attributes().foreach_attribute([&](const bke::AttributeIter &iter) {
+    add_data(iter.name.data(), iter.name.size());
+    add_value(iter.domain);
+    add_value(iter.data_type);
+    const GVArraySpan values(*iter.get());
+    add_data(values.data(), values.size_in_bytes());
+  });
+
+  /* Generated coordinates are not an attribute, but are exported by some writers. */
+  if (const void *orco = CustomData_get_layer(&mesh.vert_data, CD_ORCO)) {
+    add_data(orco, int64_t(mesh.verts_num) * sizeof(float[3]));
+  }
+
+  const XXH128_hash_t hash = XXH3_128bits_digest(state);
+  XXH3_freeState(state);
+  return {hash.low64, hash.high64};
+}
+
+}  // namespace blender::io
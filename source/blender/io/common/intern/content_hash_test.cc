@@ -0,0 +1,129 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "IO_content_hash.hh"
+
+#include "testing/testing.h"
+
+#include "BKE_attribute.hh"
+#include "BKE_deform.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "MEM_guardedalloc.h"
+
+namespace blender::io {
+
+class ContentHashTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+};
+
+static Mesh *create_quad()
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 0, 1, 4);
+  mesh->vert_positions_for_write().copy_from(
+      {float3(0, 0, 0), float3(1, 0, 0), float3(1, 1, 0), float3(0, 1, 0)});
+  mesh->face_offsets_for_write().copy_from({0, 4});
+  mesh->corner_verts_for_write().copy_from({0, 1, 2, 3});
+  bke::mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+TEST_F(ContentHashTest, MeshContentHash)
+{
+  Mesh *mesh = create_quad();
+  Mesh *copy = BKE_mesh_copy_for_eval(*mesh);
+  const ContentHash hash = mesh_content_hash(*mesh);
+  EXPECT_EQ(hash, mesh_content_hash(*copy));
+
+  /* Changing positions changes the hash, changing them back restores it. */
+  copy->vert_positions_for_write()[2].z = 1.0f;
+  EXPECT_NE(hash, mesh_content_hash(*copy));
+  copy->vert_positions_for_write()[2].z = 0.0f;
+  EXPECT_EQ(hash, mesh_content_hash(*copy));
+
+  /* Topology. */
+  copy->corner_verts_for_write().copy_from({0, 1, 3, 2});
+  EXPECT_NE(hash, mesh_content_hash(*copy));
+  copy->corner_verts_for_write().copy_from({0, 1, 2, 3});
+
+  /* Attributes. */
+  bke::MutableAttributeAccessor attributes = copy->attributes_for_write();
+  bke::SpanAttributeWriter<float> weight = attributes.lookup_or_add_for_write_span<float>(
+      "weight", bke::AttrDomain::Point);
+  weight.span.fill(0.0f);
+  weight.finish();
+  const ContentHash hash_with_attribute = mesh_content_hash(*copy);
+  EXPECT_NE(hash, hash_with_attribute);
+
+  weight = attributes.lookup_for_write_span<float>("weight");
+  weight.span[0] = 0.5f;
+  weight.finish();
+  EXPECT_NE(hash_with_attribute, mesh_content_hash(*copy));
+
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, copy);
+}
+
+TEST_F(ContentHashTest, EmptyMesh)
+{
+  Mesh *empty = BKE_mesh_new_nomain(0, 0, 0, 0);
+  Mesh *empty_copy = BKE_mesh_copy_for_eval(*empty);
+  EXPECT_EQ(mesh_content_hash(*empty), mesh_content_hash(*empty_copy));
+
+  /* A mesh with only loose vertices differs from an empty one. */
+  Mesh *points = BKE_mesh_new_nomain(1, 0, 0, 0);
+  points->vert_positions_for_write()[0] = float3(0.0f);
+  EXPECT_NE(mesh_content_hash(*empty), mesh_content_hash(*points));
+
+  BKE_id_free(nullptr, empty);
+  BKE_id_free(nullptr, empty_copy);
+  BKE_id_free(nullptr, points);
+}
+
+TEST_F(ContentHashTest, VertexGroups)
+{
+  Mesh *mesh = create_quad();
+  const ContentHash hash = mesh_content_hash(*mesh);
+
+  /* Vertex groups are stored outside of the generic attribute storage. */
+  bDeformGroup *group = MEM_cnew<bDeformGroup>(__func__);
+  STRNCPY(group->name, "Group");
+  BLI_addtail(&mesh->vertex_group_names, group);
+  MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+  BKE_defvert_add_index_notest(&dverts[1], 0, 0.5f);
+  const ContentHash hash_with_group = mesh_content_hash(*mesh);
+  EXPECT_NE(hash, hash_with_group);
+
+  Mesh *copy = BKE_mesh_copy_for_eval(*mesh);
+  EXPECT_EQ(hash_with_group, mesh_content_hash(*copy));
+
+  /* Only the weight changes. */
+  BKE_defvert_find_index(&copy->deform_verts_for_write()[1], 0)->weight = 1.0f;
+  EXPECT_NE(hash_with_group, mesh_content_hash(*copy));
+
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, copy);
+}
+
+}  // namespace blender::io
@@ -10,54 +10,119 @@
 #include "ply_data.hh"
 #include "ply_file_buffer.hh"
 
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 
 namespace blender::io::ply {
 
-void write_vertices(FileBuffer &buffer, const PlyData &ply_data)
+/** Number of elements encoded by a single task. */
+static constexpr int64_t elements_per_chunk = 16 * 1024;
+/** Number of chunks encoded before they are written, bounding the memory usage. */
+static constexpr int64_t chunks_per_write = 64;
+
+/**
+ * Encode elements on multiple threads, each chunk of contiguous elements into a separate memory
+ * buffer. The buffers are then written to the file in order.
+ */
+template<typename EncodeFn>
+static void write_elements(FileBuffer &buffer, const int64_t elements_num, const EncodeFn &encode)
 {
-  for (int i = 0; i < ply_data.vertices.size(); i++) {
-    buffer.write_vertex(ply_data.vertices[i].x, ply_data.vertices[i].y, ply_data.vertices[i].z);
+  const int64_t chunks_num = divide_ceil_ul(elements_num, elements_per_chunk);
+  Array<std::unique_ptr<FileBuffer>> chunk_buffers(std::min(chunks_num, chunks_per_write));
 
-    if (!ply_data.vertex_normals.is_empty()) {
-      buffer.write_vertex_normal(ply_data.vertex_normals[i].x,
-                                 ply_data.vertex_normals[i].y,
-                                 ply_data.vertex_normals[i].z);
+  for (int64_t batch_start = 0; batch_start < chunks_num; batch_start += chunks_per_write) {
+    const IndexRange batch(batch_start, std::min(chunks_per_write, chunks_num - batch_start));
+    threading::parallel_for(batch.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        const int64_t chunk = batch[i];
+        const IndexRange elements = IndexRange::from_begin_end(
+            chunk * elements_per_chunk, std::min((chunk + 1) * elements_per_chunk, elements_num));
+        chunk_buffers[i] = buffer.create_memory_buffer();
+        encode(*chunk_buffers[i], chunk, elements);
+      }
+    });
+    for (const int64_t i : batch.index_range()) {
+      buffer.append_buffer(*chunk_buffers[i]);
+      chunk_buffers[i].reset();
     }
+    buffer.write_to_file();
+  }
+  buffer.write_to_file();
+}
 
-    if (!ply_data.vertex_colors.is_empty()) {
-      /* PLY colors currently are exported as bytes, make sure inputs are clamped. */
-      float4 color = math::clamp(ply_data.vertex_colors[i], 0.0f, 1.0f) * 255.0f;
-      buffer.write_vertex_color(uchar(color.x), uchar(color.y), uchar(color.z), uchar(color.w));
-    }
+void write_vertices(FileBuffer &buffer, const PlyData &ply_data)
+{
+  write_elements(
+      buffer,
+      ply_data.vertices.size(),
+      [&](FileBuffer &chunk_buffer, const int64_t /*chunk*/, const IndexRange range) {
+        for (const int64_t i : range) {
+          chunk_buffer.write_vertex(
+              ply_data.vertices[i].x, ply_data.vertices[i].y, ply_data.vertices[i].z);
 
-    if (!ply_data.uv_coordinates.is_empty()) {
-      buffer.write_UV(ply_data.uv_coordinates[i].x, ply_data.uv_coordinates[i].y);
-    }
+          if (!ply_data.vertex_normals.is_empty()) {
+            chunk_buffer.write_vertex_normal(ply_data.vertex_normals[i].x,
+                                             ply_data.vertex_normals[i].y,
+                                             ply_data.vertex_normals[i].z);
+          }
 
-    for (const PlyCustomAttribute &attr : ply_data.vertex_custom_attr) {
-      buffer.write_data(attr.data[i]);
-    }
+          if (!ply_data.vertex_colors.is_empty()) {
+            /* PLY colors currently are exported as bytes, make sure inputs are clamped. */
+            float4 color = math::clamp(ply_data.vertex_colors[i], 0.0f, 1.0f) * 255.0f;
+            chunk_buffer.write_vertex_color(
+                uchar(color.x), uchar(color.y), uchar(color.z), uchar(color.w));
+          }
 
-    buffer.write_vertex_end();
-  }
-  buffer.write_to_file();
+          if (!ply_data.uv_coordinates.is_empty()) {
+            chunk_buffer.write_UV(ply_data.uv_coordinates[i].x, ply_data.uv_coordinates[i].y);
+          }
+
+          for (const PlyCustomAttribute &attr : ply_data.vertex_custom_attr) {
+            chunk_buffer.write_data(attr.data[i]);
+          }
+
+          chunk_buffer.write_vertex_end();
+        }
+      });
 }
 
 void write_faces(FileBuffer &buffer, const PlyData &ply_data)
 {
-  const uint32_t *indices = ply_data.face_vertices.data();
-  for (uint32_t face_size : ply_data.face_sizes) {
-    buffer.write_face(char(face_size), Span<uint32_t>(indices, face_size));
-    indices += face_size;
+  /* Find where the indices of every chunk start, the faces can have any size. */
+  const int64_t faces_num = ply_data.face_sizes.size();
+  Array<int64_t> chunk_index_starts(divide_ceil_ul(faces_num, elements_per_chunk));
+  int64_t index_start = 0;
+  for (const int64_t i : ply_data.face_sizes.index_range()) {
+    if (i % elements_per_chunk == 0) {
+      chunk_index_starts[i / elements_per_chunk] = index_start;
+    }
+    index_start += ply_data.face_sizes[i];
   }
-  buffer.write_to_file();
+
+  write_elements(
+      buffer,
+      faces_num,
+      [&](FileBuffer &chunk_buffer, const int64_t chunk, const IndexRange range) {
+        const uint32_t *indices = ply_data.face_vertices.data() + chunk_index_starts[chunk];
+        for (const int64_t i : range) {
+          const uint32_t face_size = ply_data.face_sizes[i];
+          chunk_buffer.write_face(char(face_size), Span<uint32_t>(indices, face_size));
+          indices += face_size;
+        }
+      });
 }
+
 void write_edges(FileBuffer &buffer, const PlyData &ply_data)
 {
-  for (const std::pair<int, int> &edge : ply_data.edges) {
-    buffer.write_edge(edge.first, edge.second);
-  }
-  buffer.write_to_file();
+  write_elements(
+      buffer,
+      ply_data.edges.size(),
+      [&](FileBuffer &chunk_buffer, const int64_t /*chunk*/, const IndexRange range) {
+        for (const int64_t i : range) {
+          chunk_buffer.write_edge(ply_data.edges[i].first, ply_data.edges[i].second);
+        }
+      });
 }
 }  // namespace blender::io::ply
@@ -18,7 +18,7 @@ static CLG_LogRef LOG = {"io.ply"};
 namespace blender::io::ply {
 
 FileBuffer::FileBuffer(const char *filepath, size_t buffer_chunk_size)
-    : buffer_chunk_size_(buffer_chunk_size), filepath_(filepath)
+    : filepath_(filepath), buffer_chunk_size_(buffer_chunk_size)
 {
   outfile_ = BLI_fopen(filepath, "wb");
   if (!outfile_) {
@@ -27,8 +27,11 @@ FileBuffer::FileBuffer(const char *filepath, size_t buffer_chunk_size)
   }
 }
 
+FileBuffer::FileBuffer(size_t buffer_chunk_size) : buffer_chunk_size_(buffer_chunk_size) {}
+
 void FileBuffer::write_to_file()
 {
+  BLI_assert(outfile_ != nullptr);
   for (const VectorChar &b : blocks_) {
     fwrite(b.data(), 1, b.size(), this->outfile_);
   }
@@ -46,6 +49,14 @@ void FileBuffer::close_file()
   }
 }
 
+void FileBuffer::append_buffer(FileBuffer &other)
+{
+  for (VectorChar &block : other.blocks_) {
+    blocks_.append(std::move(block));
+  }
+  other.blocks_.clear();
+}
+
 void FileBuffer::write_header_element(StringRef name, int count)
 {
   write_fstring("element {} {}\n", name, count);
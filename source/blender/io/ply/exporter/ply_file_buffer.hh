@@ -12,6 +12,8 @@
 #include "BLI_utility_mixins.hh"
 #include "BLI_vector.hh"
 
+#include <memory>
+
 /* SEP macro from BLI path utils clashes with SEP symbol in fmt headers. */
 #undef SEP
 #include <fmt/format.h>
@@ -28,9 +30,14 @@ namespace blender::io::ply {
 class FileBuffer : private NonMovable {
   using VectorChar = Vector<char>;
   Vector<VectorChar> blocks_;
+  const char *filepath_ = nullptr;
+  FILE *outfile_ = nullptr;
+
+ protected:
   size_t buffer_chunk_size_;
-  const char *filepath_;
-  FILE *outfile_;
+
+  /* Buffer that is only kept in memory, see #create_memory_buffer. */
+  explicit FileBuffer(size_t buffer_chunk_size);
 
  public:
   FileBuffer(const char *filepath, size_t buffer_chunk_size = 64 * 1024);
@@ -42,6 +49,16 @@ class FileBuffer : private NonMovable {
 
   void close_file();
 
+  /**
+   * Create an empty buffer with the same format that does not write to a file. Separate parts
+   * of the output can be encoded into such buffers on multiple threads, and then be added in
+   * order with #append_buffer.
+   */
+  virtual std::unique_ptr<FileBuffer> create_memory_buffer() const = 0;
+
+  /* Move the contents of the other buffer to the end of this one. */
+  void append_buffer(FileBuffer &other);
+
   virtual void write_vertex(float x, float y, float z) = 0;
 
   virtual void write_UV(float u, float v) = 0;
@@ -10,6 +10,11 @@
 
 namespace blender::io::ply {
 
+std::unique_ptr<FileBuffer> FileBufferAscii::create_memory_buffer() const
+{
+  return std::unique_ptr<FileBuffer>(new FileBufferAscii(buffer_chunk_size_));
+}
+
 void FileBufferAscii::write_vertex(float x, float y, float z)
 {
   write_fstring("{} {} {}", x, y, z);
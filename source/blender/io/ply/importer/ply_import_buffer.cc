@@ -5,6 +5,7 @@
 #include "ply_import_buffer.hh"
 
 #include "BLI_fileops.h"
+#include "BLI_mmap.h"
 
 #include <algorithm>
 #include <cstdio>
@@ -18,14 +19,17 @@ static inline bool is_newline(char ch)
 
 namespace blender::io::ply {
 
-PlyReadBuffer::PlyReadBuffer(const char *file_path, size_t read_buffer_size)
-    : buffer_(read_buffer_size), read_buffer_size_(read_buffer_size)
+PlyReadBuffer::PlyReadBuffer(const char *file_path, size_t read_buffer_size, bool use_mmap)
+    : buffer_(read_buffer_size), read_buffer_size_(read_buffer_size), use_mmap_(use_mmap)
 {
   file_ = BLI_fopen(file_path, "rb");
 }
 
 PlyReadBuffer::~PlyReadBuffer()
 {
+  if (mmap_file_ != nullptr) {
+    BLI_mmap_free(mmap_file_);
+  }
   if (file_ != nullptr) {
     fclose(file_);
   }
@@ -34,6 +38,25 @@ PlyReadBuffer::~PlyReadBuffer()
 void PlyReadBuffer::after_header(bool is_binary)
 {
   is_binary_ = is_binary;
+  if (!is_binary || !use_mmap_ || file_ == nullptr) {
+    return;
+  }
+
+  /* Offset in the file of the first byte after the header, that was already read to the buffer. */
+  const int64_t data_offset = BLI_ftell(file_) - (buf_used_ - pos_);
+  mmap_file_ = BLI_mmap_open(fileno(file_));
+  if (mmap_file_ == nullptr) {
+    return;
+  }
+  const size_t length = BLI_mmap_get_length(mmap_file_);
+  if (data_offset < 0 || size_t(data_offset) > length) {
+    BLI_mmap_free(mmap_file_);
+    mmap_file_ = nullptr;
+    return;
+  }
+  mapped_data_ = Span<uint8_t>(static_cast<const uint8_t *>(BLI_mmap_get_pointer(mmap_file_)),
+                               int64_t(length));
+  mapped_pos_ = size_t(data_offset);
 }
 
 Span<char> PlyReadBuffer::read_line()
@@ -63,6 +86,14 @@ Span<char> PlyReadBuffer::read_line()
 
 bool PlyReadBuffer::read_bytes(void *dst, size_t size)
 {
+  if (mmap_file_ != nullptr) {
+    const uint8_t *src = read_mapped(size);
+    if (src == nullptr) {
+      return false;
+    }
+    memcpy(dst, src, size);
+    return true;
+  }
   while (size > 0) {
     if (pos_ + size > buf_used_) {
       if (!refill_buffer()) {
@@ -79,6 +110,16 @@ bool PlyReadBuffer::read_bytes(void *dst, size_t size)
   return true;
 }
 
+const uint8_t *PlyReadBuffer::read_mapped(size_t size)
+{
+  if (mmap_file_ == nullptr || size > mapped_data_.size() - mapped_pos_) {
+    return nullptr;
+  }
+  const uint8_t *result = mapped_data_.data() + mapped_pos_;
+  mapped_pos_ += size;
+  return result;
+}
+
 bool PlyReadBuffer::refill_buffer()
 {
   BLI_assert(pos_ <= buf_used_);
@@ -13,15 +13,23 @@
 #include "BLI_array.hh"
 #include "BLI_span.hh"
 
+struct BLI_mmap_file;
+
 namespace blender::io::ply {
 
 /**
  * Reads underlying PLY file in large chunks, and provides interface for ascii/header
  * parsing to read individual lines, and for binary parsing to read chunks of bytes.
+ *
+ * The binary part of the file is memory mapped when possible, so that large elements can be
+ * decoded in parallel directly from the file data, see #read_mapped.
  */
 class PlyReadBuffer {
  public:
-  PlyReadBuffer(const char *file_path, size_t read_buffer_size = 64 * 1024);
+  /**
+   * \param use_mmap: Memory map the binary part of the file if possible.
+   */
+  PlyReadBuffer(const char *file_path, size_t read_buffer_size = 64 * 1024, bool use_mmap = true);
   ~PlyReadBuffer();
 
   /** After header is parsed, indicate whether the rest of reading will be ascii or binary. */
@@ -38,6 +46,24 @@ class PlyReadBuffer {
    */
   bool read_bytes(void *dst, size_t size);
 
+  /**
+   * When the file is memory mapped, returns the next \a size bytes of the file and moves the read
+   * position past them. Returns null when the file is not mapped or the file is too short, in that
+   * case the read position does not change.
+   */
+  const uint8_t *read_mapped(size_t size);
+
+  /** The memory mapped file data after the read position, empty when the file is not mapped. */
+  Span<uint8_t> peek_mapped() const
+  {
+    return mapped_data_.drop_front(int64_t(mapped_pos_));
+  }
+
+  bool is_mapped() const
+  {
+    return mmap_file_ != nullptr;
+  }
+
  private:
   bool refill_buffer();
 
@@ -49,6 +75,11 @@ class PlyReadBuffer {
   size_t read_buffer_size_ = 0;
   bool at_eof_ = false;
   bool is_binary_ = false;
+
+  bool use_mmap_ = true;
+  BLI_mmap_file *mmap_file_ = nullptr;
+  Span<uint8_t> mapped_data_;
+  size_t mapped_pos_ = 0;
 };
 
 }  // namespace blender::io::ply
@@ -12,6 +12,7 @@
 
 #include "BLI_endian_switch.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "fast_float.h"
 
@@ -193,6 +194,23 @@ template<typename T> static T get_binary_value(PlyDataTypes type, const uint8_t
   return val;
 }
 
+/**
+ * Read a single value from binary file data, that is possibly read-only (memory mapped) and not
+ * aligned to the type size.
+ */
+template<typename T>
+static T read_binary_value(const uint8_t *ptr, const PlyDataTypes type, const bool big_endian)
+{
+  /* Aligned for the largest type, since #get_binary_value reads through a typed pointer. */
+  alignas(8) uint8_t bytes[8];
+  memcpy(bytes, ptr, data_type_size[type]);
+  if (big_endian) {
+    endian_switch(bytes, data_type_size[type]);
+  }
+  const uint8_t *bytes_ptr = bytes;
+  return get_binary_value<T>(type, bytes_ptr);
+}
+
 static const char *parse_row_binary(PlyReadBuffer &file,
                                     const PlyHeader &header,
                                     const PlyElement &element,
@@ -270,15 +288,15 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     data->vertex_custom_attr.append(attr);
   }
 
-  data->vertices.reserve(element.count);
+  data->vertices.resize(element.count);
   if (has_color) {
-    data->vertex_colors.reserve(element.count);
+    data->vertex_colors.resize(element.count);
   }
   if (has_normal) {
-    data->vertex_normals.reserve(element.count);
+    data->vertex_normals.resize(element.count);
   }
   if (has_uv) {
-    data->uv_coordinates.reserve(element.count);
+    data->uv_coordinates.resize(element.count);
   }
 
   float4 color_norm = {1, 1, 1, 1};
@@ -291,31 +309,13 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     color_norm.w = data_type_normalizer[element.properties[alpha_index].type];
   }
 
-  Vector<float> value_vec(element.properties.size());
-  Vector<uint8_t> scratch;
-  if (header.type != PlyFormatType::ASCII) {
-    scratch.resize(element.stride);
-  }
-
-  for (int i = 0; i < element.count; i++) {
-
-    const char *error = nullptr;
-    if (header.type == PlyFormatType::ASCII) {
-      error = parse_row_ascii(file, value_vec);
-    }
-    else {
-      error = parse_row_binary(file, header, element, scratch, value_vec);
-    }
-    if (error != nullptr) {
-      return error;
-    }
-
+  auto store_row = [&](const Span<float> value_vec, const int64_t i) {
     /* Vertex coord */
     float3 vertex3;
     vertex3.x = value_vec[vertex_index.x];
     vertex3.y = value_vec[vertex_index.y];
     vertex3.z = value_vec[vertex_index.z];
-    data->vertices.append(vertex3);
+    data->vertices[i] = vertex3;
 
     /* Vertex color */
     if (has_color) {
@@ -329,7 +329,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       else {
         colors4.w = 1.0f;
       }
-      data->vertex_colors.append(colors4);
+      data->vertex_colors[i] = colors4;
     }
 
     /* If normals */
@@ -338,7 +338,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       normals3.x = value_vec[normal_index.x];
       normals3.y = value_vec[normal_index.y];
       normals3.z = value_vec[normal_index.z];
-      data->vertex_normals.append(normals3);
+      data->vertex_normals[i] = normals3;
     }
 
     /* If uv */
@@ -346,7 +346,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float2 uvmap;
       uvmap.x = value_vec[uv_index.x];
       uvmap.y = value_vec[uv_index.y];
-      data->uv_coordinates.append(uvmap);
+      data->uv_coordinates[i] = uvmap;
     }
 
     /* Custom attributes */
@@ -354,6 +354,53 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float value = value_vec[custom_attr_indices[ci]];
       data->vertex_custom_attr[ci].data[i] = value;
     }
+  };
+
+  /* Memory mapped binary file: decode the rows in parallel, they all have the same size. */
+  if (header.type != PlyFormatType::ASCII && element.stride != 0) {
+    if (const uint8_t *src = file.read_mapped(size_t(element.count) * element.stride)) {
+      const bool big_endian = header.type == PlyFormatType::BINARY_BE;
+      Array<int> prop_offsets(element.properties.size());
+      int offset = 0;
+      for (const int64_t prop_idx : element.properties.index_range()) {
+        prop_offsets[prop_idx] = offset;
+        offset += data_type_size[element.properties[prop_idx].type];
+      }
+      threading::parallel_for(IndexRange(element.count), 8192, [&](const IndexRange range) {
+        Vector<float> value_vec(element.properties.size());
+        for (const int64_t i : range) {
+          const uint8_t *row = src + i * element.stride;
+          for (const int64_t prop_idx : element.properties.index_range()) {
+            value_vec[prop_idx] = read_binary_value<float>(
+                row + prop_offsets[prop_idx], element.properties[prop_idx].type, big_endian);
+          }
+          store_row(value_vec, i);
+        }
+      });
+      return nullptr;
+    }
+  }
+
+  Vector<float> value_vec(element.properties.size());
+  Vector<uint8_t> scratch;
+  if (header.type != PlyFormatType::ASCII) {
+    scratch.resize(element.stride);
+  }
+
+  for (int i = 0; i < element.count; i++) {
+
+    const char *error = nullptr;
+    if (header.type == PlyFormatType::ASCII) {
+      error = parse_row_ascii(file, value_vec);
+    }
+    else {
+      error = parse_row_binary(file, header, element, scratch, value_vec);
+    }
+    if (error != nullptr) {
+      return error;
+    }
+
+    store_row(value_vec, i);
   }
   return nullptr;
 }
@@ -389,6 +436,114 @@ static void skip_property(PlyReadBuffer &file,
   }
 }
 
+/**
+ * Load a binary face element from the memory mapped file. The rows have a variable size, so a
+ * first pass finds the face sizes and where blocks of rows start in the file and in the face
+ * vertices (a prefix sum of the face sizes). The blocks are then decoded in parallel.
+ */
+static const char *load_face_element_mapped(PlyReadBuffer &file,
+                                            const PlyElement &element,
+                                            const int prop_index,
+                                            const bool big_endian,
+                                            PlyData *data)
+{
+  const Span<uint8_t> src = file.peek_mapped();
+  const PlyProperty &prop = element.properties[prop_index];
+  const int count_size = data_type_size[prop.count_type];
+  const int index_size = data_type_size[prop.type];
+
+  /* Size of the property at the given offset, -1 when the file is too short to contain it. */
+  auto property_size = [&](const PlyProperty &property, const int64_t offset) -> int64_t {
+    if (property.count_type == PlyDataTypes::NONE) {
+      return data_type_size[property.type];
+    }
+    if (offset + data_type_size[property.count_type] > src.size()) {
+      return -1;
+    }
+    const uint32_t count = read_binary_value<uint32_t>(
+        src.data() + offset, property.count_type, big_endian);
+    return data_type_size[property.count_type] + int64_t(count) * data_type_size[property.type];
+  };
+  auto skip_properties = [&](const IndexRange props, int64_t &r_offset) {
+    for (const int64_t j : props) {
+      const int64_t size = property_size(element.properties[j], r_offset);
+      if (size < 0) {
+        return false;
+      }
+      r_offset += size;
+    }
+    return true;
+  };
+  const IndexRange props_before(prop_index);
+  const IndexRange props_after = element.properties.index_range().drop_front(prop_index + 1);
+
+  struct FaceBlock {
+    int64_t src_offset;
+    int64_t vert_offset;
+  };
+  constexpr int64_t block_size = 4096;
+  Vector<FaceBlock> blocks;
+
+  const int64_t verts_start = data->face_vertices.size();
+  int64_t offset = 0;
+  int64_t verts_num = 0;
+  for (int i = 0; i < element.count; i++) {
+    if (i % block_size == 0) {
+      blocks.append({offset, verts_start + verts_num});
+    }
+    /* Skip any properties before vertex indices. */
+    if (!skip_properties(props_before, offset) || offset + count_size > src.size()) {
+      return "Could not read row of binary property";
+    }
+    const uint32_t count = read_binary_value<uint32_t>(
+        src.data() + offset, prop.count_type, big_endian);
+    if (count < 1 || count > 255) {
+      return "Invalid face size, must be between 1 and 255";
+    }
+    offset += count_size + int64_t(count) * index_size;
+    /* Previous python based importer was accepting faces with fewer
+     * than 3 vertices, and silently dropping them. */
+    if (count < 3) {
+      CLOG_WARN(&LOG, "PLY Importer: ignoring face %i (%u vertices)", i, count);
+    }
+    else {
+      data->face_sizes.append(count);
+      verts_num += count;
+    }
+    /* Skip any properties after vertex indices. */
+    if (!skip_properties(props_after, offset) || offset > src.size()) {
+      return "Could not read row of binary property";
+    }
+  }
+
+  data->face_vertices.resize(verts_start + verts_num);
+  threading::parallel_for(blocks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      int64_t row_offset = blocks[block].src_offset;
+      int64_t vert = blocks[block].vert_offset;
+      for ([[maybe_unused]] const int64_t i :
+           IndexRange(block * block_size, std::min(block_size, element.count - block * block_size)))
+      {
+        skip_properties(props_before, row_offset);
+        const uint32_t count = read_binary_value<uint32_t>(
+            src.data() + row_offset, prop.count_type, big_endian);
+        row_offset += count_size;
+        if (count >= 3) {
+          for (const int64_t j : IndexRange(count)) {
+            data->face_vertices[vert++] = read_binary_value<uint32_t>(
+                src.data() + row_offset + j * index_size, prop.type, big_endian);
+          }
+        }
+        row_offset += int64_t(count) * index_size;
+        skip_properties(props_after, row_offset);
+      }
+    }
+  });
+
+  file.read_mapped(size_t(offset));
+  return nullptr;
+}
+
 static const char *load_face_element(PlyReadBuffer &file,
                                      const PlyHeader &header,
                                      const PlyElement &element,
@@ -456,6 +611,10 @@ static const char *load_face_element(PlyReadBuffer &file,
       data->face_sizes.append(count);
     }
   }
+  else if (file.is_mapped()) {
+    return load_face_element_mapped(
+        file, element, prop_index, header.type == PlyFormatType::BINARY_BE, data);
+  }
   else {
     Vector<uint8_t> scratch(64);
 
@@ -343,6 +343,37 @@ TEST_F(PLYExportTest, WriteFacesBinary)
   }
 }
 
+TEST_F(PLYExportTest, WriteManyFacesBinary)
+{
+  std::string filePath = get_temp_ply_filename(temp_file_path);
+
+  /* Enough faces of different sizes to be encoded in several chunks. */
+  PlyData plyData;
+  std::vector<char> expected;
+  for (uint32_t i = 0; i < 100000; i++) {
+    const uint32_t face_size = 3 + i % 3;
+    plyData.face_sizes.append(face_size);
+    expected.push_back(char(face_size));
+    for (uint32_t j = 0; j < face_size; j++) {
+      const uint32_t index = i * 7 + j;
+      plyData.face_vertices.append(index);
+      const char *bytes = reinterpret_cast<const char *>(&index);
+      expected.insert(expected.end(), bytes, bytes + sizeof(uint32_t));
+    }
+  }
+
+  std::unique_ptr<FileBuffer> buffer = std::make_unique<FileBufferBinary>(filePath.c_str());
+
+  write_faces(*buffer, plyData);
+
+  buffer->close_file();
+
+  std::vector<char> result = read_temp_file_in_vectorchar(filePath);
+
+  ASSERT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(result == expected);
+}
+
 TEST_F(PLYExportTest, WriteVertexNormalsAscii)
 {
   std::string filePath = get_temp_ply_filename(temp_file_path);
@@ -4,7 +4,10 @@
 
 #include "testing/testing.h"
 
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
 #include "BLI_path_utils.hh"
+#include "BLI_tempfile.h"
 
 #include "ply_import.hh"
 #include "ply_import_buffer.hh"
@@ -14,7 +17,8 @@ namespace blender::io::ply {
 
 /* Extensive tests for PLY importing are in `io_ply_import_test.py`.
  * The tests here are only for testing PLY reader buffer refill behavior,
- * by using a very small buffer size on purpose. */
+ * by using a very small buffer size on purpose, and for the memory mapped
+ * binary decoding. */
 
 TEST(ply_import, BufferRefillTest)
 {
@@ -25,8 +29,8 @@ TEST(ply_import, BufferRefillTest)
 
   /* Use a small read buffer size to test buffer refilling behavior. */
   constexpr size_t buffer_size = 50;
-  PlyReadBuffer infile_a(ply_path_a.c_str(), buffer_size);
-  PlyReadBuffer infile_b(ply_path_b.c_str(), buffer_size);
+  PlyReadBuffer infile_a(ply_path_a.c_str(), buffer_size, false);
+  PlyReadBuffer infile_b(ply_path_b.c_str(), buffer_size, false);
   PlyHeader header_a, header_b;
   const char *header_err_a = read_header(infile_a, header_a);
   const char *header_err_b = read_header(infile_b, header_b);
@@ -62,6 +66,182 @@ TEST(ply_import, BufferRefillTest)
   EXPECT_EQ_ARRAY(exp_edges, data_b->edges.data(), 12);
 }
 
+TEST(ply_import, MappedBinaryTest)
+{
+  std::string ply_path = blender::tests::flags_test_asset_dir() +
+                         SEP_STR "io_tests" SEP_STR "ply" SEP_STR + "wireframe_cube.ply";
+
+  PlyReadBuffer infile_buffered(ply_path.c_str(), 50, false);
+  PlyReadBuffer infile_mapped(ply_path.c_str(), 64 * 1024, true);
+  PlyHeader header_buffered, header_mapped;
+  ASSERT_EQ(read_header(infile_buffered, header_buffered), nullptr);
+  ASSERT_EQ(read_header(infile_mapped, header_mapped), nullptr);
+  EXPECT_TRUE(infile_mapped.is_mapped());
+  std::unique_ptr<PlyData> buffered = import_ply_data(infile_buffered, header_buffered);
+  std::unique_ptr<PlyData> mapped = import_ply_data(infile_mapped, header_mapped);
+  ASSERT_TRUE(buffered->error.empty());
+  ASSERT_TRUE(mapped->error.empty());
+
+  EXPECT_EQ(8, mapped->vertices.size());
+  EXPECT_EQ(12, mapped->edges.size());
+  EXPECT_EQ(buffered->vertices, mapped->vertices);
+  EXPECT_EQ(buffered->edges, mapped->edges);
+}
+
+template<typename T> static void append_binary(std::string &r_data, T value, bool big_endian)
+{
+  if (big_endian && sizeof(T) == 2) {
+    BLI_endian_switch_uint16(reinterpret_cast<uint16_t *>(&value));
+  }
+  else if (big_endian && sizeof(T) == 4) {
+    BLI_endian_switch_uint32(reinterpret_cast<uint32_t *>(&value));
+  }
+  r_data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/* Every 97th face has only two vertices and is skipped, the others alternate between triangles
+ * and quads. */
+static int test_face_size(const int face)
+{
+  return (face % 97 == 0) ? 2 : 3 + face % 2;
+}
+
+/* Write a binary file with fixed size vertex rows and variable size face rows, that has a list
+ * property besides the vertex indices. */
+static std::string write_binary_ply(const bool big_endian,
+                                    const int verts_num,
+                                    const int faces_num)
+{
+  std::string text = "ply\n";
+  text += big_endian ? "format binary_big_endian 1.0\n" : "format binary_little_endian 1.0\n";
+  text += "element vertex " + std::to_string(verts_num) + "\n";
+  text += "property float x\nproperty float y\nproperty float z\n";
+  text += "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+  text += "property short quality\n";
+  text += "element face " + std::to_string(faces_num) + "\n";
+  text += "property int flags\n";
+  text += "property list uchar uint vertex_indices\n";
+  text += "property list uchar float texcoord\n";
+  text += "end_header\n";
+  for (int i = 0; i < verts_num; i++) {
+    append_binary<float>(text, i * 0.5f, big_endian);
+    append_binary<float>(text, -i * 0.25f, big_endian);
+    append_binary<float>(text, 1.0f, big_endian);
+    append_binary<uint8_t>(text, i % 256, big_endian);
+    append_binary<uint8_t>(text, (i * 3) % 256, big_endian);
+    append_binary<uint8_t>(text, 255, big_endian);
+    append_binary<int16_t>(text, int16_t(i % 1000 - 500), big_endian);
+  }
+  for (int i = 0; i < faces_num; i++) {
+    append_binary<int32_t>(text, i, big_endian);
+    const int size = test_face_size(i);
+    append_binary<uint8_t>(text, size, big_endian);
+    for (int j = 0; j < size; j++) {
+      append_binary<uint32_t>(text, (i + j) % verts_num, big_endian);
+    }
+    append_binary<uint8_t>(text, i % 3, big_endian);
+    for (int j = 0; j < i % 3; j++) {
+      append_binary<float>(text, 0.5f, big_endian);
+    }
+  }
+
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), temp_dir, "ply_import_mapped_test.ply");
+  FILE *file = BLI_fopen(filepath, "wb");
+  fwrite(text.data(), 1, text.size(), file);
+  fclose(file);
+  return filepath;
+}
+
+static std::unique_ptr<PlyData> import_ply_file(const std::string &filepath, bool use_mmap)
+{
+  PlyReadBuffer file(filepath.c_str(), 64, use_mmap);
+  PlyHeader header;
+  EXPECT_EQ(read_header(file, header), nullptr);
+  EXPECT_EQ(file.is_mapped(), use_mmap);
+  return import_ply_data(file, header);
+}
+
+static void test_mapped_binary(const bool big_endian, const int verts_num, const int faces_num)
+{
+  const std::string filepath = write_binary_ply(big_endian, verts_num, faces_num);
+  std::unique_ptr<PlyData> buffered = import_ply_file(filepath, false);
+  std::unique_ptr<PlyData> mapped = import_ply_file(filepath, true);
+  BLI_delete(filepath.c_str(), false, false);
+  ASSERT_TRUE(buffered->error.empty());
+  ASSERT_TRUE(mapped->error.empty());
+
+  ASSERT_EQ(mapped->vertices.size(), verts_num);
+  for (const int i : IndexRange(verts_num)) {
+    EXPECT_EQ(mapped->vertices[i], float3(i * 0.5f, -i * 0.25f, 1.0f));
+  }
+  Vector<uint32_t> face_sizes;
+  Vector<uint32_t> face_vertices;
+  for (const int i : IndexRange(faces_num)) {
+    const int size = test_face_size(i);
+    if (size < 3) {
+      continue;
+    }
+    face_sizes.append(size);
+    for (const int j : IndexRange(size)) {
+      face_vertices.append((i + j) % verts_num);
+    }
+  }
+  EXPECT_EQ(mapped->face_sizes, face_sizes);
+  EXPECT_EQ(mapped->face_vertices, face_vertices);
+
+  /* Colors and custom attributes are converted by the same code for both readers. */
+  EXPECT_EQ(buffered->vertices, mapped->vertices);
+  EXPECT_EQ(buffered->vertex_colors, mapped->vertex_colors);
+  ASSERT_EQ(buffered->vertex_custom_attr.size(), mapped->vertex_custom_attr.size());
+  for (const int64_t i : mapped->vertex_custom_attr.index_range()) {
+    EXPECT_EQ(buffered->vertex_custom_attr[i].data, mapped->vertex_custom_attr[i].data);
+  }
+  EXPECT_EQ(buffered->face_sizes, mapped->face_sizes);
+  EXPECT_EQ(buffered->face_vertices, mapped->face_vertices);
+}
+
+TEST(ply_import, MappedBinaryBlockBoundariesTest)
+{
+  /* Vertex rows are decoded in parallel in ranges of 8192 rows, face rows in blocks of 4096 rows.
+   * Test counts just below, at and above those sizes, for both endiannesses. */
+  for (const bool big_endian : {false, true}) {
+    test_mapped_binary(big_endian, 8191, 4095);
+    test_mapped_binary(big_endian, 8192, 4096);
+    test_mapped_binary(big_endian, 8193, 4097);
+    test_mapped_binary(big_endian, 20000, 3 * 4096 + 1);
+  }
+}
+
+TEST(ply_import, MappedBinarySmallTest)
+{
+  for (const bool big_endian : {false, true}) {
+    test_mapped_binary(big_endian, 8, 3);
+    test_mapped_binary(big_endian, 8, 0);
+  }
+}
+
+TEST(ply_import, MappedBinaryEmptyTest)
+{
+  for (const bool big_endian : {false, true}) {
+    /* There is no data after the header to map, the buffered reader may be used instead. */
+    const std::string filepath = write_binary_ply(big_endian, 0, 0);
+    std::unique_ptr<PlyData> data;
+    {
+      PlyReadBuffer file(filepath.c_str(), 64, true);
+      PlyHeader header;
+      EXPECT_EQ(read_header(file, header), nullptr);
+      data = import_ply_data(file, header);
+    }
+    BLI_delete(filepath.c_str(), false, false);
+    EXPECT_TRUE(data->error.empty());
+    EXPECT_TRUE(data->vertices.is_empty());
+    EXPECT_TRUE(data->face_sizes.is_empty());
+  }
+}
+
 //@TODO: now we put vertex color attribute first, maybe put position first?
 //@TODO: test with vertex element having list properties
 //@TODO: test with edges starting with non-vertex index properties
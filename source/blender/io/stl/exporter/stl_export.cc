@@ -15,8 +15,10 @@
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
 
+#include "BLI_array.hh"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph_query.hh"
 
@@ -134,21 +136,33 @@ void export_frame(Depsgraph *depsgraph,
 
     const bool mirrored = is_negative_m4(xform);
 
-    /* Write triangles. */
+    /* Write triangles. They are computed on multiple threads in batches, so that the memory
+     * usage stays bounded for large meshes. */
     const Span<float3> positions = mesh->vert_positions();
     const Span<int> corner_verts = mesh->corner_verts();
-    for (const int3 &tri : mesh->corner_tris()) {
-      PackedTriangle data{};
-      for (int i = 0; i < 3; i++) {
-        /* Reverse face order for mirrored objects. */
-        int idx = mirrored ? 2 - i : i;
-        float3 pos = positions[corner_verts[tri[idx]]];
-        mul_m4_v3(xform, pos);
-        pos *= global_scale;
-        data.vertices[i] = pos;
-      }
-      data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
-      writer->write_triangle(data);
+    const Span<int3> corner_tris = mesh->corner_tris();
+    constexpr int64_t batch_size = 256 * 1024;
+    Array<PackedTriangle> batch_tris(std::min(batch_size, corner_tris.size()));
+    for (int64_t batch_start = 0; batch_start < corner_tris.size(); batch_start += batch_size) {
+      const IndexRange batch = corner_tris.index_range().slice(
+          batch_start, std::min(batch_size, corner_tris.size() - batch_start));
+      threading::parallel_for(batch.index_range(), 4096, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          const int3 &tri = corner_tris[batch[i]];
+          PackedTriangle data{};
+          for (int j = 0; j < 3; j++) {
+            /* Reverse face order for mirrored objects. */
+            int idx = mirrored ? 2 - j : j;
+            float3 pos = positions[corner_verts[tri[idx]]];
+            mul_m4_v3(xform, pos);
+            pos *= global_scale;
+            data.vertices[j] = pos;
+          }
+          data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
+          batch_tris[i] = data;
+        }
+      });
+      writer->write_triangles(batch_tris.as_span().take_front(batch.size()));
     }
   }
   DEG_OBJECT_ITER_END;
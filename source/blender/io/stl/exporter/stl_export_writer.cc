@@ -17,7 +17,10 @@
 #include "stl_data.hh"
 #include "stl_export_writer.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.h"
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
 
 namespace blender::io::stl {
 
@@ -56,34 +59,51 @@ FileWriter::~FileWriter()
   fclose(file_);
 }
 
-void FileWriter::write_triangle(const PackedTriangle &data)
+void FileWriter::write_triangles(const Span<PackedTriangle> tris)
 {
-  tris_num_++;
-  if (ascii_) {
-    fmt::print(file_,
-               "facet normal {} {} {}\n"
-               " outer loop\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               " endloop\n"
-               "endfacet\n",
-
-               data.normal.x,
-               data.normal.y,
-               data.normal.z,
-               data.vertices[0].x,
-               data.vertices[0].y,
-               data.vertices[0].z,
-               data.vertices[1].x,
-               data.vertices[1].y,
-               data.vertices[1].z,
-               data.vertices[2].x,
-               data.vertices[2].y,
-               data.vertices[2].z);
+  tris_num_ += tris.size();
+  if (!ascii_) {
+    fwrite(tris.data(), sizeof(PackedTriangle), tris.size(), file_);
+    return;
   }
-  else {
-    fwrite(&data, sizeof(data), 1, file_);
+
+  /* Formatting the numbers is much slower than writing the text, so format chunks of triangles
+   * into separate buffers on multiple threads and write those in order. */
+  constexpr int64_t chunk_size = 8 * 1024;
+  const int64_t chunks_num = divide_ceil_ul(tris.size(), chunk_size);
+  Array<fmt::memory_buffer> chunk_buffers(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_tris = tris.index_range().slice(
+          chunk * chunk_size, std::min<int64_t>(chunk_size, tris.size() - chunk * chunk_size));
+      for (const PackedTriangle &data : tris.slice(chunk_tris)) {
+        fmt::format_to(fmt::appender(chunk_buffers[chunk]),
+                       "facet normal {} {} {}\n"
+                       " outer loop\n"
+                       "  vertex {} {} {}\n"
+                       "  vertex {} {} {}\n"
+                       "  vertex {} {} {}\n"
+                       " endloop\n"
+                       "endfacet\n",
+
+                       data.normal.x,
+                       data.normal.y,
+                       data.normal.z,
+                       data.vertices[0].x,
+                       data.vertices[0].y,
+                       data.vertices[0].z,
+                       data.vertices[1].x,
+                       data.vertices[1].y,
+                       data.vertices[1].z,
+                       data.vertices[2].x,
+                       data.vertices[2].y,
+                       data.vertices[2].z);
+      }
+    }
+  });
+
+  for (const fmt::memory_buffer &buffer : chunk_buffers) {
+    fwrite(buffer.data(), 1, buffer.size(), file_);
   }
 }
 
@@ -9,9 +9,20 @@
 #include <cstdint>
 #include <cstdio>
 
+#include <climits>
+#include <cstring>
+
 #include "BKE_mesh.hh"
 
 #include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
+#include "BLI_math_base.h"
+#include "BLI_mmap.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_set.hh"
+#include "BLI_struct_equality_utils.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -20,9 +31,280 @@
 #include "stl_import_binary_reader.hh"
 #include "stl_import_mesh.hh"
 
+#include "CLG_log.h"
+static CLG_LogRef LOG = {"io.stl"};
+
 namespace blender::io::stl {
 
-Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
+/**
+ * Vertices are only merged when their positions are exactly the same, so they can be compared
+ * by their bit pattern. Unlike comparing floats, this is also well defined for NaN.
+ */
+struct PositionBits {
+  uint32_t x, y, z;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(x, y, z);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_3(PositionBits, x, y, z)
+};
+
+/** Number of items processed by each task in the partitioning and numbering passes. */
+static constexpr int64_t task_chunk_size = 65536;
+
+/**
+ * Reorder the item indices so that all items with the same hash end up in the same bucket. Inside
+ * of a bucket the indices stay in ascending order, so the first occurrence of a key is found first
+ * when iterating over the bucket.
+ *
+ * \return The offsets of the buckets in \a r_indices.
+ */
+template<typename HashFn>
+static Array<int> partition_by_hash(const int items_num,
+                                    const int bucket_bits,
+                                    const HashFn &hash_fn,
+                                    MutableSpan<int> r_indices)
+{
+  const int buckets_num = 1 << bucket_bits;
+  const int chunks_num = int(divide_ceil_ul(items_num, task_chunk_size));
+  auto bucket_of = [&](const int i) {
+    /* Use the high bits of a multiplicative hash, the low bits of the hash alone are not always
+     * well distributed. */
+    return int((hash_fn(i) * 0x9E3779B97F4A7C15ull) >> (64 - bucket_bits));
+  };
+
+  Array<int> chunk_offsets(chunks_num * buckets_num, 0);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      MutableSpan<int> counts = chunk_offsets.as_mutable_span().slice(chunk * buckets_num,
+                                                                      buckets_num);
+      const IndexRange items = IndexRange(chunk * task_chunk_size, task_chunk_size).intersect(
+          IndexRange(items_num));
+      for (const int i : items) {
+        counts[bucket_of(i)]++;
+      }
+    }
+  });
+
+  /* Every chunk writes its items of a bucket after the items of the previous chunks. */
+  Array<int> bucket_offsets(buckets_num + 1);
+  int offset = 0;
+  for (const int bucket : IndexRange(buckets_num)) {
+    bucket_offsets[bucket] = offset;
+    for (const int chunk : IndexRange(chunks_num)) {
+      const int count = chunk_offsets[chunk * buckets_num + bucket];
+      chunk_offsets[chunk * buckets_num + bucket] = offset;
+      offset += count;
+    }
+  }
+  bucket_offsets.last() = offset;
+
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      MutableSpan<int> offsets = chunk_offsets.as_mutable_span().slice(chunk * buckets_num,
+                                                                       buckets_num);
+      const IndexRange items = IndexRange(chunk * task_chunk_size, task_chunk_size).intersect(
+          IndexRange(items_num));
+      for (const int i : items) {
+        r_indices[offsets[bucket_of(i)]++] = i;
+      }
+    }
+  });
+  return bucket_offsets;
+}
+
+/**
+ * Give the items for which \a selection_fn returns true consecutive indices, in the order of the
+ * items. The indices of other items are set to -1.
+ *
+ * \return The number of selected items.
+ */
+template<typename SelectionFn>
+static int number_selected(const int items_num,
+                           const SelectionFn &selection_fn,
+                           MutableSpan<int> r_indices)
+{
+  const int chunks_num = int(divide_ceil_ul(items_num, task_chunk_size));
+  Array<int> chunk_offsets(chunks_num + 1, 0);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      const IndexRange items = IndexRange(chunk * task_chunk_size, task_chunk_size).intersect(
+          IndexRange(items_num));
+      int count = 0;
+      for (const int i : items) {
+        count += selection_fn(i) ? 1 : 0;
+      }
+      chunk_offsets[chunk] = count;
+    }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(chunk_offsets);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      const IndexRange items = IndexRange(chunk * task_chunk_size, task_chunk_size).intersect(
+          IndexRange(items_num));
+      int index = offsets[chunk].start();
+      for (const int i : items) {
+        r_indices[i] = selection_fn(i) ? index++ : -1;
+      }
+    }
+  });
+  return offsets.total_size();
+}
+
+/**
+ * Build the mesh directly from the memory mapped triangle data. This gives the same result as
+ * #STLMeshHelper, but vertices are merged and duplicate triangles are found with a hash
+ * partitioned pass that runs on all threads.
+ */
+static Mesh *read_stl_binary_mapped(const uint8_t *tris_data,
+                                    const int tris_num,
+                                    const bool use_custom_normals)
+{
+  const int corners_num = tris_num * 3;
+  auto corner_data = [&](const int corner) {
+    return tris_data + int64_t(corner / 3) * BINARY_STRIDE +
+           offsetof(PackedTriangle, vertices) + (corner % 3) * sizeof(float3);
+  };
+  /* The triangle data is not aligned, so values have to be copied. */
+  auto corner_bits = [&](const int corner) {
+    PositionBits bits;
+    memcpy(&bits, corner_data(corner), sizeof(bits));
+    return bits;
+  };
+
+  constexpr int bucket_bits = 10;
+  const IndexRange buckets(1 << bucket_bits);
+  Array<int> indices(corners_num);
+
+  /* Find the first corner with the same position for every corner. The first corners are
+   * equivalent to the vertex indices, they are only numbered later. */
+  Array<int> corner_first(corners_num);
+  {
+    const Array<int> bucket_offsets = partition_by_hash(
+        corners_num, bucket_bits, [&](const int i) { return corner_bits(i).hash(); }, indices);
+    threading::parallel_for(buckets, 16, [&](const IndexRange range) {
+      Map<PositionBits, int> first_corners;
+      for (const int bucket : range) {
+        first_corners.clear_and_keep_capacity();
+        for (const int corner :
+             indices.as_span().slice(bucket_offsets[bucket],
+                                     bucket_offsets[bucket + 1] - bucket_offsets[bucket]))
+        {
+          corner_first[corner] = first_corners.lookup_or_add(corner_bits(corner), corner);
+        }
+      }
+    });
+  }
+
+  /* Remove degenerate triangles and all but the first of triangles that use the same vertices. */
+  enum class TriState : int8_t { Keep, Degenerate, Duplicate };
+  Array<TriState> tri_states(tris_num);
+  auto sorted_tri_verts = [&](const int tri) {
+    int3 verts(corner_first[tri * 3], corner_first[tri * 3 + 1], corner_first[tri * 3 + 2]);
+    if (verts.x > verts.y) {
+      std::swap(verts.x, verts.y);
+    }
+    if (verts.y > verts.z) {
+      std::swap(verts.y, verts.z);
+    }
+    if (verts.x > verts.y) {
+      std::swap(verts.x, verts.y);
+    }
+    return verts;
+  };
+  {
+    MutableSpan<int> tri_indices = indices.as_mutable_span().take_front(tris_num);
+    const Array<int> bucket_offsets = partition_by_hash(
+        tris_num, bucket_bits, [&](const int i) { return sorted_tri_verts(i).hash(); }, tri_indices);
+    threading::parallel_for(buckets, 16, [&](const IndexRange range) {
+      Set<int3> tris;
+      for (const int bucket : range) {
+        tris.clear_and_keep_capacity();
+        for (const int tri :
+             tri_indices.as_span().slice(bucket_offsets[bucket],
+                                         bucket_offsets[bucket + 1] - bucket_offsets[bucket]))
+        {
+          const int3 verts = sorted_tri_verts(tri);
+          if (verts.x == verts.y || verts.y == verts.z) {
+            tri_states[tri] = TriState::Degenerate;
+          }
+          else if (!tris.add(verts)) {
+            tri_states[tri] = TriState::Duplicate;
+          }
+          else {
+            tri_states[tri] = TriState::Keep;
+          }
+        }
+      }
+    });
+  }
+
+  const int degenerate_tris_num = std::count(
+      tri_states.begin(), tri_states.end(), TriState::Degenerate);
+  const int duplicate_tris_num = std::count(
+      tri_states.begin(), tri_states.end(), TriState::Duplicate);
+  if (degenerate_tris_num > 0) {
+    CLOG_WARN(&LOG, "Removed %d degenerate triangles during import", degenerate_tris_num);
+  }
+  if (duplicate_tris_num > 0) {
+    CLOG_WARN(&LOG, "Removed %d duplicate triangles during import", duplicate_tris_num);
+  }
+
+  /* Number the vertices in the order of their first use, like #STLMeshHelper. */
+  MutableSpan<int> corner_vert_index = indices;
+  const int verts_num = number_selected(
+      corners_num, [&](const int corner) { return corner_first[corner] == corner; }, indices);
+  Array<int> tri_dst(tris_num);
+  const int kept_tris_num = number_selected(
+      tris_num, [&](const int tri) { return tri_states[tri] == TriState::Keep; }, tri_dst);
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, kept_tris_num, kept_tris_num * 3);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  threading::parallel_for(IndexRange(corners_num), task_chunk_size, [&](const IndexRange range) {
+    for (const int corner : range) {
+      if (corner_vert_index[corner] != -1) {
+        memcpy(&positions[corner_vert_index[corner]], corner_data(corner), sizeof(float3));
+      }
+    }
+  });
+
+  offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  Array<float3> corner_normals(use_custom_normals ? kept_tris_num * 3 : 0);
+  threading::parallel_for(IndexRange(tris_num), task_chunk_size / 3, [&](const IndexRange range) {
+    for (const int tri : range) {
+      const int dst = tri_dst[tri];
+      if (dst == -1) {
+        continue;
+      }
+      for (const int i : IndexRange(3)) {
+        corner_verts[dst * 3 + i] = corner_vert_index[corner_first[tri * 3 + i]];
+      }
+      if (use_custom_normals) {
+        float3 normal;
+        memcpy(&normal,
+               tris_data + int64_t(tri) * BINARY_STRIDE + offsetof(PackedTriangle, normal),
+               sizeof(float3));
+        corner_normals.as_mutable_span().slice(dst * 3, 3).fill(normal);
+      }
+    }
+  });
+
+  bke::mesh_smooth_set(*mesh, false);
+
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  bke::mesh_calc_edges(*mesh, false, false);
+
+  if (use_custom_normals) {
+    bke::mesh_set_custom_normals(*mesh, corner_normals);
+  }
+
+  return mesh;
+}
+
+Mesh *read_stl_binary(FILE *file, const bool use_custom_normals, const bool use_mmap)
 {
   const int chunk_size = 1024;
   uint32_t num_tris = 0;
@@ -36,6 +318,25 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
     return BKE_mesh_new_nomain(0, 0, 0, 0);
   }
 
+  if (use_mmap && int64_t(num_tris) * 3 <= INT_MAX) {
+    if (BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file))) {
+      const size_t data_offset = BINARY_HEADER_SIZE + sizeof(uint32_t);
+      const size_t length = BLI_mmap_get_length(mmap_file);
+      Mesh *mesh = nullptr;
+      /* Files with trailing data or too few triangles are read with the regular path. */
+      if (length == data_offset + size_t(num_tris) * BINARY_STRIDE) {
+        const uint8_t *tris_data = static_cast<const uint8_t *>(BLI_mmap_get_pointer(mmap_file)) +
+                                   data_offset;
+        mesh = read_stl_binary_mapped(tris_data, int(num_tris), use_custom_normals);
+      }
+      BLI_mmap_free(mmap_file);
+      if (mesh != nullptr) {
+        return mesh;
+      }
+      fseek(file, data_offset, SEEK_SET);
+    }
+  }
+
   Array<PackedTriangle> tris_buf(chunk_size);
   STLMeshHelper stl_mesh(num_tris, use_custom_normals);
   size_t num_read_tris;
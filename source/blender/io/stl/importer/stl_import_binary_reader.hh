@@ -25,6 +25,10 @@ struct Mesh;
 
 namespace blender::io::stl {
 
-Mesh *read_stl_binary(FILE *file, bool use_custom_normals);
+/**
+ * Read a binary STL file. When \a use_mmap is true, the file is memory mapped and the mesh is
+ * built on multiple threads when possible.
+ */
+Mesh *read_stl_binary(FILE *file, bool use_custom_normals, bool use_mmap = true);
 
 }  // namespace blender::io::stl
@@ -0,0 +1,182 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_fileops.h"
+#include "BLI_path_utils.hh"
+#include "BLI_tempfile.h"
+#include "BLI_vector.hh"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+
+#include "stl_data.hh"
+#include "stl_import_binary_reader.hh"
+
+namespace blender::io::stl {
+
+/* Extensive tests for STL importing are in `io_stl_import_test.py`. The tests here write binary
+ * files of known size and content, to compare reading them through a memory map on multiple
+ * threads with the buffered single threaded reader. */
+
+class STLImportBinaryTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void TearDown() override
+  {
+    for (const std::string &filepath : filepaths_) {
+      BLI_delete(filepath.c_str(), false, false);
+    }
+  }
+
+  /* Write a binary STL file to the temporary directory, optionally followed by unused bytes. */
+  std::string write_binary_stl(const char *filename,
+                               const Span<PackedTriangle> tris,
+                               const int trailing_bytes_num = 0)
+  {
+    char temp_dir[FILE_MAX];
+    BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+    char filepath[FILE_MAX];
+    BLI_path_join(filepath, sizeof(filepath), temp_dir, filename);
+    filepaths_.append(filepath);
+
+    FILE *file = BLI_fopen(filepath, "wb");
+    const char header[BINARY_HEADER_SIZE] = {};
+    const uint32_t tris_num = tris.size();
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(&tris_num, sizeof(tris_num), 1, file);
+    fwrite(tris.data(), sizeof(PackedTriangle), tris.size(), file);
+    for (int i = 0; i < trailing_bytes_num; i++) {
+      fputc(0, file);
+    }
+    fclose(file);
+    return filepath;
+  }
+
+ private:
+  Vector<std::string> filepaths_;
+};
+
+static Mesh *read_binary_stl(const std::string &filepath, const bool use_mmap)
+{
+  FILE *file = BLI_fopen(filepath.c_str(), "rb");
+  Mesh *mesh = read_stl_binary(file, true, use_mmap);
+  fclose(file);
+  return mesh;
+}
+
+/* Grid of `size` by `size` quads, each split into two triangles. */
+static Vector<PackedTriangle> grid_triangles(const int size)
+{
+  Vector<PackedTriangle> tris;
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const float3 p00(x, y, 0.0f);
+      const float3 p10(x + 1, y, 0.0f);
+      const float3 p11(x + 1, y + 1, 0.0f);
+      const float3 p01(x, y + 1, 0.0f);
+      const float3 normal(0.0f, float(x % 3), 1.0f);
+      tris.append({normal, {p00, p10, p11}, 0});
+      tris.append({normal, {p00, p11, p01}, 0});
+    }
+  }
+  return tris;
+}
+
+static void expect_meshes_equal(const Mesh &a, const Mesh &b)
+{
+  EXPECT_EQ(a.verts_num, b.verts_num);
+  EXPECT_EQ(a.edges_num, b.edges_num);
+  EXPECT_EQ(a.faces_num, b.faces_num);
+  EXPECT_EQ(a.vert_positions(), b.vert_positions());
+  EXPECT_EQ(a.corner_verts(), b.corner_verts());
+  EXPECT_EQ(a.corner_normals(), b.corner_normals());
+}
+
+static void test_grid(const std::string &filepath, const int size)
+{
+  Mesh *buffered = read_binary_stl(filepath, false);
+  Mesh *mapped = read_binary_stl(filepath, true);
+
+  EXPECT_EQ(mapped->verts_num, (size + 1) * (size + 1));
+  EXPECT_EQ(mapped->edges_num, 2 * size * (size + 1) + size * size);
+  EXPECT_EQ(mapped->faces_num, 2 * size * size);
+  expect_meshes_equal(*buffered, *mapped);
+
+  BKE_id_free(nullptr, buffered);
+  BKE_id_free(nullptr, mapped);
+}
+
+TEST_F(STLImportBinaryTest, grid)
+{
+  test_grid(write_binary_stl("stl_import_grid.stl", grid_triangles(10)), 10);
+}
+
+TEST_F(STLImportBinaryTest, chunk_boundaries)
+{
+  /* The mapped reader splits its work into tasks of 65536 corners or 21845 triangles, the
+   * buffered one reads 1024 triangles at a time. 104 by 104 quads stay below one task, 105 by 105
+   * quads cross the boundary for both corners and triangles. */
+  for (const int size : {104, 105}) {
+    test_grid(write_binary_stl("stl_import_chunks.stl", grid_triangles(size)), size);
+  }
+}
+
+TEST_F(STLImportBinaryTest, degenerate_and_duplicate)
+{
+  Vector<PackedTriangle> tris = grid_triangles(2);
+  /* Identical to an existing triangle. */
+  tris.append(tris[3]);
+  /* Two corners at the same position. */
+  PackedTriangle degenerate = tris[0];
+  degenerate.vertices[1] = degenerate.vertices[0];
+  tris.append(degenerate);
+  const std::string filepath = write_binary_stl("stl_import_degenerate.stl", tris);
+
+  Mesh *buffered = read_binary_stl(filepath, false);
+  Mesh *mapped = read_binary_stl(filepath, true);
+  EXPECT_EQ(mapped->verts_num, 9);
+  EXPECT_EQ(mapped->faces_num, 8);
+  expect_meshes_equal(*buffered, *mapped);
+
+  BKE_id_free(nullptr, buffered);
+  BKE_id_free(nullptr, mapped);
+}
+
+TEST_F(STLImportBinaryTest, empty)
+{
+  const std::string filepath = write_binary_stl("stl_import_empty.stl", {});
+  for (const bool use_mmap : {false, true}) {
+    Mesh *mesh = read_binary_stl(filepath, use_mmap);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_EQ(mesh->verts_num, 0);
+    EXPECT_EQ(mesh->faces_num, 0);
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST_F(STLImportBinaryTest, trailing_data)
+{
+  /* Files that are longer than their triangle count implies can't be mapped directly and fall
+   * back to the buffered reader. */
+  test_grid(write_binary_stl("stl_import_trailing.stl", grid_triangles(4), 10), 4);
+}
+
+}  // namespace blender::io::stl
@@ -20,11 +20,15 @@
 #include "BKE_object.hh"
 #include "BKE_report.hh"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -53,6 +57,8 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
+
 namespace blender::io::usd {
 
 static CacheArchiveHandle *handle_from_stage_reader(USDStageReader *reader)
@@ -89,6 +95,15 @@ enum {
   USD_ARCHIVE_FAIL,
 };
 
+/** Time spent converting the prims of one type, reported when the import finishes. */
+struct PrimTypeTiming {
+  int64_t prims_num = 0;
+  /** Conversion to Blender data, which runs in parallel for all prims. */
+  timeit::Nanoseconds extract{0};
+  /** Adding the converted data to objects in #Main. */
+  timeit::Nanoseconds read{0};
+};
+
 struct ImportJobData {
   bContext *C;
   Main *bmain;
@@ -110,6 +125,7 @@ struct ImportJobData {
   bool import_ok;
   bool is_background_job;
   timeit::TimePoint start_time;
+  Map<std::string, PrimTypeTiming> prim_type_timings;
 
   CacheFile *cache_file;
 };
@@ -120,6 +136,22 @@ static void report_job_duration(const ImportJobData *data)
   fmt::print("USD import of '{}' took ", data->filepath);
   timeit::print_duration(duration);
   fmt::print("\n");
+
+  /* List the most expensive prim types first. */
+  Vector<std::pair<std::string, PrimTypeTiming>> timings;
+  for (const auto item : data->prim_type_timings.items()) {
+    timings.append({item.key, item.value});
+  }
+  std::sort(timings.begin(), timings.end(), [](const auto &a, const auto &b) {
+    return a.second.extract + a.second.read > b.second.extract + b.second.read;
+  });
+  for (const std::pair<std::string, PrimTypeTiming> &timing : timings) {
+    fmt::print("  {} ({} prims): convert ", timing.first, timing.second.prims_num);
+    timeit::print_duration(timing.second.extract);
+    fmt::print(", read ");
+    timeit::print_duration(timing.second.read);
+    fmt::print("\n");
+  }
 }
 
 static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
@@ -256,30 +288,59 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
   /* Sort readers by name: when creating a lot of objects in Blender,
    * it is much faster if the order is sorted by name. */
   archive->sort_readers();
+  archive->share_instance_proxy_meshes();
   *data->do_update = true;
   *data->progress = 0.25f;
 
+  const Span<USDPrimReader *> readers = archive->readers();
+  Array<timeit::Nanoseconds> extract_durations(readers.size(), timeit::Nanoseconds(0));
+  Array<timeit::Nanoseconds> read_durations(readers.size(), timeit::Nanoseconds(0));
+
+  /* Convert the prim data in parallel, only adding it to #Main happens serially below. */
+  threading::parallel_for(readers.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t reader_index : range) {
+      USDPrimReader *reader = readers[reader_index];
+      if (!reader || G.is_break) {
+        continue;
+      }
+      const timeit::TimePoint start = timeit::Clock::now();
+      reader->extract_object_data(0.0);
+      extract_durations[reader_index] = timeit::Clock::now() - start;
+    }
+  });
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+
+  *data->do_update = true;
+  *data->progress = 0.6f;
+
   /* Create blender objects. */
-  for (USDPrimReader *reader : archive->readers()) {
+  for (USDPrimReader *reader : readers) {
     if (!reader) {
       continue;
     }
     reader->create_object(data->bmain, 0.0);
     if ((++i & 1023) == 0) {
       *data->do_update = true;
-      *data->progress = 0.25f + 0.25f * (i / size);
+      *data->progress = 0.6f + 0.1f * (i / size);
     }
   }
 
   /* Setup parenthood and read actual object data. */
   i = 0;
-  for (USDPrimReader *reader : archive->readers()) {
+  for (const int64_t reader_index : readers.index_range()) {
+    USDPrimReader *reader = readers[reader_index];
     if (!reader) {
       continue;
     }
 
     Object *ob = reader->object();
+    const timeit::TimePoint start = timeit::Clock::now();
     reader->read_object_data(data->bmain, 0.0);
+    read_durations[reader_index] = timeit::Clock::now() - start;
 
     USDPrimReader *parent = reader->parent();
     if (parent == nullptr) {
@@ -289,7 +350,7 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.5f + 0.5f * (++i / size);
+    *data->progress = 0.7f + 0.3f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -298,6 +359,16 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
+  for (const int64_t reader_index : readers.index_range()) {
+    if (const USDPrimReader *reader = readers[reader_index]) {
+      PrimTypeTiming &timing = data->prim_type_timings.lookup_or_add_default(
+          reader->prim().GetTypeName().GetString());
+      timing.prims_num++;
+      timing.extract += extract_durations[reader_index];
+      timing.read += read_durations[reader_index];
+    }
+  }
+
   if (data->params.import_skeletons) {
     archive->process_armature_modifiers();
   }
@@ -138,10 +138,24 @@ void USDCurvesReader::create_object(Main *bmain, const double /*motionSampleTime
   object_->data = curve;
 }
 
+void USDCurvesReader::extract_object_data(const double motionSampleTime)
+{
+  Curves *curves = bke::curves_new_nomain(0, 0);
+  this->read_curve_sample(curves, motionSampleTime);
+  extracted_geometry_ = std::make_unique<bke::GeometrySet>(bke::GeometrySet::from_curves(curves));
+}
+
 void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
 {
   Curves *cu = (Curves *)object_->data;
-  this->read_curve_sample(cu, motionSampleTime);
+  if (extracted_geometry_) {
+    Curves *extracted = extracted_geometry_->get_curves_for_write();
+    cu->geometry.wrap() = std::move(extracted->geometry.wrap());
+    extracted_geometry_.reset();
+  }
+  else {
+    this->read_curve_sample(cu, motionSampleTime);
+  }
 
   if (this->is_animated()) {
     this->add_cache_modifier();
@@ -31,6 +31,7 @@ class USDCurvesReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void extract_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_geometry(bke::GeometrySet &geometry_set,
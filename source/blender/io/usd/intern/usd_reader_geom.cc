@@ -4,6 +4,7 @@
 
 #include "usd_reader_geom.hh"
 
+#include "BKE_geometry_set.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_modifier.hh"
 
@@ -15,6 +16,8 @@
 
 namespace blender::io::usd {
 
+USDGeomReader::~USDGeomReader() = default;
+
 void USDGeomReader::add_cache_modifier()
 {
   if (!settings_->get_cache_file) {
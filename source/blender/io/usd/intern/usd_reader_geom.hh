@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 #pragma once
 
+#include <memory>
+
 #include "usd.hh"
 #include "usd_reader_xform.hh"
 
@@ -15,6 +17,9 @@ struct GeometrySet;
 namespace blender::io::usd {
 
 class USDGeomReader : public USDXformReader {
+ protected:
+  /** Geometry converted by #extract_object_data, moved into the object data when reading it. */
+  std::unique_ptr<bke::GeometrySet> extracted_geometry_;
 
  public:
   USDGeomReader(const pxr::UsdPrim &prim,
@@ -23,6 +28,7 @@ class USDGeomReader : public USDXformReader {
       : USDXformReader(prim, import_params, settings)
   {
   }
+  ~USDGeomReader() override;
 
   virtual void read_geometry(bke::GeometrySet &geometry_set,
                              USDMeshReadParams params,
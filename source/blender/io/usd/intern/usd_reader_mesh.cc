@@ -17,9 +17,11 @@
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
 #include "BKE_geometry_set.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_material.hh"
 #include "BKE_mesh.hh"
+#include "BKE_modifier.hh"
 #include "BKE_object.hh"
 #include "BKE_report.hh"
 #include "BKE_subdiv.hh"
@@ -169,28 +171,76 @@ static void assign_materials(Main *bmain,
 
 void USDMeshReader::create_object(Main *bmain, const double /*motionSampleTime*/)
 {
-  Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
+  if (shared_mesh_source_ && !shared_mesh_source_->object()) {
+    shared_mesh_source_ = nullptr;
+  }
+
+  Mesh *mesh = nullptr;
+  if (shared_mesh_source_) {
+    mesh = static_cast<Mesh *>(shared_mesh_source_->object()->data);
+    id_us_plus(&mesh->id);
+  }
+  else {
+    mesh = BKE_mesh_add(bmain, name_.c_str());
+  }
 
   object_ = BKE_object_add_only_object(bmain, OB_MESH, name_.c_str());
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+Mesh *USDMeshReader::read_initial_mesh(Mesh *existing_mesh, const double motionSampleTime)
 {
-  Mesh *mesh = (Mesh *)object_->data;
-
   is_initial_load_ = true;
   const USDMeshReadParams params = create_mesh_read_params(motionSampleTime,
                                                            import_params_.mesh_read_flag);
 
-  Mesh *read_mesh = this->read_mesh(mesh, params, nullptr);
+  Mesh *read_mesh = this->read_mesh(existing_mesh, params, nullptr);
 
   is_initial_load_ = false;
-  if (read_mesh != mesh) {
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
+  return read_mesh;
+}
+
+void USDMeshReader::extract_object_data(const double motionSampleTime)
+{
+  if (shared_mesh_source_) {
+    return;
   }
 
-  readFaceSetsSample(bmain, mesh, motionSampleTime);
+  Mesh *template_mesh = BKE_mesh_new_nomain(0, 0, 0, 0);
+  Mesh *read_mesh = this->read_initial_mesh(template_mesh, motionSampleTime);
+  if (read_mesh != template_mesh) {
+    BKE_id_free(nullptr, template_mesh);
+  }
+  extracted_geometry_ = std::make_unique<bke::GeometrySet>(bke::GeometrySet::from_mesh(read_mesh));
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  if (shared_mesh_source_) {
+    /* The mesh and its materials have been read by the source reader already. */
+    BKE_object_materials_sync_length(bmain, object_, &mesh->id);
+    if (object_->totcol > 0) {
+      object_->actcol = 1;
+    }
+  }
+  else {
+    Mesh *read_mesh = nullptr;
+    if (extracted_geometry_) {
+      read_mesh = extracted_geometry_->get_component_for_write<bke::MeshComponent>().release();
+      extracted_geometry_.reset();
+    }
+    else {
+      read_mesh = this->read_initial_mesh(mesh, motionSampleTime);
+    }
+
+    if (read_mesh != mesh) {
+      BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
+    }
+
+    readFaceSetsSample(bmain, mesh, motionSampleTime);
+  }
 
   if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying() ||
       mesh_prim_.GetVelocitiesAttr().ValueMightBeTimeVarying())
@@ -212,12 +262,21 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
     }
   }
 
-  if (import_params_.import_blendshapes) {
+  /* Shape keys and vertex groups are stored in the mesh, only add them once. */
+  if (import_params_.import_blendshapes && !shared_mesh_source_) {
     import_blendshapes(bmain, object_, prim_, reports());
   }
 
   if (import_params_.import_skeletons) {
-    import_mesh_skel_bindings(object_, prim_, reports());
+    if (shared_mesh_source_) {
+      /* The deform groups are in the shared mesh, but every object needs its own modifier. */
+      if (BKE_modifiers_findby_type(shared_mesh_source_->object(), eModifierType_Armature)) {
+        ensure_armature_modifier(object_);
+      }
+    }
+    else {
+      import_mesh_skel_bindings(object_, prim_, reports());
+    }
   }
 
   USDXformReader::read_object_data(bmain, motionSampleTime);
@@ -848,6 +907,32 @@ void USDMeshReader::assign_facesets_to_material_indices(double motionSampleTime,
   }
 }
 
+Vector<pxr::SdfPath> USDMeshReader::bound_material_paths() const
+{
+  Vector<pxr::SdfPath> paths;
+  if (!import_params_.import_materials) {
+    return paths;
+  }
+
+  /* Same resolution as #assign_facesets_to_material_indices. */
+  for (const pxr::UsdGeomSubset &subset : pxr::UsdGeomSubset::GetAllGeomSubsets(mesh_prim_)) {
+    pxr::UsdShadeMaterial subset_mtl = utils::compute_bound_material(subset.GetPrim(),
+                                                                     import_params_.mtl_purpose);
+    if (subset_mtl && !subset_mtl.GetPath().IsEmpty()) {
+      paths.append(subset_mtl.GetPath());
+    }
+  }
+
+  if (paths.is_empty()) {
+    if (pxr::UsdShadeMaterial mtl = utils::compute_bound_material(prim_,
+                                                                  import_params_.mtl_purpose))
+    {
+      paths.append(mtl.GetPath());
+    }
+  }
+  return paths;
+}
+
 void USDMeshReader::readFaceSetsSample(Main *bmain, Mesh *mesh, const double motionSampleTime)
 {
   if (!import_params_.import_materials) {
@@ -7,6 +7,7 @@
 
 #include "BLI_map.hh"
 #include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "usd.hh"
 #include "usd_reader_geom.hh"
@@ -39,6 +40,12 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_ = false;
 
+  /**
+   * Reader for another instance of the same prototype mesh. When set, the object reuses the
+   * mesh of that reader instead of converting the same data again.
+   */
+  const USDMeshReader *shared_mesh_source_ = nullptr;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
@@ -53,6 +60,7 @@ class USDMeshReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void extract_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_geometry(bke::GeometrySet &geometry_set,
@@ -61,6 +69,21 @@ class USDMeshReader : public USDGeomReader {
 
   bool topology_changed(const Mesh *existing_mesh, double motionSampleTime) override;
 
+  /**
+   * Use the mesh of \a source instead of reading it from this reader's prim. The source reader
+   * has to create its object and read its data before this reader does.
+   */
+  void set_shared_mesh_source(const USDMeshReader *source)
+  {
+    shared_mesh_source_ = source;
+  }
+
+  /**
+   * Paths of the materials bound to the mesh and its geometry subsets, as they are resolved when
+   * assigning materials. Empty when materials aren't imported.
+   */
+  Vector<pxr::SdfPath> bound_material_paths() const;
+
   /**
    * If the USD mesh prim has a valid `UsdSkel` schema defined, return the USD path
    * string to the bound skeleton, if any. Returns the empty string if no skeleton
@@ -95,6 +118,8 @@ class USDMeshReader : public USDGeomReader {
   Mesh *read_mesh(struct Mesh *existing_mesh,
                   const USDMeshReadParams params,
                   const char **r_err_str);
+  /** Read all mesh data, not only the data that may change over time. */
+  Mesh *read_initial_mesh(Mesh *existing_mesh, double motionSampleTime);
 
   void read_custom_data(const ImportSettings *settings,
                         Mesh *mesh,
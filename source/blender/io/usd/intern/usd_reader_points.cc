@@ -26,20 +26,37 @@ void USDPointsReader::create_object(Main *bmain, double /*motionSampleTime*/)
   object_->data = point_cloud;
 }
 
-void USDPointsReader::read_object_data(Main *bmain, double motionSampleTime)
+void USDPointsReader::extract_object_data(const double motionSampleTime)
 {
   const USDMeshReadParams params = create_mesh_read_params(motionSampleTime,
                                                            import_params_.mesh_read_flag);
 
+  extracted_geometry_ = std::make_unique<bke::GeometrySet>(
+      bke::GeometrySet::from_pointcloud(BKE_pointcloud_new_nomain(0)));
+  read_geometry(*extracted_geometry_, params, nullptr);
+}
+
+void USDPointsReader::read_object_data(Main *bmain, double motionSampleTime)
+{
   PointCloud *point_cloud = static_cast<PointCloud *>(object_->data);
 
-  bke::GeometrySet geometry_set = bke::GeometrySet::from_pointcloud(
-      point_cloud, bke::GeometryOwnershipType::Editable);
+  PointCloud *read_point_cloud = nullptr;
+  if (extracted_geometry_) {
+    read_point_cloud =
+        extracted_geometry_->get_component_for_write<bke::PointCloudComponent>().release();
+    extracted_geometry_.reset();
+  }
+  else {
+    const USDMeshReadParams params = create_mesh_read_params(motionSampleTime,
+                                                             import_params_.mesh_read_flag);
+
+    bke::GeometrySet geometry_set = bke::GeometrySet::from_pointcloud(
+        point_cloud, bke::GeometryOwnershipType::Editable);
 
-  read_geometry(geometry_set, params, nullptr);
+    read_geometry(geometry_set, params, nullptr);
 
-  PointCloud *read_point_cloud =
-      geometry_set.get_component_for_write<bke::PointCloudComponent>().release();
+    read_point_cloud = geometry_set.get_component_for_write<bke::PointCloudComponent>().release();
+  }
 
   if (read_point_cloud != point_cloud) {
     BKE_pointcloud_nomain_to_pointcloud(read_point_cloud, point_cloud);
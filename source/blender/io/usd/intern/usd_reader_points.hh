@@ -37,6 +37,7 @@ class USDPointsReader : public USDGeomReader {
   void create_object(Main *bmain, double motionSampleTime) override;
 
   /* Initial point cloud data update. */
+  void extract_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   /* Implement point cloud update. This may be called by the cache modifier
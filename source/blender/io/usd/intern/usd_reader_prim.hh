@@ -95,6 +95,12 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Convert the prim data to Blender data that is not part of #Main yet. The importer calls this
+   * for many readers in parallel before any objects are created, so implementations must not
+   * access #Main or the reader's object. #read_object_data then uses the converted data.
+   */
+  virtual void extract_object_data(double /*motionSampleTime*/) {}
   virtual void read_object_data(Main * /*bmain*/, double /*motionSampleTime*/){};
 
   Object *object() const;
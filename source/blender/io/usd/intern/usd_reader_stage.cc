@@ -741,6 +741,46 @@ void USDStageReader::sort_readers()
       });
 }
 
+void USDStageReader::share_instance_proxy_meshes()
+{
+  if (params_.support_scene_instancing || !params_.share_instance_meshes) {
+    return;
+  }
+
+  struct SourceReader {
+    USDMeshReader *reader;
+    blender::Vector<pxr::SdfPath> material_paths;
+  };
+  /* Materials can be bound outside of the prototype, so instances of the same prototype prim
+   * only share a mesh when their materials resolve to the same ones. */
+  blender::Map<pxr::SdfPath, blender::Vector<SourceReader>> source_readers;
+
+  for (USDPrimReader *reader : readers_) {
+    USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(reader);
+    if (!mesh_reader || !reader->prim().IsInstanceProxy()) {
+      continue;
+    }
+
+    const pxr::SdfPath proto_path = reader->prim().GetPrimInPrototype().GetPath();
+    blender::Vector<pxr::SdfPath> material_paths = mesh_reader->bound_material_paths();
+    blender::Vector<SourceReader> &sources = source_readers.lookup_or_add_default(proto_path);
+
+    const SourceReader *shared_source = nullptr;
+    for (const SourceReader &source : sources) {
+      if (source.material_paths.as_span() == material_paths.as_span()) {
+        shared_source = &source;
+        break;
+      }
+    }
+    if (shared_source) {
+      mesh_reader->set_shared_mesh_source(shared_source->reader);
+    }
+    else {
+      sources.append({mesh_reader, std::move(material_paths)});
+    }
+  }
+}
+
 void USDStageReader::create_proto_collections(Main *bmain, Collection *parent_collection)
 {
   if (proto_readers_.is_empty() && instancer_proto_readers_.is_empty()) {
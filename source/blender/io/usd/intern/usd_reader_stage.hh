@@ -137,6 +137,13 @@ class USDStageReader {
 
   void sort_readers();
 
+  /**
+   * When scene instancing is disabled, let the mesh readers of instance proxies that stand for
+   * the same prim of a prototype share a single mesh. The first reader in the current reader
+   * order reads the mesh, so this should be called after #sort_readers.
+   */
+  void share_instance_proxy_meshes();
+
   /**
    * Create prototype collections for instancing by the USD instance readers.
    */
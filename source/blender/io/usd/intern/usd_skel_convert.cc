@@ -1109,12 +1109,7 @@ void import_mesh_skel_bindings(Object *mesh_obj, const pxr::UsdPrim &prim, Repor
     return;
   }
 
-  /* Add the armature modifier, if one doesn't exist. */
-  if (!BKE_modifiers_findby_type(mesh_obj, eModifierType_Armature)) {
-    ModifierData *md = BKE_modifier_new(eModifierType_Armature);
-    BLI_addtail(&mesh_obj->modifiers, md);
-    BKE_modifiers_persistent_uid_init(*mesh_obj, *md);
-  }
+  ensure_armature_modifier(mesh_obj);
 
   /* Create a deform group per joint. */
   blender::Vector<bDeformGroup *> joint_def_grps(joints.size(), nullptr);
@@ -1150,6 +1145,15 @@ void import_mesh_skel_bindings(Object *mesh_obj, const pxr::UsdPrim &prim, Repor
   }
 }
 
+void ensure_armature_modifier(Object *mesh_obj)
+{
+  if (!BKE_modifiers_findby_type(mesh_obj, eModifierType_Armature)) {
+    ModifierData *md = BKE_modifier_new(eModifierType_Armature);
+    BLI_addtail(&mesh_obj->modifiers, md);
+    BKE_modifiers_persistent_uid_init(*mesh_obj, *md);
+  }
+}
+
 void skel_export_chaser(pxr::UsdStageRefPtr stage,
                         const ObjExportMap &armature_export_map,
                         const ObjExportMap &skinned_mesh_export_map,
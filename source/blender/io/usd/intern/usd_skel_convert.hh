@@ -76,6 +76,11 @@ void import_skeleton(Main *bmain,
  */
 void import_mesh_skel_bindings(Object *mesh_obj, const pxr::UsdPrim &prim, ReportList *reports);
 
+/**
+ * Add an armature modifier to the given mesh object, if it doesn't have one yet.
+ */
+void ensure_armature_modifier(Object *mesh_obj);
+
 /**
  * Map an object to its USD prim export path.
  */
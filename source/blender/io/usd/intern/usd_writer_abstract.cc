@@ -168,6 +168,15 @@ pxr::UsdTimeCode USDAbstractWriter::get_export_time_code() const
   return default_timecode;
 }
 
+void USDAbstractWriter::extract(const HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    /* Nothing will be written, see write(). */
+    return;
+  }
+  do_extract(context);
+}
+
 void USDAbstractWriter::write(HierarchyContext &context)
 {
   if (!frame_has_been_written_) {
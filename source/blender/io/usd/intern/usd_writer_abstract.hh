@@ -41,6 +41,7 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
  public:
   USDAbstractWriter(const USDExporterContext &usd_export_context);
 
+  void extract(const HierarchyContext &context) override;
   void write(HierarchyContext &context) override;
 
   /**
@@ -63,6 +64,8 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
   }
 
  protected:
+  /** See #AbstractHierarchyWriter::extract. This must not access the USD stage. */
+  virtual void do_extract(const HierarchyContext & /*context*/) {}
   virtual void do_write(HierarchyContext &context) = 0;
   std::string get_export_file_path() const;
   pxr::UsdTimeCode get_export_time_code() const;
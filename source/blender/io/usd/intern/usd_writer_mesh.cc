@@ -85,64 +85,6 @@ static const SubsurfModifierData *get_last_subdiv_modifier(eEvaluationMode eval_
   return nullptr;
 }
 
-void USDGenericMeshWriter::do_write(HierarchyContext &context)
-{
-  Object *object_eval = context.object;
-  bool needsfree = false;
-  Mesh *mesh = get_export_mesh(object_eval, needsfree);
-
-  if (mesh == nullptr) {
-    return;
-  }
-
-  if (usd_export_context_.export_params.triangulate_meshes) {
-    const bool tag_only = false;
-    const int quad_method = usd_export_context_.export_params.quad_method;
-    const int ngon_method = usd_export_context_.export_params.ngon_method;
-
-    BMeshCreateParams bmesh_create_params{};
-    BMeshFromMeshParams bmesh_from_mesh_params{};
-    bmesh_from_mesh_params.calc_face_normal = true;
-    bmesh_from_mesh_params.calc_vert_normal = true;
-    BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmesh_create_params, &bmesh_from_mesh_params);
-
-    BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
-
-    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
-    BM_mesh_free(bm);
-
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    mesh = triangulated_mesh;
-    needsfree = true;
-  }
-
-  try {
-    /* Fetch the subdiv modifier, if one exists and it is the last modifier. */
-    const SubsurfModifierData *subsurfData = get_last_subdiv_modifier(
-        usd_export_context_.export_params.evaluation_mode, object_eval);
-
-    write_mesh(context, mesh, subsurfData);
-
-    auto prim = usd_export_context_.stage->GetPrimAtPath(usd_export_context_.usd_path);
-    if (prim.IsValid() && object_eval) {
-      prim.SetActive((object_eval->duplicator_visibility_flag & OB_DUPLI_FLAG_RENDER) != 0);
-      write_id_properties(prim, mesh->id, get_export_time_code());
-    }
-
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-  }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    throw;
-  }
-}
-
 void USDGenericMeshWriter::write_custom_data(const Object *obj,
                                              const Mesh *mesh,
                                              const pxr::UsdGeomMesh &usd_mesh)
@@ -310,22 +252,200 @@ struct USDMeshData {
   pxr::VtFloatArray corner_sharpnesses;
 };
 
-void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
-                                      Mesh *mesh,
-                                      const SubsurfModifierData *subsurfData)
+/* Geometry converted to USD types. */
+struct USDMeshArrays {
+  USDMeshData geometry;
+  pxr::VtVec3fArray loop_normals;
+  pxr::VtVec3fArray velocities;
+};
+
+struct USDGenericMeshWriter::ExtractedMesh {
+  Mesh *mesh = nullptr;
+  bool needsfree = false;
+  const SubsurfModifierData *subsurf_data = nullptr;
+
+  std::optional<io::ContentHash> hash;
+  /* Shared with the previous sample when the mesh didn't change. */
+  std::shared_ptr<const USDMeshArrays> arrays;
+};
+
+static pxr::VtVec3fArray get_loop_normals(const Mesh *mesh)
+{
+  pxr::VtVec3fArray loop_normals;
+  loop_normals.resize(mesh->corners_num);
+
+  MutableSpan dst_normals(reinterpret_cast<float3 *>(loop_normals.data()), loop_normals.size());
+
+  switch (mesh->normals_domain()) {
+    case bke::MeshNormalDomain::Point: {
+      array_utils::gather(mesh->vert_normals(), mesh->corner_verts(), dst_normals);
+      break;
+    }
+    case bke::MeshNormalDomain::Face: {
+      const OffsetIndices faces = mesh->faces();
+      const Span<float3> face_normals = mesh->face_normals();
+      for (const int i : faces.index_range()) {
+        dst_normals.slice(faces[i]).fill(face_normals[i]);
+      }
+      break;
+    }
+    case bke::MeshNormalDomain::Corner: {
+      array_utils::copy(mesh->corner_normals(), dst_normals);
+      break;
+    }
+  }
+
+  return loop_normals;
+}
+
+static pxr::VtVec3fArray get_surface_velocities(const Mesh *mesh)
+{
+  /* Export velocity attribute output by fluid sim, sequence cache modifier
+   * and geometry nodes. */
+  const VArraySpan velocity = *mesh->attributes().lookup<float3>("velocity",
+                                                                 blender::bke::AttrDomain::Point);
+
+  /* Export per-vertex velocity vectors. */
+  Span<pxr::GfVec3f> data = velocity.cast<pxr::GfVec3f>();
+  pxr::VtVec3fArray usd_velocities;
+  usd_velocities.assign(data.begin(), data.end());
+  return usd_velocities;
+}
+
+USDGenericMeshWriter::~USDGenericMeshWriter()
+{
+  release_extracted();
+}
+
+void USDGenericMeshWriter::release_extracted()
+{
+  if (extracted_ && extracted_->needsfree) {
+    free_export_mesh(extracted_->mesh);
+  }
+  extracted_.reset();
+}
+
+void USDGenericMeshWriter::do_extract(const HierarchyContext &context)
+{
+  release_extracted();
+
+  Object *object_eval = context.object;
+  bool needsfree = false;
+  Mesh *mesh = get_export_mesh(object_eval, needsfree);
+
+  if (mesh == nullptr) {
+    return;
+  }
+
+  /* Ensure data exists if currently in edit mode, before hashing or triangulating it. */
+  BKE_mesh_wrapper_ensure_mdata(mesh);
+
+  std::optional<io::ContentHash> hash;
+  if (usd_export_context_.export_params.export_animation) {
+    hash = io::mesh_content_hash(*mesh);
+  }
+
+  if (usd_export_context_.export_params.triangulate_meshes) {
+    const bool tag_only = false;
+    const int quad_method = usd_export_context_.export_params.quad_method;
+    const int ngon_method = usd_export_context_.export_params.ngon_method;
+
+    BMeshCreateParams bmesh_create_params{};
+    BMeshFromMeshParams bmesh_from_mesh_params{};
+    bmesh_from_mesh_params.calc_face_normal = true;
+    bmesh_from_mesh_params.calc_vert_normal = true;
+    BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmesh_create_params, &bmesh_from_mesh_params);
+
+    BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
+
+    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
+    BM_mesh_free(bm);
+
+    if (needsfree) {
+      free_export_mesh(mesh);
+    }
+    mesh = triangulated_mesh;
+    needsfree = true;
+  }
+
+  extracted_ = std::make_unique<ExtractedMesh>();
+  ExtractedMesh &data = *extracted_;
+  data.mesh = mesh;
+  data.needsfree = needsfree;
+
+  /* Fetch the subdiv modifier, if one exists and it is the last modifier. */
+  data.subsurf_data = get_last_subdiv_modifier(usd_export_context_.export_params.evaluation_mode,
+                                               object_eval);
+
+  /* Compute the cached bounds used for the extent here, rather than while writing. */
+  mesh->bounds_min_max();
+
+  data.hash = hash;
+  if (frame_has_been_written_ && hash && hash == written_hash_) {
+    /* Writing the same arrays again lets the sparse value writer skip them cheaply. */
+    data.arrays = written_arrays_;
+    return;
+  }
+
+  std::shared_ptr<USDMeshArrays> arrays = std::make_shared<USDMeshArrays>();
+  get_geometry_data(mesh, arrays->geometry);
+
+  /* Normals are not stored when they are computed from the subdivision surface. */
+  if (usd_export_context_.export_params.export_normals &&
+      get_subdiv_scheme(data.subsurf_data) == pxr::UsdGeomTokens->none)
+  {
+    arrays->loop_normals = get_loop_normals(mesh);
+  }
+  arrays->velocities = get_surface_velocities(mesh);
+  data.arrays = std::move(arrays);
+}
+
+void USDGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  if (!extracted_) {
+    /* Not converted up front by the hierarchy iterator. */
+    do_extract(context);
+  }
+  if (!extracted_) {
+    return;
+  }
+
+  Object *object_eval = context.object;
+  const Mesh *mesh = extracted_->mesh;
+
+  try {
+    write_mesh(context, *extracted_);
+    if (extracted_->hash) {
+      written_hash_ = extracted_->hash;
+      written_arrays_ = extracted_->arrays;
+    }
+
+    auto prim = usd_export_context_.stage->GetPrimAtPath(usd_export_context_.usd_path);
+    if (prim.IsValid() && object_eval) {
+      prim.SetActive((object_eval->duplicator_visibility_flag & OB_DUPLI_FLAG_RENDER) != 0);
+      write_id_properties(prim, mesh->id, get_export_time_code());
+    }
+
+    release_extracted();
+  }
+  catch (...) {
+    release_extracted();
+    throw;
+  }
+}
+
+void USDGenericMeshWriter::write_mesh(HierarchyContext &context, ExtractedMesh &data)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdStageRefPtr stage = usd_export_context_.stage;
   const pxr::SdfPath &usd_path = usd_export_context_.usd_path;
+  const Mesh *mesh = data.mesh;
+  const SubsurfModifierData *subsurfData = data.subsurf_data;
+  const USDMeshData &usd_mesh_data = data.arrays->geometry;
 
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
-  /* Ensure data exists if currently in edit mode. */
-  BKE_mesh_wrapper_ensure_mdata(mesh);
-  get_geometry_data(mesh, usd_mesh_data);
-
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -385,9 +505,16 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   }
 
   write_custom_data(context.object, mesh, usd_mesh);
-  write_surface_velocity(mesh, usd_mesh);
+  write_surface_velocity(data.arrays->velocities, usd_mesh);
 
   const pxr::TfToken subdiv_scheme = get_subdiv_scheme(subsurfData);
+  if (subsurfData && subsurfData->subdivType != SUBSURF_TYPE_CATMULL_CLARK) {
+    /* "Simple" is currently the only other subdivision type provided by Blender, */
+    /* and we do not yet provide a corresponding representation for USD export. */
+    BKE_reportf(reports(),
+                RPT_WARNING,
+                "USD export: Simple subdivision not supported, exporting subdivided mesh");
+  }
 
   /* Normals can be animated, so ensure these are written for each frame,
    * unless a subdiv modifier is used, in which case normals are computed,
@@ -395,7 +522,7 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   if (usd_export_context_.export_params.export_normals &&
       subdiv_scheme == pxr::UsdGeomTokens->none)
   {
-    write_normals(mesh, usd_mesh);
+    write_normals(data.arrays->loop_normals, usd_mesh);
   }
 
   this->author_extent(usd_mesh, mesh->bounds_min_max(), timecode);
@@ -414,25 +541,17 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   }
 }
 
-pxr::TfToken USDGenericMeshWriter::get_subdiv_scheme(const SubsurfModifierData *subsurfData)
+pxr::TfToken USDGenericMeshWriter::get_subdiv_scheme(
+    const SubsurfModifierData *subsurfData) const
 {
   /* Default to setting the subdivision scheme to None. */
   pxr::TfToken subdiv_scheme = pxr::UsdGeomTokens->none;
 
-  if (subsurfData) {
-    if (subsurfData->subdivType == SUBSURF_TYPE_CATMULL_CLARK) {
-      if (usd_export_context_.export_params.export_subdiv == USD_SUBDIV_BEST_MATCH) {
-        /* If a subdivision modifier exists, and it uses Catmull-Clark, then apply Catmull-Clark
-         * SubD scheme. */
-        subdiv_scheme = pxr::UsdGeomTokens->catmullClark;
-      }
-    }
-    else {
-      /* "Simple" is currently the only other subdivision type provided by Blender, */
-      /* and we do not yet provide a corresponding representation for USD export. */
-      BKE_reportf(reports(),
-                  RPT_WARNING,
-                  "USD export: Simple subdivision not supported, exporting subdivided mesh");
+  if (subsurfData && subsurfData->subdivType == SUBSURF_TYPE_CATMULL_CLARK) {
+    if (usd_export_context_.export_params.export_subdiv == USD_SUBDIV_BEST_MATCH) {
+      /* If a subdivision modifier exists, and it uses Catmull-Clark, then apply Catmull-Clark
+       * SubD scheme. */
+      subdiv_scheme = pxr::UsdGeomTokens->catmullClark;
     }
   }
 
@@ -641,34 +760,11 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
   }
 }
 
-void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh &usd_mesh)
+void USDGenericMeshWriter::write_normals(const pxr::VtVec3fArray &loop_normals,
+                                         pxr::UsdGeomMesh &usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
 
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.resize(mesh->corners_num);
-
-  MutableSpan dst_normals(reinterpret_cast<float3 *>(loop_normals.data()), loop_normals.size());
-
-  switch (mesh->normals_domain()) {
-    case bke::MeshNormalDomain::Point: {
-      array_utils::gather(mesh->vert_normals(), mesh->corner_verts(), dst_normals);
-      break;
-    }
-    case bke::MeshNormalDomain::Face: {
-      const OffsetIndices faces = mesh->faces();
-      const Span<float3> face_normals = mesh->face_normals();
-      for (const int i : faces.index_range()) {
-        dst_normals.slice(faces[i]).fill(face_normals[i]);
-      }
-      break;
-    }
-    case bke::MeshNormalDomain::Corner: {
-      array_utils::copy(mesh->corner_normals(), dst_normals);
-      break;
-    }
-  }
-
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
   if (!attr_normals.HasValue()) {
     attr_normals.Set(loop_normals, pxr::UsdTimeCode::Default());
@@ -677,22 +773,13 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh &usd
   usd_mesh.SetNormalsInterpolation(pxr::UsdGeomTokens->faceVarying);
 }
 
-void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh,
+void USDGenericMeshWriter::write_surface_velocity(const pxr::VtVec3fArray &usd_velocities,
                                                   const pxr::UsdGeomMesh &usd_mesh)
 {
-  /* Export velocity attribute output by fluid sim, sequence cache modifier
-   * and geometry nodes. */
-  const VArraySpan velocity = *mesh->attributes().lookup<float3>("velocity",
-                                                                 blender::bke::AttrDomain::Point);
-  if (velocity.is_empty()) {
+  if (usd_velocities.empty()) {
     return;
   }
 
-  /* Export per-vertex velocity vectors. */
-  Span<pxr::GfVec3f> data = velocity.cast<pxr::GfVec3f>();
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.assign(data.begin(), data.end());
-
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdAttribute attr_vel = usd_mesh.CreateVelocitiesAttr(pxr::VtValue(), true);
   if (!attr_vel.HasValue()) {
@@ -808,6 +895,18 @@ void USDMeshWriter::init_blend_shapes(const HierarchyContext &context)
                       usd_export_context_.export_params.allow_unicode);
 }
 
+void USDMeshWriter::do_extract(const HierarchyContext &context)
+{
+  set_skel_export_flags(context);
+
+  if (frame_has_been_written_ && (write_skinned_mesh_ || write_blend_shapes_)) {
+    /* Only the rest mesh is written, on the first frame. */
+    return;
+  }
+
+  USDGenericMeshWriter::do_extract(context);
+}
+
 void USDMeshWriter::do_write(HierarchyContext &context)
 {
   set_skel_export_flags(context);
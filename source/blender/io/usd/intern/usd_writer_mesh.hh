@@ -5,10 +5,15 @@
 
 #include "usd_writer_abstract.hh"
 
+#include "IO_content_hash.hh"
+
 #include "BLI_map.hh"
 
 #include <pxr/usd/usdGeom/mesh.h>
 
+#include <memory>
+#include <optional>
+
 struct SubsurfModifierData;
 
 namespace blender::bke {
@@ -17,6 +22,7 @@ class AttributeIter;
 
 namespace blender::io::usd {
 
+struct USDMeshArrays;
 struct USDMeshData;
 
 /* Mapping from material slot number to array of face indices with that material. */
@@ -24,19 +30,32 @@ using MaterialFaceGroups = Map<short, pxr::VtArray<int>>;
 
 /* Writer for USD geometry. Does not assume the object is a mesh object. */
 class USDGenericMeshWriter : public USDAbstractWriter {
+  /* Export mesh of the current frame, its converted USD arrays and subdivision settings. */
+  struct ExtractedMesh;
+  std::unique_ptr<ExtractedMesh> extracted_;
+
+  /* Converted geometry of the last written sample, and the hash of the mesh it was converted
+   * from. Only set when exporting animation, used to skip the conversion for unchanged meshes. */
+  std::shared_ptr<const USDMeshArrays> written_arrays_;
+  std::optional<io::ContentHash> written_hash_;
+
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  ~USDGenericMeshWriter() override;
 
  protected:
   bool is_supported(const HierarchyContext *context) const override;
+  void do_extract(const HierarchyContext &context) override;
   void do_write(HierarchyContext &context) override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
 
  private:
-  void write_mesh(HierarchyContext &context, Mesh *mesh, const SubsurfModifierData *subsurfData);
-  pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData);
+  void release_extracted();
+
+  void write_mesh(HierarchyContext &context, ExtractedMesh &data);
+  pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData) const;
   void write_subdiv(const pxr::TfToken &subdiv_scheme,
                     const pxr::UsdGeomMesh &usd_mesh,
                     const SubsurfModifierData *subsurfData);
@@ -44,8 +63,9 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   void assign_materials(const HierarchyContext &context,
                         const pxr::UsdGeomMesh &usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
-  void write_normals(const Mesh *mesh, pxr::UsdGeomMesh &usd_mesh);
-  void write_surface_velocity(const Mesh *mesh, const pxr::UsdGeomMesh &usd_mesh);
+  void write_normals(const pxr::VtVec3fArray &loop_normals, pxr::UsdGeomMesh &usd_mesh);
+  void write_surface_velocity(const pxr::VtVec3fArray &usd_velocities,
+                              const pxr::UsdGeomMesh &usd_mesh);
 
   void write_custom_data(const Object *obj, const Mesh *mesh, const pxr::UsdGeomMesh &usd_mesh);
   void write_generic_data(const Mesh *mesh,
@@ -64,6 +84,7 @@ class USDMeshWriter : public USDGenericMeshWriter {
   USDMeshWriter(const USDExporterContext &ctx);
 
  protected:
+  void do_extract(const HierarchyContext &context) override;
   void do_write(HierarchyContext &context) override;
 
   Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
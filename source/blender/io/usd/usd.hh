@@ -220,6 +220,7 @@ struct USDImportParams {
   bool create_collection;
   bool create_world_material;
   bool support_scene_instancing;
+  bool share_instance_meshes;
 
   bool import_guide;
   bool import_proxy;
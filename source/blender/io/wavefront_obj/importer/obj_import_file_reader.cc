@@ -14,6 +14,8 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -73,27 +75,36 @@ static Geometry *create_geometry(Geometry *const prev_geometry,
   return new_geometry();
 }
 
+/**
+ * OBJ extension: `xyzrgb` vertex colors, when the vertex position
+ * is followed by 3 more RGB color components. See
+ * http://paulbourke.net/dataformats/obj/colour.html
+ */
+static void geom_set_vertex_extra(const int64_t index,
+                                  const float3 &srgb,
+                                  GlobalVertices &r_global_vertices)
+{
+  if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
+    float3 linear;
+    srgb_to_linearrgb_v3_v3(linear, srgb);
+    r_global_vertices.set_vertex_color(index, linear);
+  }
+  else if (srgb.x > 0) {
+    /* Treats value in srgb.x as weight. */
+    r_global_vertices.set_vertex_weight(index, srgb.x);
+  }
+}
+
 static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
 {
   r_global_vertices.flush_mrgb_block();
   float3 vert;
   p = parse_floats(p, end, 0.0f, vert, 3);
   r_global_vertices.vertices.append(vert);
-  /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
-   * is followed by 3 more RGB color components. See
-   * http://paulbourke.net/dataformats/obj/colour.html */
   if (p < end) {
     float3 srgb;
     p = parse_floats(p, end, -1.0f, srgb, 3);
-    if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
-      float3 linear;
-      srgb_to_linearrgb_v3_v3(linear, srgb);
-      r_global_vertices.set_vertex_color(r_global_vertices.vertices.size() - 1, linear);
-    }
-    else if (srgb.x > 0) {
-      /* Treats value in srgb.x as weight. */
-      r_global_vertices.set_vertex_weight(r_global_vertices.vertices.size() - 1, srgb.x);
-    }
+    geom_set_vertex_extra(r_global_vertices.vertices.size() - 1, srgb, r_global_vertices);
   }
   UNUSED_VARS(p);
 }
@@ -125,9 +136,7 @@ static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices
   }
 }
 
-static void geom_add_vertex_normal(const char *p,
-                                   const char *end,
-                                   GlobalVertices &r_global_vertices)
+static float3 parse_vertex_normal(const char *p, const char *end)
 {
   float3 normal;
   parse_floats(p, end, 0.0f, normal, 3);
@@ -135,14 +144,14 @@ static void geom_add_vertex_normal(const char *p,
    * making them ever-so-slightly non unit length. Make sure they are
    * normalized. */
   normalize_v3(normal);
-  r_global_vertices.vert_normals.append(normal);
+  return normal;
 }
 
-static void geom_add_uv_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+static float2 parse_uv_vertex(const char *p, const char *end)
 {
   float2 uv;
   parse_floats(p, end, 0.0f, uv, 2);
-  r_global_vertices.uv_vertices.append(uv);
+  return uv;
 }
 
 /**
@@ -208,30 +217,25 @@ static void geom_add_polyline(Geometry *geom,
   }
 }
 
-static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
-                             const GlobalVertices &global_vertices,
-                             const int material_index,
-                             const int group_index,
-                             const bool shaded_smooth)
-{
-  FaceElem curr_face;
-  curr_face.shaded_smooth = shaded_smooth;
-  curr_face.material_index = material_index;
-  if (group_index >= 0) {
-    curr_face.vertex_group_index = group_index;
-    geom->has_vertex_groups_ = true;
-  }
-
-  const int orig_corners_size = geom->face_corners_.size();
-  curr_face.start_index_ = orig_corners_size;
+/**
+ * A face corner as written in the file, the indices are validated and made zero-based by
+ * #geom_add_polygon, because that depends on the number of elements before the face.
+ */
+struct ParsedFaceCorner {
+  int vert_index;
+  int uv_vert_index = -1;
+  int vertex_normal_index = -1;
+  bool got_uv = false;
+  bool got_normal = false;
+};
 
-  bool face_valid = true;
+static void parse_face_corners(const char *p,
+                               const char *end,
+                               Vector<ParsedFaceCorner> &r_corners)
+{
   p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
-    FaceCorner corner;
-    bool got_uv = false, got_normal = false;
+  while (p < end) {
+    ParsedFaceCorner corner;
     /* Parse vertex index. */
     p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
 
@@ -240,21 +244,55 @@ static void geom_add_polygon(Geometry *geom,
       break;
     }
 
-    face_valid &= corner.vert_index != INT32_MAX;
     if (p < end && *p == '/') {
       /* Parse UV index. */
       ++p;
       if (p < end && *p != '/') {
         p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
+        corner.got_uv = corner.uv_vert_index != INT32_MAX;
       }
       /* Parse normal index. */
       if (p < end && *p == '/') {
         ++p;
         p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
+        corner.got_normal = corner.vertex_normal_index != INT32_MAX;
       }
     }
+    r_corners.append(corner);
+
+    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
+    p = drop_non_whitespace(p, end);
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
+static void geom_add_polygon(Geometry *geom,
+                             const Span<ParsedFaceCorner> parsed_corners,
+                             const GlobalVertices &global_vertices,
+                             const int material_index,
+                             const int group_index,
+                             const bool shaded_smooth)
+{
+  FaceElem curr_face;
+  curr_face.shaded_smooth = shaded_smooth;
+  curr_face.material_index = material_index;
+  if (group_index >= 0) {
+    curr_face.vertex_group_index = group_index;
+    geom->has_vertex_groups_ = true;
+  }
+
+  const int orig_corners_size = geom->face_corners_.size();
+  curr_face.start_index_ = orig_corners_size;
+
+  bool face_valid = true;
+  for (const ParsedFaceCorner &parsed_corner : parsed_corners) {
+    FaceCorner corner;
+    corner.vert_index = parsed_corner.vert_index;
+    corner.uv_vert_index = parsed_corner.uv_vert_index;
+    corner.vertex_normal_index = parsed_corner.vertex_normal_index;
+
+    face_valid &= corner.vert_index != INT32_MAX;
     /* Always keep stored indices non-negative and zero-based. */
     corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
     if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
@@ -268,7 +306,7 @@ static void geom_add_polygon(Geometry *geom,
       geom->track_vertex_index(corner.vert_index);
     }
     /* Ignore UV index, if the geometry does not have any UVs (#103212). */
-    if (got_uv && !global_vertices.uv_vertices.is_empty()) {
+    if (parsed_corner.got_uv && !global_vertices.uv_vertices.is_empty()) {
       corner.uv_vert_index += corner.uv_vert_index < 0 ? global_vertices.uv_vertices.size() : -1;
       if (corner.uv_vert_index < 0 || corner.uv_vert_index >= global_vertices.uv_vertices.size()) {
         CLOG_WARN(&LOG,
@@ -281,7 +319,7 @@ static void geom_add_polygon(Geometry *geom,
     /* Ignore corner normal index, if the geometry does not have any normals.
      * Some obj files out there do have face definitions that refer to normal indices,
      * without any normals being present (#98782). */
-    if (got_normal && !global_vertices.vert_normals.is_empty()) {
+    if (parsed_corner.got_normal && !global_vertices.vert_normals.is_empty()) {
       corner.vertex_normal_index += corner.vertex_normal_index < 0 ?
                                         global_vertices.vert_normals.size() :
                                         -1;
@@ -298,10 +336,9 @@ static void geom_add_polygon(Geometry *geom,
     geom->face_corners_.append(corner);
     curr_face.corner_count_++;
 
-    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
-    p = drop_non_whitespace(p, end);
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
+    if (!face_valid) {
+      break;
+    }
   }
 
   if (face_valid) {
@@ -427,8 +464,10 @@ static void geom_new_object(const char *p,
       r_curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
 }
 
-OBJParser::OBJParser(const OBJImportParams &import_params, size_t read_buffer_size)
-    : import_params_(import_params), read_buffer_size_(read_buffer_size)
+OBJParser::OBJParser(const OBJImportParams &import_params,
+                     size_t read_buffer_size,
+                     const bool use_threads)
+    : import_params_(import_params), read_buffer_size_(read_buffer_size), use_threads_(use_threads)
 {
   obj_file_ = BLI_fopen(import_params_.filepath, "rb");
   if (!obj_file_) {
@@ -467,6 +506,97 @@ static bool parse_keyword(const char *&p, const char *end, StringRef keyword)
   return true;
 }
 
+/**
+ * Elements of one chunk of the file, parsed on a worker thread. Everything that depends on the
+ * lines before (indices relative to the number of vertices so far, the current object, group,
+ * material...) is handled when adding the chunks in file order on the calling thread.
+ */
+struct OBJParsedChunk {
+  enum class ElemType : int8_t {
+    Vertex,
+    VertexNormal,
+    UVVertex,
+    Face,
+    /** Any other line, parsed when adding the chunk. */
+    Line,
+  };
+  /** Consecutive lines of the same type, in file order. */
+  struct Run {
+    ElemType type;
+    int count;
+  };
+  Vector<Run> runs;
+
+  Vector<float3> vertices;
+  /** Chunk vertex index and the extra values of `xyzrgb` vertices. */
+  Vector<std::pair<int, float3>> vertex_extras;
+  Vector<float3> vert_normals;
+  Vector<float2> uv_vertices;
+  Vector<ParsedFaceCorner> face_corners;
+  Vector<int> face_corner_counts;
+  Vector<StringRef> lines;
+  size_t line_count = 0;
+
+  void add_to_run(const ElemType type)
+  {
+    if (!runs.is_empty() && runs.last().type == type) {
+      runs.last().count++;
+    }
+    else {
+      runs.append({type, 1});
+    }
+  }
+};
+
+static void parse_chunk(StringRef buffer_str, OBJParsedChunk &r_chunk)
+{
+  using ElemType = OBJParsedChunk::ElemType;
+  while (!buffer_str.is_empty()) {
+    StringRef line = read_next_line(buffer_str);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    r_chunk.line_count++;
+    if (p == end) {
+      continue;
+    }
+    const char *line_start = p;
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        float3 vert;
+        p = parse_floats(p, end, 0.0f, vert, 3);
+        if (p < end) {
+          float3 srgb;
+          parse_floats(p, end, -1.0f, srgb, 3);
+          r_chunk.vertex_extras.append({int(r_chunk.vertices.size()), srgb});
+        }
+        r_chunk.vertices.append(vert);
+        r_chunk.add_to_run(ElemType::Vertex);
+      }
+      else if (parse_keyword(p, end, "vn")) {
+        r_chunk.vert_normals.append(parse_vertex_normal(p, end));
+        r_chunk.add_to_run(ElemType::VertexNormal);
+      }
+      else if (parse_keyword(p, end, "vt")) {
+        r_chunk.uv_vertices.append(parse_uv_vertex(p, end));
+        r_chunk.add_to_run(ElemType::UVVertex);
+      }
+    }
+    else if (parse_keyword(p, end, "f")) {
+      const int64_t corners_num = r_chunk.face_corners.size();
+      parse_face_corners(p, end, r_chunk.face_corners);
+      r_chunk.face_corner_counts.append(int(r_chunk.face_corners.size() - corners_num));
+      r_chunk.add_to_run(ElemType::Face);
+    }
+    else if (*p == '#' && !parse_keyword(p, end, "#MRGB")) {
+      /* Comments, nothing to do. */
+    }
+    else {
+      r_chunk.lines.append(StringRef(line_start, end));
+      r_chunk.add_to_run(ElemType::Line);
+    }
+  }
+}
+
 /* Special case: if there were no faces/edges in any geometries,
  * treat all the vertices as a point cloud. */
 static void use_all_vertices_if_no_faces(Geometry *geom,
@@ -505,23 +635,243 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
   string state_material_name;
   int state_material_index = -1;
 
+  auto add_face = [&](const Span<ParsedFaceCorner> corners) {
+    /* If we don't have a material index assigned yet, get one.
+     * It means "usemtl" state came from the previous object. */
+    if (state_material_index == -1 && !state_material_name.empty() &&
+        curr_geom->material_indices_.is_empty())
+    {
+      curr_geom->material_indices_.add_new(state_material_name, 0);
+      curr_geom->material_order_.append(state_material_name);
+      state_material_index = 0;
+    }
+
+    geom_add_polygon(curr_geom,
+                     corners,
+                     r_global_vertices,
+                     state_material_index,
+                     state_group_index,
+                     state_shaded_smooth);
+  };
+
+  Vector<ParsedFaceCorner> face_corners;
+
+  /* Parse a single line, `p` points to its first non white-space character. */
+  auto parse_line = [&](const char *p, const char *end) {
+    /* Most common things that start with 'v': vertices, normals, UVs. */
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        geom_add_vertex(p, end, r_global_vertices);
+      }
+      else if (parse_keyword(p, end, "vn")) {
+        r_global_vertices.vert_normals.append(parse_vertex_normal(p, end));
+      }
+      else if (parse_keyword(p, end, "vt")) {
+        r_global_vertices.uv_vertices.append(parse_uv_vertex(p, end));
+      }
+    }
+    /* Faces. */
+    else if (parse_keyword(p, end, "f")) {
+      face_corners.clear();
+      parse_face_corners(p, end, face_corners);
+      add_face(face_corners);
+    }
+    /* Faces. */
+    else if (parse_keyword(p, end, "l")) {
+      geom_add_polyline(curr_geom, p, end, r_global_vertices);
+    }
+    /* Objects. */
+    else if (parse_keyword(p, end, "o")) {
+      if (import_params_.use_split_objects) {
+        geom_new_object(p,
+                        end,
+                        state_shaded_smooth,
+                        state_group_name,
+                        state_material_index,
+                        curr_geom,
+                        r_all_geometries);
+      }
+    }
+    /* Groups. */
+    else if (parse_keyword(p, end, "g")) {
+      if (import_params_.use_split_groups) {
+        geom_new_object(p,
+                        end,
+                        state_shaded_smooth,
+                        state_group_name,
+                        state_material_index,
+                        curr_geom,
+                        r_all_geometries);
+      }
+      else {
+        geom_update_group(StringRef(p, end).trim(), state_group_name);
+        int new_index = curr_geom->group_indices_.size();
+        state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
+        if (new_index == state_group_index) {
+          curr_geom->group_order_.append(state_group_name);
+        }
+      }
+    }
+    /* Smoothing groups. */
+    else if (parse_keyword(p, end, "s")) {
+      geom_update_smooth_group(p, end, state_shaded_smooth);
+    }
+    /* Materials and their libraries. */
+    else if (parse_keyword(p, end, "usemtl")) {
+      state_material_name = StringRef(p, end).trim();
+      int new_mat_index = curr_geom->material_indices_.size();
+      state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
+                                                                        new_mat_index);
+      if (new_mat_index == state_material_index) {
+        curr_geom->material_order_.append(state_material_name);
+      }
+    }
+    else if (parse_keyword(p, end, "mtllib")) {
+      add_mtl_library(StringRef(p, end).trim());
+    }
+    else if (parse_keyword(p, end, "#MRGB")) {
+      geom_add_mrgb_colors(p, end, r_global_vertices);
+    }
+    /* Comments. */
+    else if (*p == '#') {
+      /* Nothing to do. */
+    }
+    /* Curve related things. */
+    else if (parse_keyword(p, end, "cstype")) {
+      curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
+    }
+    else if (parse_keyword(p, end, "deg")) {
+      geom_set_curve_degree(curr_geom, p, end);
+    }
+    else if (parse_keyword(p, end, "curv")) {
+      geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "parm")) {
+      geom_add_curve_parameters(curr_geom, p, end);
+    }
+    else if (StringRef(p, end).startswith("end")) {
+      /* End of curve definition, nothing else to do. */
+    }
+    else {
+      CLOG_WARN(&LOG, "OBJ element not recognized: '%s'", std::string(p, end).c_str());
+    }
+  };
+
+  /* Add the elements parsed by #parse_chunk, in the same way as #parse_line would. */
+  auto add_parsed_chunk = [&](const OBJParsedChunk &chunk) {
+    using ElemType = OBJParsedChunk::ElemType;
+    int64_t vert_i = 0, vert_extra_i = 0, normal_i = 0, uv_i = 0, face_i = 0, corner_i = 0,
+            line_i = 0;
+    for (const OBJParsedChunk::Run &run : chunk.runs) {
+      switch (run.type) {
+        case ElemType::Vertex: {
+          /* Only the first vertex can have a pending #MRGB block. */
+          r_global_vertices.flush_mrgb_block();
+          const int64_t start = r_global_vertices.vertices.size();
+          r_global_vertices.vertices.extend(chunk.vertices.as_span().slice(vert_i, run.count));
+          while (vert_extra_i < chunk.vertex_extras.size() &&
+                 chunk.vertex_extras[vert_extra_i].first < vert_i + run.count)
+          {
+            const std::pair<int, float3> &extra = chunk.vertex_extras[vert_extra_i];
+            geom_set_vertex_extra(start + extra.first - vert_i, extra.second, r_global_vertices);
+            vert_extra_i++;
+          }
+          vert_i += run.count;
+          break;
+        }
+        case ElemType::VertexNormal:
+          r_global_vertices.vert_normals.extend(
+              chunk.vert_normals.as_span().slice(normal_i, run.count));
+          normal_i += run.count;
+          break;
+        case ElemType::UVVertex:
+          r_global_vertices.uv_vertices.extend(
+              chunk.uv_vertices.as_span().slice(uv_i, run.count));
+          uv_i += run.count;
+          break;
+        case ElemType::Face:
+          for ([[maybe_unused]] const int i : IndexRange(run.count)) {
+            const int corners_num = chunk.face_corner_counts[face_i];
+            add_face(chunk.face_corners.as_span().slice(corner_i, corners_num));
+            corner_i += corners_num;
+            face_i++;
+          }
+          break;
+        case ElemType::Line:
+          for ([[maybe_unused]] const int i : IndexRange(run.count)) {
+            const StringRef line = chunk.lines[line_i];
+            parse_line(line.begin(), line.end());
+            line_i++;
+          }
+          break;
+      }
+    }
+  };
+
   /* Read the input file in chunks. We need up to twice the possible chunk size,
-   * to possibly store remainder of the previous input line that got broken mid-chunk. */
-  Array<char> buffer(read_buffer_size_ * 2);
+   * to possibly store remainder of the previous input line that got broken mid-chunk.
+   * When using threads, a batch of chunks is read and then parsed in parallel before adding them.
+   * The batch has one chunk per thread, but no more than the file needs and at most 32 to bound
+   * the memory used by the buffers. */
+  int buffers_num = 1;
+  if (use_threads_) {
+    const size_t file_size = BLI_file_size(import_params_.filepath);
+    const size_t file_chunks_num = file_size / read_buffer_size_ + 1;
+    buffers_num = int(
+        std::min<size_t>({file_chunks_num, size_t(BLI_system_thread_count()), 32}));
+  }
+  Array<Array<char>> buffers(buffers_num);
+  for (Array<char> &buffer : buffers) {
+    buffer.reinitialize(read_buffer_size_ * 2);
+  }
+  /* Read chunks that are not parsed yet, up to their last newline. */
+  Vector<StringRef> pending_chunks;
+  Array<OBJParsedChunk> parsed_chunks(use_threads_ ? buffers_num : 0);
+  size_t line_number = 0;
+
+  auto parse_pending_chunks = [&]() {
+    if (!use_threads_) {
+      for (const StringRef chunk : pending_chunks) {
+        StringRef buffer_str = chunk;
+        while (!buffer_str.is_empty()) {
+          StringRef line = read_next_line(buffer_str);
+          const char *p = line.begin(), *end = line.end();
+          p = drop_whitespace(p, end);
+          ++line_number;
+          if (p != end) {
+            parse_line(p, end);
+          }
+        }
+      }
+      pending_chunks.clear();
+      return;
+    }
+    threading::parallel_for(pending_chunks.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        parse_chunk(pending_chunks[i], parsed_chunks[i]);
+      }
+    });
+    for (const int64_t i : pending_chunks.index_range()) {
+      add_parsed_chunk(parsed_chunks[i]);
+      line_number += parsed_chunks[i].line_count;
+      parsed_chunks[i] = {};
+    }
+    pending_chunks.clear();
+  };
 
   size_t buffer_offset = 0;
-  size_t line_number = 0;
   while (true) {
+    char *buffer = buffers[pending_chunks.size()].data();
+
     /* Read a chunk of input from the file. */
-    size_t bytes_read = fread(buffer.data() + buffer_offset, 1, read_buffer_size_, obj_file_);
+    size_t bytes_read = fread(buffer + buffer_offset, 1, read_buffer_size_, obj_file_);
     if (bytes_read == 0 && buffer_offset == 0) {
       break; /* No more data to read. */
     }
 
     /* Take care of line continuations now (turn them into spaces);
      * the rest of the parsing code does not need to worry about them anymore. */
-    fixup_line_continuations(buffer.data() + buffer_offset,
-                             buffer.data() + buffer_offset + bytes_read);
+    fixup_line_continuations(buffer + buffer_offset, buffer + buffer_offset + bytes_read);
 
     /* Ensure buffer ends in a newline. */
     if (bytes_read < read_buffer_size_) {
@@ -546,6 +896,7 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
     }
     if (buffer[last_nl] != '\n') {
       /* Whole line did not fit into our read buffer. Warn and exit. */
+      parse_pending_chunks();
       CLOG_ERROR(&LOG,
                  "OBJ file contains a line #%zu that is too long (max. length %zu)",
                  line_number,
@@ -554,137 +905,21 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
     }
     ++last_nl;
 
-    /* Parse the buffer (until last newline) that we have so far,
-     * line by line. */
-    StringRef buffer_str{buffer.data(), int64_t(last_nl)};
-    while (!buffer_str.is_empty()) {
-      StringRef line = read_next_line(buffer_str);
-      const char *p = line.begin(), *end = line.end();
-      p = drop_whitespace(p, end);
-      ++line_number;
-      if (p == end) {
-        continue;
-      }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
-        }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        /* If we don't have a material index assigned yet, get one.
-         * It means "usemtl" state came from the previous object. */
-        if (state_material_index == -1 && !state_material_name.empty() &&
-            curr_geom->material_indices_.is_empty())
-        {
-          curr_geom->material_indices_.add_new(state_material_name, 0);
-          curr_geom->material_order_.append(state_material_name);
-          state_material_index = 0;
-        }
-
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_polyline(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        if (import_params_.use_split_objects) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        if (import_params_.use_split_groups) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-        else {
-          geom_update_group(StringRef(p, end).trim(), state_group_name);
-          int new_index = curr_geom->group_indices_.size();
-          state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-          if (new_index == state_group_index) {
-            curr_geom->group_order_.append(state_group_name);
-          }
-        }
-      }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
-        }
-      }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
-      }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
-      }
-      /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
-      }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
-      }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
-      }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
-      }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
-      }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
-      }
-      else {
-        CLOG_WARN(&LOG, "OBJ element not recognized: '%s'", std::string(p, end).c_str());
-      }
+    /* The buffer (until last newline) is parsed line by line. */
+    pending_chunks.append(StringRef(buffer, int64_t(last_nl)));
+    if (pending_chunks.size() == buffers_num) {
+      parse_pending_chunks();
     }
 
     /* We might have a line that was cut in the middle by the previous buffer;
      * copy it over for next chunk reading. */
     size_t left_size = buffer_end - last_nl;
-    memmove(buffer.data(), buffer.data() + last_nl, left_size);
+    memmove(buffers[pending_chunks.size()].data(), buffer + last_nl, left_size);
     buffer_offset = left_size;
   }
 
+  parse_pending_chunks();
+
   r_global_vertices.flush_mrgb_block();
   use_all_vertices_if_no_faces(curr_geom, r_all_geometries, r_global_vertices);
   add_default_mtl_library();
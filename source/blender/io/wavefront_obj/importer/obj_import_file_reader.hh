@@ -27,12 +27,18 @@ class OBJParser {
   FILE *obj_file_;
   Vector<std::string> mtl_libraries_;
   size_t read_buffer_size_;
+  bool use_threads_;
 
  public:
   /**
    * Open OBJ file at the path given in import parameters.
+   *
+   * \param use_threads: Parse several chunks of the file in parallel. The result is the same as
+   * when parsing the whole file on the calling thread.
    */
-  OBJParser(const OBJImportParams &import_params, size_t read_buffer_size);
+  OBJParser(const OBJImportParams &import_params,
+            size_t read_buffer_size,
+            bool use_threads = true);
   ~OBJParser();
 
   /**
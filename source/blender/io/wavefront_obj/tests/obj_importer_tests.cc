@@ -6,8 +6,11 @@
 
 #include "testing/testing.h"
 
+#include "BLI_fileops.h"
 #include "BLI_string.h"
 
+#include "BKE_appdir.hh"
+
 #include "CLG_log.h"
 
 #include "obj_import_file_reader.hh"
@@ -16,25 +19,35 @@ namespace blender::io::obj {
 
 /* Extensive tests for OBJ importing are in `io_obj_import_test.py`.
  * The tests here are only for testing OBJ reader buffer refill behavior,
- * by using a very small buffer size on purpose. */
+ * by using a very small buffer size on purpose, with both the single threaded and the threaded
+ * parsing. */
 
-TEST(obj_import, BufferRefillTest)
+static void parse_test_file(const char *filename,
+                            const size_t read_buffer_size,
+                            const bool use_threads,
+                            Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                            GlobalVertices &r_global_vertices)
 {
-  CLG_init();
-
   OBJImportParams params;
-  /* nurbs_cyclic.obj file has quite long lines, good to test read buffer refill. */
   std::string obj_path = blender::tests::flags_test_asset_dir() +
-                         SEP_STR "io_tests" SEP_STR "obj" SEP_STR + "nurbs_cyclic.obj";
+                         SEP_STR "io_tests" SEP_STR "obj" SEP_STR + filename;
   STRNCPY(params.filepath, obj_path.c_str());
 
-  /* Use a small read buffer size to test buffer refilling behavior. */
-  const size_t read_buffer_size = 650;
-  OBJParser obj_parser{params, read_buffer_size};
+  OBJParser obj_parser{params, read_buffer_size, use_threads};
+  obj_parser.parse(r_all_geometries, r_global_vertices);
+}
 
+static void test_buffer_refill(const bool use_threads)
+{
+  CLG_init();
+
+  /* nurbs_cyclic.obj file has quite long lines, good to test read buffer refill.
+   * Use a small read buffer size to test buffer refilling behavior. */
+  const size_t read_buffer_size = 650;
   Vector<std::unique_ptr<Geometry>> all_geometries;
   GlobalVertices global_vertices;
-  obj_parser.parse(all_geometries, global_vertices);
+  parse_test_file(
+      "nurbs_cyclic.obj", read_buffer_size, use_threads, all_geometries, global_vertices);
 
   EXPECT_EQ(1, all_geometries.size());
   EXPECT_EQ(GEOM_CURVE, all_geometries[0]->geom_type_);
@@ -45,4 +58,124 @@ TEST(obj_import, BufferRefillTest)
   CLG_exit();
 }
 
+TEST(obj_import, BufferRefillTest)
+{
+  test_buffer_refill(false);
+}
+
+TEST(obj_import, BufferRefillThreadedTest)
+{
+  test_buffer_refill(true);
+}
+
+static void expect_geometries_equal(const Span<std::unique_ptr<Geometry>> a,
+                                    const Span<std::unique_ptr<Geometry>> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int64_t i : a.index_range()) {
+    const Geometry &geom_a = *a[i];
+    const Geometry &geom_b = *b[i];
+    EXPECT_EQ(geom_a.geom_type_, geom_b.geom_type_);
+    EXPECT_EQ(geom_a.geometry_name_, geom_b.geometry_name_);
+    EXPECT_EQ(geom_a.group_order_, geom_b.group_order_);
+    EXPECT_EQ(geom_a.material_order_, geom_b.material_order_);
+    EXPECT_EQ(geom_a.vertex_index_min_, geom_b.vertex_index_min_);
+    EXPECT_EQ(geom_a.vertex_index_max_, geom_b.vertex_index_max_);
+    EXPECT_EQ(geom_a.vertices_.size(), geom_b.vertices_.size());
+    for (const int vert : geom_a.vertices_) {
+      EXPECT_TRUE(geom_b.vertices_.contains(vert));
+    }
+    EXPECT_EQ(geom_a.edges_, geom_b.edges_);
+    ASSERT_EQ(geom_a.face_corners_.size(), geom_b.face_corners_.size());
+    for (const int64_t corner : geom_a.face_corners_.index_range()) {
+      EXPECT_EQ(geom_a.face_corners_[corner].vert_index, geom_b.face_corners_[corner].vert_index);
+      EXPECT_EQ(geom_a.face_corners_[corner].uv_vert_index,
+                geom_b.face_corners_[corner].uv_vert_index);
+      EXPECT_EQ(geom_a.face_corners_[corner].vertex_normal_index,
+                geom_b.face_corners_[corner].vertex_normal_index);
+    }
+    ASSERT_EQ(geom_a.face_elements_.size(), geom_b.face_elements_.size());
+    for (const int64_t face : geom_a.face_elements_.index_range()) {
+      const FaceElem &face_a = geom_a.face_elements_[face];
+      const FaceElem &face_b = geom_b.face_elements_[face];
+      EXPECT_EQ(face_a.vertex_group_index, face_b.vertex_group_index);
+      EXPECT_EQ(face_a.material_index, face_b.material_index);
+      EXPECT_EQ(face_a.shaded_smooth, face_b.shaded_smooth);
+      EXPECT_EQ(face_a.start_index_, face_b.start_index_);
+      EXPECT_EQ(face_a.corner_count_, face_b.corner_count_);
+    }
+    EXPECT_EQ(geom_a.has_invalid_faces_, geom_b.has_invalid_faces_);
+    EXPECT_EQ(geom_a.has_vertex_groups_, geom_b.has_vertex_groups_);
+    EXPECT_EQ(geom_a.total_corner_, geom_b.total_corner_);
+  }
+}
+
+static void test_threaded_parse(const char *filename, const size_t read_buffer_size)
+{
+  Vector<std::unique_ptr<Geometry>> serial_geometries;
+  GlobalVertices serial_vertices;
+  parse_test_file(filename, read_buffer_size, false, serial_geometries, serial_vertices);
+
+  Vector<std::unique_ptr<Geometry>> threaded_geometries;
+  GlobalVertices threaded_vertices;
+  parse_test_file(filename, read_buffer_size, true, threaded_geometries, threaded_vertices);
+
+  EXPECT_FALSE(serial_vertices.vertices.is_empty());
+  EXPECT_EQ(serial_vertices.vertices, threaded_vertices.vertices);
+  EXPECT_EQ(serial_vertices.uv_vertices, threaded_vertices.uv_vertices);
+  EXPECT_EQ(serial_vertices.vert_normals, threaded_vertices.vert_normals);
+  EXPECT_EQ(serial_vertices.vertex_colors, threaded_vertices.vertex_colors);
+  EXPECT_EQ(serial_vertices.vertex_weights, threaded_vertices.vertex_weights);
+  expect_geometries_equal(serial_geometries, threaded_geometries);
+}
+
+TEST(obj_import, ThreadedParseTest)
+{
+  CLG_init();
+
+  /* Small buffer sizes split the files into many chunks, with lines and runs of vertices and faces
+   * crossing chunk boundaries at different places. The default buffer size reads each file in a
+   * single chunk. */
+  for (const size_t read_buffer_size : {256, 257, 1000, 64 * 1024}) {
+    /* Normals, UVs and relative indices. */
+    test_threaded_parse("suzanne_all_data.obj", read_buffer_size);
+    /* Multiple objects, groups and materials. */
+    test_threaded_parse("all_objects_mat_groups.obj", read_buffer_size);
+    /* Vertex colors. */
+    test_threaded_parse("cubes_vertex_colors.obj", read_buffer_size);
+    /* Loose edges and vertices. */
+    test_threaded_parse("cube_loose_edges_verts.obj", read_buffer_size);
+  }
+
+  CLG_exit();
+}
+
+TEST(obj_import, ThreadedParseEmptyFileTest)
+{
+  CLG_init();
+  BKE_tempdir_init(nullptr);
+
+  const std::string obj_path = std::string(BKE_tempdir_base()) + SEP_STR + "empty.obj";
+  FILE *file = BLI_fopen(obj_path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  fclose(file);
+
+  OBJImportParams params;
+  STRNCPY(params.filepath, obj_path.c_str());
+  OBJParser obj_parser{params, 64 * 1024, true};
+
+  Vector<std::unique_ptr<Geometry>> all_geometries;
+  GlobalVertices global_vertices;
+  obj_parser.parse(all_geometries, global_vertices);
+
+  EXPECT_TRUE(global_vertices.vertices.is_empty());
+  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
+    EXPECT_TRUE(geometry->face_elements_.is_empty());
+  }
+
+  BLI_delete(obj_path.c_str(), false, false);
+  BKE_tempdir_session_purge();
+  CLG_exit();
+}
+
 }  // namespace blender::io::obj
@@ -12,6 +12,15 @@
 
 struct GSet;
 
+#ifdef __cplusplus
+namespace blender::bke {
+struct CacheFileRuntime;
+}  // namespace blender::bke
+using CacheFileRuntimeHandle = blender::bke::CacheFileRuntime;
+#else
+typedef struct CacheFileRuntimeHandle CacheFileRuntimeHandle;
+#endif
+
 /* CacheFile::type */
 typedef enum {
   CACHEFILE_TYPE_ALEMBIC = 1,
@@ -82,7 +91,11 @@ typedef struct CacheFile {
   /** The frame offset to subtract. */
   float frame_offset;
 
-  char _pad[4];
+  /**
+   * Number of frames after the current one that are decoded in the background during playback,
+   * zero disables caching of decoded frames.
+   */
+  int playback_prefetch_frames;
 
   /** Animation flag. */
   short flag;
@@ -118,4 +131,5 @@ typedef struct CacheFile {
   struct CacheArchiveHandle *handle;
   char handle_filepath[1024];
   struct GSet *handle_readers;
+  CacheFileRuntimeHandle *runtime;
 } CacheFile;
@@ -10,6 +10,15 @@
 
 #include "DNA_listBase.h"
 
+#ifdef __cplusplus
+namespace blender::bke {
+struct PointCacheRuntime;
+}  // namespace blender::bke
+using PointCacheRuntimeHandle = blender::bke::PointCacheRuntime;
+#else
+typedef struct PointCacheRuntimeHandle PointCacheRuntimeHandle;
+#endif
+
 /**
  * Point cache file data types:
  * - Used as `(1 << flag)` so poke jahka if you reach the limit of 15.
@@ -118,6 +127,9 @@ typedef struct PointCache {
   struct PTCacheEdit *edit;
   /** Free callback. */
   void (*free_edit)(struct PTCacheEdit *edit);
+
+  /** Prefetching of disk cache frames during playback. */
+  PointCacheRuntimeHandle *runtime;
 } PointCache;
 
 /** #PointCache.flag */
@@ -144,13 +156,17 @@ enum {
   PTCACHE_IGNORE_CLEAR = 1 << 13,
 
   PTCACHE_FLAG_INFO_DIRTY = 1 << 14,
+  /** Store all frames of a disk cache in one container file instead of a file per frame. */
+  PTCACHE_DISK_CONTAINER = 1 << 15,
 
   PTCACHE_REDO_NEEDED = PTCACHE_OUTDATED | PTCACHE_FRAMES_SKIPPED,
-  PTCACHE_FLAGS_COPY = PTCACHE_DISK_CACHE | PTCACHE_EXTERNAL | PTCACHE_IGNORE_LIBPATH,
+  PTCACHE_FLAGS_COPY = PTCACHE_DISK_CACHE | PTCACHE_EXTERNAL | PTCACHE_IGNORE_LIBPATH |
+                       PTCACHE_DISK_CONTAINER,
 };
 
 enum {
   PTCACHE_COMPRESS_NO = 0,
   PTCACHE_COMPRESS_LZO = 1,
   PTCACHE_COMPRESS_LZMA = 2,
+  PTCACHE_COMPRESS_ZSTD = 3,
 };
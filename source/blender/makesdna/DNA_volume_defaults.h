@@ -39,6 +39,8 @@
     .display = _DNA_DEFAULT_VolumeDisplay, \
     .render = _DNA_DEFAULT_VolumeRender, \
     .velocity_scale = 1.0f, \
+    .load_bounds_min = {-1.0f, -1.0f, -1.0f}, \
+    .load_bounds_max = {1.0f, 1.0f, 1.0f}, \
 }
 
 /** \} */
@@ -82,6 +82,10 @@ typedef struct Volume {
   /* Factor for velocity vector for artistic control. */
   float velocity_scale;
 
+  /* Only the part of the grids inside these bounds is loaded, see #VO_USE_LOAD_BOUNDS. */
+  float load_bounds_min[3];
+  float load_bounds_max[3];
+
   /* Draw Cache */
   void *batch_cache;
 
@@ -92,6 +96,7 @@ typedef struct Volume {
 /** #Volume.flag */
 enum {
   VO_DS_EXPAND = (1 << 0),
+  VO_USE_LOAD_BOUNDS = (1 << 1),
 };
 
 /** #Volume.sequence_mode */
@@ -62,6 +62,18 @@ static void rna_CacheFile_dependency_update(Main *bmain, Scene *scene, PointerRN
   DEG_relations_tag_update(bmain);
 }
 
+static int rna_CacheFile_playback_cache_hits_get(PointerRNA *ptr)
+{
+  const CacheFile *cache_file = (const CacheFile *)ptr->data;
+  return int(std::min<int64_t>(BKE_cachefile_playback_stats(cache_file).hits, INT_MAX));
+}
+
+static int rna_CacheFile_playback_cache_misses_get(PointerRNA *ptr)
+{
+  const CacheFile *cache_file = (const CacheFile *)ptr->data;
+  return int(std::min<int64_t>(BKE_cachefile_playback_stats(cache_file).misses, INT_MAX));
+}
+
 static void rna_CacheFile_object_paths_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
 {
   CacheFile *cache_file = (CacheFile *)ptr->data;
@@ -308,6 +320,31 @@ static void rna_def_cachefile(BlenderRNA *brna)
       "fit within the limit, rendering is aborted");
   RNA_def_property_update(prop, 0, "rna_CacheFile_update");
 
+  prop = RNA_def_property(srna, "playback_prefetch_frames", PROP_INT, PROP_NONE);
+  RNA_def_property_range(prop, 0, 250);
+  RNA_def_property_ui_range(prop, 0, 50, 1, -1);
+  RNA_def_property_ui_text(prop,
+                           "Playback Prefetch",
+                           "Number of frames after the current one that the Mesh Sequence Cache "
+                           "modifier reads in the background, decoded frames are kept in the "
+                           "memory cache (0 to disable)");
+  RNA_def_property_update(prop, 0, "rna_CacheFile_update");
+
+  prop = RNA_def_property(srna, "playback_cache_hits", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_int_funcs(prop, "rna_CacheFile_playback_cache_hits_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Playback Cache Hits",
+                           "Number of evaluated frames that were already decoded in the memory "
+                           "cache");
+
+  prop = RNA_def_property(srna, "playback_cache_misses", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_int_funcs(prop, "rna_CacheFile_playback_cache_misses_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Playback Cache Misses",
+                           "Number of evaluated frames that had to be read from the file");
+
   /* ----------------- Axis Conversion ----------------- */
 
   prop = RNA_def_property(srna, "forward_axis", PROP_ENUM, PROP_NONE);
@@ -7952,6 +7952,14 @@ static void rna_def_modifier_nodes_bake(BlenderRNA *brna)
       prop, "Custom Path", "Specify a path where the baked data should be stored manually");
   RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
 
+  prop = RNA_def_property(srna, "use_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", NODES_MODIFIER_BAKE_COMPRESS);
+  RNA_def_property_ui_text(prop,
+                           "Compress",
+                           "Compress baked arrays to reduce the size of the bake. Uncompressed "
+                           "arrays can be used directly from disk without reading them first");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
+
   prop = RNA_def_property(srna, "bake_target", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_items(prop, bake_target_in_node_items);
   RNA_def_property_ui_text(prop, "Bake Target", "Where to store the baked data");
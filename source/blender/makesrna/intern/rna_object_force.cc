@@ -249,6 +249,24 @@ static void rna_Cache_toggle_disk_cache(Main * /*bmain*/, Scene * /*scene*/, Poi
   }
 }
 
+static void rna_Cache_toggle_disk_container(Main * /*bmain*/, Scene * /*scene*/, PointerRNA *ptr)
+{
+  Object *ob = nullptr;
+  Scene *scene = nullptr;
+
+  if (!rna_Cache_get_valid_owner_ID(ptr, &ob, &scene)) {
+    return;
+  }
+
+  PointCache *cache = (PointCache *)ptr->data;
+
+  PTCacheID pid = BKE_ptcache_id_find(ob, scene, cache);
+
+  if (pid.cache) {
+    BKE_ptcache_toggle_disk_container(&pid);
+  }
+}
+
 bool rna_Cache_use_disk_cache_override_apply(Main * /*bmain*/,
                                              RNAPropertyOverrideApplyContext &rnaapply_ctx)
 {
@@ -961,6 +979,11 @@ static void rna_def_pointcache_common(StructRNA *srna)
       {PTCACHE_COMPRESS_NO, "NO", 0, "None", "No compression"},
       {PTCACHE_COMPRESS_LZO, "LIGHT", 0, "Lite", "Fast but not so effective compression"},
       {PTCACHE_COMPRESS_LZMA, "HEAVY", 0, "Heavy", "Effective but slow compression"},
+      {PTCACHE_COMPRESS_ZSTD,
+       "ZSTD",
+       0,
+       "Zstandard",
+       "Fast and effective compression, data streams are compressed on multiple threads"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
@@ -1068,6 +1091,15 @@ static void rna_def_pointcache_common(StructRNA *srna)
       "(for local bakes per scene file, disable this option)");
   RNA_def_property_update(prop, NC_OBJECT, "rna_Cache_idname_change");
 
+  prop = RNA_def_property(srna, "use_disk_container", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", PTCACHE_DISK_CONTAINER);
+  RNA_def_property_ui_text(
+      prop,
+      "Single File",
+      "Store all frames of the disk cache in one file with a frame index, instead of a file per "
+      "frame");
+  RNA_def_property_update(prop, NC_OBJECT, "rna_Cache_toggle_disk_container");
+
   RNA_define_lib_overridable(false);
 }
 
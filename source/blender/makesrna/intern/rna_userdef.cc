@@ -7593,6 +7593,18 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop, "Shader Node Previews", "Enables previews in the shader node editor");
   RNA_def_property_update(prop, 0, "rna_userdef_ui_update");
 
+  prop = RNA_def_property(srna, "use_undo_incremental", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Undo",
+                           "Only store the data-blocks tagged as changed since the previous undo "
+                           "step, instead of writing all of them on each global undo push");
+
+  prop = RNA_def_property(srna, "use_save_async", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Background Save",
+                           "Write the file to disk in a background job when saving interactively "
+                           "or auto-saving, only the in-memory snapshot blocks the interface");
+
   prop = RNA_def_property(srna, "use_extensions_debug", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
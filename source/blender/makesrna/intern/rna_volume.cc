@@ -52,6 +52,7 @@ struct DummyVolumeGridData;
 #ifdef RNA_RUNTIME
 
 #  include "BKE_volume.hh"
+#  include "BKE_volume_grid_file_cache.hh"
 
 #  include "DEG_depsgraph.hh"
 #  include "DEG_depsgraph_build.hh"
@@ -59,6 +60,48 @@ struct DummyVolumeGridData;
 #  include "WM_api.hh"
 #  include "WM_types.hh"
 
+/* Statistics of the grid cache, which is shared by all volumes. */
+
+static float rna_VolumeGrids_cache_memory_get(PointerRNA * /*ptr*/)
+{
+#  ifdef WITH_OPENVDB
+  const int64_t bytes = blender::bke::volume_grid::file_cache::get_statistics().trees_bytes;
+  return float(double(bytes) / (1024.0 * 1024.0));
+#  else
+  return 0.0f;
+#  endif
+}
+
+static int rna_VolumeGrids_cache_grids_num_get(PointerRNA * /*ptr*/)
+{
+#  ifdef WITH_OPENVDB
+  const int64_t num = blender::bke::volume_grid::file_cache::get_statistics().trees_num;
+  return int(std::min<int64_t>(num, INT_MAX));
+#  else
+  return 0;
+#  endif
+}
+
+static int rna_VolumeGrids_cache_hits_get(PointerRNA * /*ptr*/)
+{
+#  ifdef WITH_OPENVDB
+  const int64_t num = blender::bke::volume_grid::file_cache::get_statistics().hits_num;
+  return int(std::min<int64_t>(num, INT_MAX));
+#  else
+  return 0;
+#  endif
+}
+
+static int rna_VolumeGrids_cache_misses_get(PointerRNA * /*ptr*/)
+{
+#  ifdef WITH_OPENVDB
+  const int64_t num = blender::bke::volume_grid::file_cache::get_statistics().misses_num;
+  return int(std::min<int64_t>(num, INT_MAX));
+#  else
+  return 0;
+#  endif
+}
+
 static std::optional<std::string> rna_VolumeRender_path(const PointerRNA * /*ptr*/)
 {
   return "render";
@@ -364,6 +407,33 @@ static void rna_def_volume_grids(BlenderRNA *brna, PropertyRNA *cprop)
                            "Volume file used for loading the volume at the current frame. Empty "
                            "if the volume has not be loaded or the frame only exists in memory.");
 
+  /* Statistics of the grid cache shared by all volumes. */
+  prop = RNA_def_property(srna, "cache_memory", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_float_funcs(prop, "rna_VolumeGrids_cache_memory_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Cache Memory",
+                           "Approximate memory in megabytes used by grids that were loaded from "
+                           "files and are kept in the memory cache, shared by all volumes");
+
+  prop = RNA_def_property(srna, "cache_grids_num", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_int_funcs(prop, "rna_VolumeGrids_cache_grids_num_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cached Grids", "Number of grids loaded from files that are kept in the memory cache");
+
+  prop = RNA_def_property(srna, "cache_hits", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_int_funcs(prop, "rna_VolumeGrids_cache_hits_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cache Hits", "Number of grid loads that were found in the memory cache");
+
+  prop = RNA_def_property(srna, "cache_misses", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_int_funcs(prop, "rna_VolumeGrids_cache_misses_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cache Misses", "Number of grid loads that had to read the file");
+
   /* API */
   FunctionRNA *func;
   PropertyRNA *parm;
@@ -627,6 +697,28 @@ static void rna_def_volume(BlenderRNA *brna)
   RNA_def_property_translation_context(prop, BLT_I18NCONTEXT_ID_SEQUENCE);
   RNA_def_property_update(prop, 0, "rna_Volume_update_filepath");
 
+  /* Partial loading. */
+  prop = RNA_def_property(srna, "use_load_bounds", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", VO_USE_LOAD_BOUNDS);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Load Bounds",
+                           "Only read the voxels inside the bounds from the file, to reduce "
+                           "memory usage and loading time of large volumes");
+  RNA_def_property_update(prop, 0, "rna_Volume_update_filepath");
+
+  prop = RNA_def_property(srna, "load_bounds_min", PROP_FLOAT, PROP_TRANSLATION);
+  RNA_def_property_float_sdna(prop, nullptr, "load_bounds_min");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop, "Load Bounds Min", "Minimum corner of the loaded region");
+  RNA_def_property_update(prop, 0, "rna_Volume_update_filepath");
+
+  prop = RNA_def_property(srna, "load_bounds_max", PROP_FLOAT, PROP_TRANSLATION);
+  RNA_def_property_float_sdna(prop, nullptr, "load_bounds_max");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop, "Load Bounds Max", "Maximum corner of the loaded region");
+  RNA_def_property_update(prop, 0, "rna_Volume_update_filepath");
+
   /* Grids */
   prop = RNA_def_property(srna, "grids", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_struct_type(prop, "VolumeGrid");
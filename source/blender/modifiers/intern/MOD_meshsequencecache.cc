@@ -214,37 +214,19 @@ static void modify_geometry_set(ModifierData *md,
 
   /* Time (in frames or seconds) between two velocity samples. Automatically computed to
    * scale the velocity vectors at render time for generating proper motion blur data. */
-#  ifdef WITH_ALEMBIC
   float velocity_scale = mcmd->velocity_scale;
   if (mcmd->cache_file->velocity_unit == CACHEFILE_VELOCITY_UNIT_FRAME) {
     velocity_scale *= FPS;
   }
-#  endif
 
-  switch (cache_file->type) {
-    case CACHEFILE_TYPE_ALEMBIC: {
-#  ifdef WITH_ALEMBIC
-      ABCReadParams params;
-      params.time = time;
-      params.read_flags = mcmd->read_flag;
-      params.velocity_name = mcmd->cache_file->velocity_name;
-      params.velocity_scale = velocity_scale;
-      ABC_read_geometry(mcmd->reader, ctx->object, *geometry_set, &params, &err_str);
-#  endif
-      break;
-    }
-    case CACHEFILE_TYPE_USD: {
-#  ifdef WITH_USD
-      const blender::io::usd::USDMeshReadParams params = blender::io::usd::create_mesh_read_params(
-          time * FPS, mcmd->read_flag);
-      blender::io::usd::USD_read_geometry(
-          mcmd->reader, ctx->object, *geometry_set, params, &err_str);
-#  endif
-      break;
-    }
-    case CACHE_FILE_TYPE_INVALID:
-      break;
-  }
+  CacheFileReadGeometryParams params;
+  params.object_path = mcmd->object_path;
+  params.frame = frame;
+  params.fps = FPS;
+  params.read_flag = mcmd->read_flag;
+  params.velocity_scale = velocity_scale;
+  BKE_cachefile_reader_read_geometry(
+      cache_file, mcmd->reader, ctx->object, ctx->depsgraph, *geometry_set, params, &err_str);
 
   if (err_str) {
     BKE_modifier_set_error(ctx->object, md, "%s", err_str);
@@ -823,6 +823,7 @@ void draw_common_bake_settings(bContext *C, BakeDrawContext &ctx, uiLayout *layo
                 IFACE_("Path"),
                 ICON_NONE,
                 placeholder_path);
+    uiItemR(col, &ctx.bake_rna, "use_compression", UI_ITEM_NONE, IFACE_("Compress"), ICON_NONE);
   }
   {
     uiLayout *col = uiLayoutColumn(settings_col, true);
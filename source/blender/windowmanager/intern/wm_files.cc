@@ -86,6 +86,7 @@
 #include "BKE_undo_system.hh"
 #include "BKE_workspace.hh"
 
+#include "BLO_undofile.hh"
 #include "BLO_writefile.hh"
 
 #include "RNA_access.hh"
@@ -2053,6 +2054,135 @@ static ImBuf *blend_file_thumb_from_camera(const bContext *C,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Background File Write
+ *
+ * The file is written into memory on the main thread (see #BLO_write_file_snapshot),
+ * compressing it and writing it to disk is done by a job.
+ * \{ */
+
+struct FileWriteJob {
+  wmWindowManager *wm;
+  /** The file that was written into #memfile. */
+  Main *bmain;
+  MemFile memfile = {};
+  char filepath[FILE_MAX];
+  int fileflags;
+  bool use_save_versions;
+  /** Saving the main file (not auto-save): create the thumbnail and run the save callbacks. */
+  bool is_save;
+  /** Don't make the written file the current one. */
+  bool use_save_as_copy;
+  bool do_history_file_update;
+  /** Owned by the job, written once the file exists. */
+  ImBuf *ibuf_thumb;
+  bool success;
+};
+
+static bool wm_file_write_use_async()
+{
+  return !G.background && USER_EXPERIMENTAL_TEST(&U, use_save_async);
+}
+
+static void wm_file_write_job_startjob(void *customdata, wmJobWorkerStatus *worker_status)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+
+  /* Stopping the job is ignored on purpose, a running save is always finished (e.g. on exit). */
+  job->success = BLO_memfile_write_file(&job->memfile,
+                                        job->filepath,
+                                        job->fileflags,
+                                        job->use_save_versions,
+                                        &worker_status->progress,
+                                        worker_status->reports);
+
+  worker_status->progress = 1.0f;
+  worker_status->do_update = true;
+}
+
+static void wm_file_write_job_endjob(void *customdata)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+  Main *bmain = job->bmain;
+
+  if (!job->is_save) {
+    return;
+  }
+
+  if (job->success) {
+    /* Only now the file exists on disk, it can become the current file. */
+    if (job->use_save_as_copy == false) {
+      STRNCPY(bmain->filepath, job->filepath); /* Is guaranteed current file. */
+
+      /* The file on disk now matches the currently opened data version-wise. */
+      bmain->has_forward_compatibility_issues = false;
+
+      /* Notify WM so that saved status and window title can be updated. */
+      WM_main_add_notifier(NC_WM | ND_FILESAVE, nullptr);
+    }
+
+    SET_FLAG_FROM_TEST(G.fileflags, job->fileflags & G_FILE_COMPRESS, G_FILE_COMPRESS);
+
+    /* Prevent background mode scripts from clobbering history. */
+    if (job->do_history_file_update) {
+      wm_history_file_update();
+    }
+
+    /* Run this function after because the file can't be written before the blend is. */
+    if (job->ibuf_thumb) {
+      IMB_thumb_delete(job->filepath, THB_FAIL); /* Without this a failed thumb overrides. */
+      job->ibuf_thumb = IMB_thumb_create(
+          job->filepath, THB_LARGE, THB_SOURCE_BLEND, job->ibuf_thumb);
+    }
+
+    /* Without this there is no feedback the file was saved. */
+    WM_reportf(RPT_INFO, "Saved \"%s\"", BLI_path_basename(job->filepath));
+  }
+  else {
+    job->wm->file_saved = 0;
+    WM_reportf(RPT_ERROR, "Cannot save \"%s\"", BLI_path_basename(job->filepath));
+  }
+
+  BKE_callback_exec_string(
+      bmain, job->success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, job->filepath);
+}
+
+static void wm_file_write_job_free(void *customdata)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+  BLO_memfile_free(&job->memfile);
+  if (job->ibuf_thumb) {
+    IMB_freeImBuf(job->ibuf_thumb);
+  }
+  MEM_delete(job);
+}
+
+/**
+ * Write the memory snapshot in \a job to its file path in a background job,
+ * taking ownership of \a job.
+ */
+static void wm_file_write_job_start(wmWindowManager *wm, FileWriteJob *job)
+{
+  /* Finish a previous write first, so that files are written in the order they were saved. */
+  WM_jobs_kill_type(wm, wm, WM_JOB_TYPE_FILE_WRITE);
+
+  wmJob *wm_job = WM_jobs_get(wm,
+                              wm->winactive,
+                              wm,
+                              job->is_save ? "Saving File" : "Auto-Saving",
+                              WM_JOB_PROGRESS,
+                              WM_JOB_TYPE_FILE_WRITE);
+
+  WM_jobs_customdata_set(wm_job, job, wm_file_write_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, NC_WM | ND_FILESAVE);
+  WM_jobs_callbacks(
+      wm_job, wm_file_write_job_startjob, nullptr, nullptr, wm_file_write_job_endjob);
+
+  WM_jobs_start(wm, wm_job);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Write Main Blend-File (internal)
  * \{ */
@@ -2107,12 +2237,16 @@ static bool wm_file_write_check_with_report_on_failure(Main *bmain,
 
 /**
  * \see #wm_homefile_write_exec wraps #BLO_write_file in a similar way.
+ *
+ * \param use_async: Only write the file into memory, writing it to disk is done by a job. The
+ * thumbnail, the "Saved" report and the post-save callbacks are deferred until the job ends.
  */
 static bool wm_file_write(bContext *C,
                           const char *filepath,
                           int fileflags,
                           eBLO_WritePathRemap remap_mode,
                           bool use_save_as_copy,
+                          const bool use_async,
                           ReportList *reports)
 {
   Main *bmain = CTX_data_main(C);
@@ -2214,9 +2348,37 @@ static bool wm_file_write(bContext *C,
   blend_write_params.use_save_as_copy = use_save_as_copy;
   blend_write_params.thumb = thumb;
 
-  const bool success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
+  bool success;
+  bool is_async = false;
+  if (use_async) {
+    FileWriteJob *job = MEM_new<FileWriteJob>(__func__);
+    success = BLO_write_file_snapshot(
+        bmain, filepath, fileflags, &blend_write_params, reports, &job->memfile);
+    if (success) {
+      job->wm = CTX_wm_manager(C);
+      job->bmain = bmain;
+      STRNCPY(job->filepath, filepath);
+      job->fileflags = fileflags;
+      job->use_save_versions = blend_write_params.use_save_versions;
+      job->is_save = true;
+      job->use_save_as_copy = use_save_as_copy;
+      job->do_history_file_update = (G.background == false) &&
+                                    (CTX_wm_manager(C)->op_undo_depth == 0);
+      job->ibuf_thumb = ibuf_thumb;
+      ibuf_thumb = nullptr;
+      wm_file_write_job_start(CTX_wm_manager(C), job);
+      is_async = true;
+    }
+    else {
+      MEM_delete(job);
+    }
+  }
+  else {
+    success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
+  }
 
-  if (success) {
+  /* The job makes the file current and runs the post-save callbacks once it's written. */
+  if (success && !is_async) {
     const bool do_history_file_update = (G.background == false) &&
                                         (CTX_wm_manager(C)->op_undo_depth == 0);
 
@@ -2241,8 +2403,10 @@ static bool wm_file_write(bContext *C,
     BKE_reportf(reports, RPT_INFO, "Saved \"%s\"", BLI_path_basename(filepath));
   }
 
-  BKE_callback_exec_string(
-      bmain, success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, filepath);
+  if (!is_async) {
+    BKE_callback_exec_string(
+        bmain, success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, filepath);
+  }
 
   if (ibuf_thumb) {
     IMB_freeImBuf(ibuf_thumb);
@@ -2285,6 +2449,42 @@ static void wm_autosave_location(char filepath[FILE_MAX])
   BLI_path_join(filepath, FILE_MAX, tempdir_base, filename);
 }
 
+static void wm_autosave_write_ex(wmWindowManager *wm, Main *bmain, const bool use_async)
+{
+  ED_editors_flush_edits(bmain);
+
+  char filepath[FILE_MAX];
+  wm_autosave_location(filepath);
+  /* Save as regular blend file with recovery information and always compress them, see: !132685.
+   */
+  const int fileflags = G.fileflags | G_FILE_RECOVER_WRITE | G_FILE_COMPRESS;
+
+  /* Error reporting into console. */
+  BlendFileWriteParams params{};
+  if (use_async) {
+    FileWriteJob *job = MEM_new<FileWriteJob>(__func__);
+    if (BLO_write_file_snapshot(bmain, filepath, fileflags, &params, nullptr, &job->memfile)) {
+      job->wm = wm;
+      job->bmain = bmain;
+      STRNCPY(job->filepath, filepath);
+      job->fileflags = fileflags;
+      wm_file_write_job_start(wm, job);
+    }
+    else {
+      MEM_delete(job);
+    }
+  }
+  else {
+    BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  }
+
+  /* Restart auto-save timer. */
+  wm_autosave_timer_end(wm);
+  wm_autosave_timer_begin(wm);
+
+  wm->autosave_scheduled = false;
+}
+
 static bool wm_autosave_write_try(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -2296,11 +2496,11 @@ static bool wm_autosave_write_try(Main *bmain, wmWindowManager *wm)
    * auto-save when we are in a mode where auto-save wouldn't have worked previously anyway. This
    * check can be removed once the performance regressions have been solved. */
   if (ED_undosys_stack_memfile_get_if_active(wm->undo_stack) != nullptr) {
-    WM_autosave_write(wm, bmain);
+    wm_autosave_write_ex(wm, bmain, wm_file_write_use_async());
     return true;
   }
   if ((U.uiflag & USER_GLOBALUNDO) == 0) {
-    WM_autosave_write(wm, bmain);
+    wm_autosave_write_ex(wm, bmain, wm_file_write_use_async());
     return true;
   }
   /* Can't auto-save with MemFile right now, try again later. */
@@ -2314,23 +2514,7 @@ bool WM_autosave_is_scheduled(wmWindowManager *wm)
 
 void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 {
-  ED_editors_flush_edits(bmain);
-
-  char filepath[FILE_MAX];
-  wm_autosave_location(filepath);
-  /* Save as regular blend file with recovery information and always compress them, see: !132685.
-   */
-  const int fileflags = G.fileflags | G_FILE_RECOVER_WRITE | G_FILE_COMPRESS;
-
-  /* Error reporting into console. */
-  BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
-
-  /* Restart auto-save timer. */
-  wm_autosave_timer_end(wm);
-  wm_autosave_timer_begin(wm);
-
-  wm->autosave_scheduled = false;
+  wm_autosave_write_ex(wm, bmain, false);
 }
 
 static void wm_autosave_timer_begin_ex(wmWindowManager *wm, double timestep)
@@ -3694,8 +3878,13 @@ static int wm_save_as_mainfile_exec(bContext *C, wmOperator *op)
   /* Set compression flag. */
   SET_FLAG_FROM_TEST(fileflags, RNA_boolean_get(op->ptr, "compress"), G_FILE_COMPRESS);
 
+  /* Only write in the background when saving interactively, scripts and quitting rely on the file
+   * being written when the operator returns. */
+  const bool use_async = wm_file_write_use_async() && (op->flag & OP_IS_INVOKE) &&
+                         !(!is_save_as && RNA_boolean_get(op->ptr, "exit"));
+
   const bool success = wm_file_write(
-      C, filepath, fileflags, remap_mode, use_save_as_copy, op->reports);
+      C, filepath, fileflags, remap_mode, use_save_as_copy, use_async, op->reports);
 
   if ((op->flag & OP_IS_INVOKE) == 0) {
     /* OP_IS_INVOKE is set when the operator is called from the GUI.
@@ -3709,13 +3898,16 @@ static int wm_save_as_mainfile_exec(bContext *C, wmOperator *op)
   }
 
   if (!use_save_as_copy) {
-    /* If saved file is the active one, there are technically no more compatibility issues, the
-     * file on disk now matches the currently opened data version-wise. */
-    bmain->has_forward_compatibility_issues = false;
-
-    /* If saved file is the active one, notify WM so that saved status and window title can be
-     * updated. */
-    WM_event_add_notifier(C, NC_WM | ND_FILESAVE, nullptr);
+    /* Done by the job once the file is written to disk otherwise. */
+    if (!use_async) {
+      /* If saved file is the active one, there are technically no more compatibility issues, the
+       * file on disk now matches the currently opened data version-wise. */
+      bmain->has_forward_compatibility_issues = false;
+
+      /* If saved file is the active one, notify WM so that saved status and window title can be
+       * updated. */
+      WM_event_add_notifier(C, NC_WM | ND_FILESAVE, nullptr);
+    }
     if (wmWindowManager *wm = CTX_wm_manager(C)) {
       /* Restart auto-save timer to avoid unnecessary unexpected freezing (because of auto-save)
        * when often saving manually. */
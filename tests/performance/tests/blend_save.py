@@ -0,0 +1,60 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    filepath = args['filepath']
+    compress = args['compress']
+    bpy.ops.wm.open_mainfile(filepath=filepath)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        save_filepath = os.path.join(tmpdir, "save.blend")
+
+        # Save once so that the measured save doesn't include creating the file.
+        bpy.ops.wm.save_as_mainfile(filepath=save_filepath, copy=True, compress=compress)
+
+        start_time = time.time()
+        bpy.ops.wm.save_as_mainfile(filepath=save_filepath, copy=True, compress=compress)
+        elapsed_time = time.time() - start_time
+
+        file_size = os.path.getsize(save_filepath)
+
+    result = {
+        'time': elapsed_time,
+        # Throughput in MB/s of written file data.
+        'throughput': file_size / (1024 * 1024) / elapsed_time,
+    }
+    return result
+
+
+class BlendSaveTest(api.Test):
+    def __init__(self, filepath, compress):
+        self.filepath = filepath
+        self.compress = compress
+
+    def name(self):
+        return self.filepath.stem + (" compressed" if self.compress else "")
+
+    def category(self):
+        return "blend_save"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {'filepath': str(self.filepath), 'compress': self.compress})
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    tests = []
+    for filepath in filepaths:
+        tests.append(BlendSaveTest(filepath, False))
+        tests.append(BlendSaveTest(filepath, True))
+    return tests
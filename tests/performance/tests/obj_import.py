@@ -0,0 +1,69 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    grid_size = args['grid_size']
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filepath = os.path.join(tmpdir, "grid.obj")
+
+        # Synthetic scanned-like grid with positions, UVs, normals and quad faces.
+        with open(filepath, "w") as file:
+            for y in range(grid_size):
+                file.write("".join(
+                    "v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\nvn 0 0 1\n".format(
+                        x * 0.01, y * 0.01, ((x * 7 + y * 13) % 100) * 0.001, x / grid_size, y / grid_size)
+                    for x in range(grid_size)))
+            for y in range(grid_size - 1):
+                row = y * grid_size + 1
+                file.write("".join(
+                    "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n".format(
+                        row + x, row + x + 1, row + x + 1 + grid_size, row + x + grid_size)
+                    for x in range(grid_size - 1)))
+
+        file_size = os.path.getsize(filepath)
+
+        # Import once to ensure it's cached by OS.
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        bpy.ops.wm.obj_import(filepath=filepath, validate_meshes=False)
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+        # Measure importing the second time.
+        start_time = time.time()
+        bpy.ops.wm.obj_import(filepath=filepath, validate_meshes=False)
+        elapsed_time = time.time() - start_time
+
+    result = {
+        'time': elapsed_time,
+        # Throughput in MB/s of parsed file data.
+        'throughput': file_size / (1024 * 1024) / elapsed_time,
+    }
+    return result
+
+
+class OBJImportTest(api.Test):
+    def __init__(self, grid_size):
+        self.grid_size = grid_size
+
+    def name(self):
+        return "grid_{}".format(self.grid_size)
+
+    def category(self):
+        return "obj_import"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {'grid_size': self.grid_size})
+        return result
+
+
+def generate(env):
+    return [OBJImportTest(grid_size) for grid_size in (500, 2000)]
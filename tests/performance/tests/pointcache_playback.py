@@ -0,0 +1,85 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    compression = args['compression']
+    use_disk_container = args['use_disk_container']
+    particles_num = args['particles_num']
+    frames_num = 100
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        # Disk caches are stored next to the blend file.
+        bpy.ops.wm.save_as_mainfile(filepath=os.path.join(tmpdir, "pointcache.blend"))
+
+        scene = bpy.context.scene
+        scene.frame_start = 1
+        scene.frame_end = frames_num
+
+        bpy.ops.mesh.primitive_ico_sphere_add(subdivisions=4)
+        ob = bpy.context.object
+        ob.modifiers.new("Particles", 'PARTICLE_SYSTEM')
+        settings = ob.particle_systems[0].settings
+        settings.count = particles_num
+        settings.frame_start = 1
+        settings.frame_end = frames_num // 2
+        settings.lifetime = frames_num
+
+        cache = ob.particle_systems[0].point_cache
+        cache.use_disk_cache = True
+        cache.use_disk_container = use_disk_container
+        cache.compression = compression
+        cache.frame_end = frames_num
+        bpy.ops.ptcache.bake_all(bake=True)
+
+        scene.frame_set(1)
+        start_time = time.time()
+        for frame in range(1, frames_num + 1):
+            scene.frame_set(frame)
+        elapsed_time = time.time() - start_time
+
+    result = {
+        'time': elapsed_time,
+        'fps': frames_num / elapsed_time,
+    }
+    return result
+
+
+class PointCachePlaybackTest(api.Test):
+    def __init__(self, compression, particles_num, use_disk_container=False):
+        self.compression = compression
+        self.particles_num = particles_num
+        self.use_disk_container = use_disk_container
+
+    def name(self):
+        name = "particles_{}_{}".format(self.particles_num, self.compression.lower())
+        if self.use_disk_container:
+            name += "_single_file"
+        return name
+
+    def category(self):
+        return "pointcache_playback"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(
+            _run, {
+                'compression': self.compression,
+                'particles_num': self.particles_num,
+                'use_disk_container': self.use_disk_container,
+            })
+        return result
+
+
+def generate(env):
+    tests = [PointCachePlaybackTest(compression, 200000) for compression in ('NO', 'LIGHT', 'ZSTD')]
+    tests.append(PointCachePlaybackTest('ZSTD', 200000, use_disk_container=True))
+    return tests
@@ -392,6 +392,64 @@ class OverrideLayersTest(AbstractAlembicTest):
         self.assertEqual(len(mesh.polygons), 6)
 
 
+
+class MeshAnimationExportImportTest(unittest.TestCase):
+    def setUp(self):
+        self._tempdir = tempfile.TemporaryDirectory()
+        self.tempdir = pathlib.Path(self._tempdir.name)
+
+    def tearDown(self):
+        # Unload the current blend file to release the imported Alembic file.
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        self._tempdir.cleanup()
+
+    def test_export_unchanged_frames_edit_mode(self):
+        """Frames where the mesh doesn't change repeat the previous sample, also in edit mode."""
+        bpy.ops.wm.open_mainfile(filepath=str(args.testdir / "empty.blend"))
+        scene = bpy.context.scene
+        scene.frame_start = 1
+        scene.frame_end = 4
+
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=4, y_subdivisions=4, size=2)
+        grid = bpy.context.active_object
+        grid.name = "Grid"
+        # Displace the grid only from frame 3 on, the first two frames export the same mesh.
+        displace = grid.modifiers.new("Displace", 'DISPLACE')
+        displace.direction = 'Z'
+        displace.mid_level = 0.0
+        displace.show_in_editmode = True
+        for frame, strength in ((1, 0.0), (2, 0.0), (3, 1.0), (4, 2.0)):
+            displace.strength = strength
+            displace.keyframe_insert("strength", frame=frame)
+        for fcurve in grid.animation_data.action.fcurves:
+            for keyframe in fcurve.keyframe_points:
+                keyframe.interpolation = 'CONSTANT'
+
+        bpy.ops.object.mode_set(mode='EDIT')
+        abc_path = self.tempdir / "unchanged_frames.abc"
+        self.assertIn('FINISHED', bpy.ops.wm.alembic_export(
+            filepath=str(abc_path),
+            start=1,
+            end=4,
+            evaluation_mode='VIEWPORT',
+        ))
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+        bpy.ops.wm.open_mainfile(filepath=str(args.testdir / "empty.blend"))
+        self.assertIn('FINISHED', bpy.ops.wm.alembic_import(filepath=str(abc_path)))
+        grid = bpy.context.scene.objects["Grid"]
+
+        def vertex_heights(frame):
+            bpy.context.scene.frame_set(frame)
+            depsgraph = bpy.context.evaluated_depsgraph_get()
+            mesh = grid.evaluated_get(depsgraph).to_mesh()
+            self.assertEqual(len(mesh.vertices), 16)
+            return [vertex.co.z for vertex in mesh.vertices]
+
+        for frame, height in ((1, 0.0), (2, 0.0), (3, 1.0), (4, 2.0)):
+            for z in vertex_heights(frame):
+                self.assertAlmostEqual(z, height, places=5, msg="frame %d" % frame)
+
 def main():
     global args
     import argparse
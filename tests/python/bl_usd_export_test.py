@@ -975,6 +975,39 @@ class USDExportTest(AbstractUSDTest):
         weight_samples = anim.GetBlendShapeWeightsAttr().GetTimeSamples()
         self.assertEqual(weight_samples, [1.0, 2.0, 3.0, 4.0, 5.0])
 
+    def test_export_animation_deforming_edit_mesh(self):
+        """Test that a mesh deformed over time is written for every frame while in edit mode."""
+
+        bpy.ops.wm.open_mainfile(filepath=str(self.testdir / "empty.blend"))
+        scene = bpy.context.scene
+        scene.frame_start = 1
+        scene.frame_end = 3
+
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=8, y_subdivisions=8, size=2)
+        grid = bpy.context.active_object
+        grid.name = "Grid"
+        grid.data.name = "Grid"
+        wave = grid.modifiers.new("Wave", 'WAVE')
+        wave.show_in_editmode = True
+
+        # In edit mode the evaluated mesh only wraps the edit-mesh.
+        bpy.ops.object.mode_set(mode='EDIT')
+        export_path = self.tempdir / "usd_anim_edit_mesh.usda"
+        res = bpy.ops.wm.usd_export(
+            filepath=str(export_path),
+            export_animation=True,
+            evaluation_mode="VIEWPORT",
+        )
+        bpy.ops.object.mode_set(mode='OBJECT')
+        self.assertEqual({'FINISHED'}, res, f"Unable to export to {export_path}")
+
+        stage = Usd.Stage.Open(str(export_path))
+        mesh = UsdGeom.Mesh(stage.GetPrimAtPath("/root/Grid/Grid"))
+        points = mesh.GetPointsAttr()
+        self.assertEqual(len(points.Get(1.0)), 81)
+        self.assertNotEqual(points.Get(1.0), points.Get(2.0))
+        self.assertNotEqual(points.Get(2.0), points.Get(3.0))
+
     def test_export_volumes(self):
         """Test various combinations of volume export including with all supported volume modifiers."""
 
@@ -8,7 +8,7 @@ import pathlib
 import sys
 import tempfile
 import unittest
-from pxr import Ar, Gf, Sdf, Usd, UsdGeom, UsdShade
+from pxr import Ar, Gf, Sdf, Usd, UsdGeom, UsdShade, UsdSkel
 
 import bpy
 
@@ -1779,6 +1779,77 @@ class USDImportTest(AbstractUSDTest):
 
         self.assertEqual(instance_count, 6, "Unexpected number of instances found")
 
+    def test_import_shared_instance_meshes(self):
+        """Test sharing the meshes of expanded instances of a skinned prototype."""
+
+        testfile = str(self.tempdir / "usd_shared_instance_meshes.usda")
+        stage = Usd.Stage.CreateNew(testfile)
+        UsdGeom.SetStageUpAxis(stage, UsdGeom.Tokens.z)
+
+        # Skinned asset, instanced below. A class prim is not imported on its own.
+        stage.CreateClassPrim("/_class_Asset")
+        UsdSkel.Root.Define(stage, "/_class_Asset/Root")
+        skel = UsdSkel.Skeleton.Define(stage, "/_class_Asset/Root/Skel")
+        skel.CreateJointsAttr(["Bone"])
+        skel.CreateBindTransformsAttr([Gf.Matrix4d(1.0)])
+        skel.CreateRestTransformsAttr([Gf.Matrix4d(1.0)])
+
+        mesh = UsdGeom.Mesh.Define(stage, "/_class_Asset/Root/Mesh")
+        mesh.CreatePointsAttr([(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)])
+        mesh.CreateFaceVertexCountsAttr([4])
+        mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3])
+        binding = UsdSkel.BindingAPI.Apply(mesh.GetPrim())
+        binding.CreateSkeletonRel().SetTargets([skel.GetPath()])
+        binding.CreateJointIndicesPrimvar(True, 1).Set([0])
+        binding.CreateJointWeightsPrimvar(True, 1).Set([1.0])
+
+        materials = []
+        for name in ("MatA", "MatB"):
+            material = UsdShade.Material.Define(stage, "/World/Looks/" + name)
+            shader = UsdShade.Shader.Define(stage, "/World/Looks/" + name + "/Shader")
+            shader.CreateIdAttr("UsdPreviewSurface")
+            material.CreateSurfaceOutput().ConnectToSource(shader.ConnectableAPI(), "surface")
+            materials.append(material)
+
+        # The first two instances resolve to the same material, the third one doesn't.
+        for i, material in enumerate((materials[0], materials[0], materials[1])):
+            instance = UsdGeom.Xform.Define(stage, "/World/Inst{}".format(i))
+            instance.AddTranslateOp().Set(Gf.Vec3d(2.0 * i, 0.0, 0.0))
+            instance.GetPrim().GetReferences().AddInternalReference("/_class_Asset")
+            instance.GetPrim().SetInstanceable(True)
+            UsdShade.MaterialBindingAPI.Apply(instance.GetPrim()).Bind(material)
+
+        stage.GetRootLayer().Save()
+
+        def import_mesh_objects(share_instance_meshes):
+            bpy.ops.wm.open_mainfile(filepath=str(self.testdir / "empty.blend"))
+            res = bpy.ops.wm.usd_import(
+                filepath=testfile,
+                support_scene_instancing=False,
+                share_instance_meshes=share_instance_meshes)
+            self.assertEqual({'FINISHED'}, res, f"Unable to import USD file {testfile}")
+            return [ob for ob in bpy.data.objects if ob.type == 'MESH']
+
+        def object_signatures(objects):
+            return sorted(
+                (tuple(self.round_vector(ob.matrix_world.translation)),
+                 tuple(mod.type for mod in ob.modifiers),
+                 tuple(group.name for group in ob.vertex_groups),
+                 tuple(mat.name for mat in ob.data.materials))
+                for ob in objects)
+
+        objects = import_mesh_objects(False)
+        self.assertEqual(len(objects), 3)
+        self.assertEqual(len({ob.data.name for ob in objects}), 3)
+        expected_signatures = object_signatures(objects)
+
+        # Sharing must not change the modifiers, deform groups or materials of any object.
+        objects = import_mesh_objects(True)
+        self.assertEqual(len(objects), 3)
+        self.assertEqual(len({ob.data.name for ob in objects}), 2,
+                         "Only instances with the same materials should share a mesh")
+        self.assertEqual(object_signatures(objects), expected_signatures)
+
     def test_material_import_usd_hook(self):
         """Test importing color from an mtlx shader."""
 
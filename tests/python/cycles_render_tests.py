@@ -132,7 +132,7 @@ BLOCKLIST_GPU = [
 
 
 class CyclesReport(render_report.Report):
-    def __init__(self, title, output_dir, oiiotool, device=None, blocklist=[], osl=False):
+    def __init__(self, title, output_dir, oiiotool, device=None, blocklist=[], osl=False, ray_packets=False):
         # Split device name in format "<device_type>[-<RT>]" into individual
         # tokens, setting the RT suffix to an empty string if its not specified.
         self.device, suffix = (device.split("-") + [""])[:2]
@@ -144,6 +144,8 @@ class CyclesReport(render_report.Report):
             variation += ' ' + suffix
         if self.osl:
             variation += ' OSL'
+        if ray_packets:
+            variation += ' Ray Packets'
 
         super().__init__(title, output_dir, oiiotool, variation, blocklist)
 
@@ -216,6 +218,7 @@ def create_argparse():
     parser.add_argument("--device", required=True)
     parser.add_argument("--blocklist", nargs="*", default=[])
     parser.add_argument("--osl", default=False, action='store_true')
+    parser.add_argument("--ray-packets", default=False, action='store_true')
     parser.add_argument('--batch', default=False, action='store_true')
     return parser
 
@@ -240,10 +243,18 @@ def main():
     if args.osl:
         blocklist += BLOCKLIST_OSL
 
-    report = CyclesReport('Cycles', args.outdir, args.oiiotool, device, blocklist, args.osl)
+    if args.ray_packets:
+        # Inherited by the Blender processes, debug flags from the scene are only used when the
+        # Cycles debug UI is enabled.
+        os.environ["CYCLES_CPU_RAY_PACKETS"] = "1"
+
+    report = CyclesReport('Cycles', args.outdir, args.oiiotool, device, blocklist, args.osl, args.ray_packets)
     report.set_pixelated(True)
     report.set_reference_dir("cycles_renders")
-    if device == 'CPU':
+    if args.ray_packets:
+        # Compare against the regular CPU megakernel render, tracing one path at a time.
+        report.set_compare_engine('cycles', 'CPU')
+    elif device == 'CPU':
         report.set_compare_engine('eevee')
     else:
         report.set_compare_engine('cycles', 'CPU')
@@ -0,0 +1,65 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# ./blender.bin --background --factory-startup --python tests/python/cycles_render_time_pass_test.py
+import unittest
+
+import bpy
+
+
+def render_time_pass(samples):
+    """Render the default scene on the CPU and return the Debug Render Time pass values."""
+    scene = bpy.context.scene
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = 32
+    scene.render.resolution_y = 32
+    scene.render.resolution_percentage = 100
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = samples
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = False
+    scene.view_layers[0].cycles.pass_debug_render_time = True
+
+    # Read the pass back through the viewer node of the compositor.
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.nodes.clear()
+    render_layers = tree.nodes.new("CompositorNodeRLayers")
+    composite = tree.nodes.new("CompositorNodeComposite")
+    viewer = tree.nodes.new("CompositorNodeViewer")
+    tree.links.new(render_layers.outputs["Image"], composite.inputs["Image"])
+    tree.links.new(render_layers.outputs["Debug Render Time"], viewer.inputs["Image"])
+
+    bpy.ops.render.render()
+
+    image = bpy.data.images["Viewer Node"]
+    pixels = image.pixels[:]
+    # Value passes are shown as gray, take the red channel.
+    return pixels[0::4]
+
+
+class CyclesRenderTimePassTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=False)
+
+    def test_written_for_every_pixel(self):
+        values = render_time_pass(4)
+        self.assertEqual(len(values), 32 * 32)
+        self.assertGreater(min(values), 0.0)
+
+    def test_normalized_per_sample(self):
+        # Time is accumulated over all samples and divided by the number of samples when reading
+        # the pass, so the value should not grow with the sample count. Without normalization, the
+        # average at 16 samples would be about 16 times the one at 1 sample; allow a wide margin
+        # for timing noise.
+        average_1 = sum(render_time_pass(1)) / (32 * 32)
+        average_16 = sum(render_time_pass(16)) / (32 * 32)
+        self.assertGreater(average_1, 0.0)
+        self.assertLess(average_16, average_1 * 4.0)
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()